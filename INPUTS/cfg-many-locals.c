@@ -0,0 +1,23 @@
+// Hammer the liveness analyses with a single function holding thousands of
+// locals, each defined, conditionally updated and read in its own branch.
+// Time with e.g. 'clang -cc1 -analyze -analyzer-checker=deadcode.DeadStores'.
+
+#define LOCAL(i, x) \
+  int var_##i = x ^ i; if ((x % 7) == (i % 7)) var_##i = x; x += var_##i;
+#define EXPAND_2_LOCALS(i, x)    LOCAL(i##0, x)           LOCAL(i##1, x)
+#define EXPAND_4_LOCALS(i, x)    EXPAND_2_LOCALS(i##0, x) EXPAND_2_LOCALS(i##1, x)
+#define EXPAND_8_LOCALS(i, x)    EXPAND_4_LOCALS(i##0, x) EXPAND_4_LOCALS(i##1, x)
+#define EXPAND_16_LOCALS(i, x)   EXPAND_8_LOCALS(i##0, x) EXPAND_8_LOCALS(i##1, x)
+#define EXPAND_32_LOCALS(i, x)   EXPAND_16_LOCALS(i##0, x) EXPAND_16_LOCALS(i##1, x)
+#define EXPAND_64_LOCALS(i, x)   EXPAND_32_LOCALS(i##0, x) EXPAND_32_LOCALS(i##1, x)
+#define EXPAND_128_LOCALS(i, x)  EXPAND_64_LOCALS(i##0, x) EXPAND_64_LOCALS(i##1, x)
+#define EXPAND_256_LOCALS(i, x)  EXPAND_128_LOCALS(i##0, x) EXPAND_128_LOCALS(i##1, x)
+#define EXPAND_512_LOCALS(i, x)  EXPAND_256_LOCALS(i##0, x) EXPAND_256_LOCALS(i##1, x)
+#define EXPAND_1024_LOCALS(i, x) EXPAND_512_LOCALS(i##0, x) EXPAND_512_LOCALS(i##1, x)
+#define EXPAND_2048_LOCALS(i, x) EXPAND_1024_LOCALS(i##0, x) EXPAND_1024_LOCALS(i##1, x)
+#define EXPAND_4096_LOCALS(i, x) EXPAND_2048_LOCALS(i##0, x) EXPAND_2048_LOCALS(i##1, x)
+
+unsigned cfg_many_locals(unsigned x) {
+  EXPAND_4096_LOCALS(1, x)
+  return x;
+}
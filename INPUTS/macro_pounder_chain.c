@@ -0,0 +1,30 @@
+
+// This pounds on chains of object-like macros, like the configuration macros
+// of system headers, which are expanded again at every use. Compare
+//   clang -cc1 -fsyntax-only -print-stats macro_pounder_chain.c
+// with and without -cache-macro-expansions.
+
+#define BASE_TYPE unsigned long
+#define WORD_TYPE BASE_TYPE
+#define SIZE_TYPE WORD_TYPE
+#define WORD_BITS (sizeof(WORD_TYPE) * 8)
+#define ALIGNMENT (WORD_BITS / 8)
+#define PAGE_SHIFT 12
+#define PAGE_SIZE (1UL << PAGE_SHIFT)
+#define PAGE_MASK (~(PAGE_SIZE - 1))
+#define ROUND_MASK (PAGE_MASK & ~(ALIGNMENT - 1))
+#define CONFIG ((SIZE_TYPE)ROUND_MASK + (SIZE_TYPE)WORD_BITS)
+
+#define S0 x += CONFIG; x ^= PAGE_MASK;
+#define S1 S0 S0 S0 S0 S0 S0 S0 S0
+#define S2 S1 S1 S1 S1 S1 S1 S1 S1
+#define S3 S2 S2 S2 S2 S2 S2 S2 S2
+
+SIZE_TYPE f0(SIZE_TYPE x) { S3 return x; }
+SIZE_TYPE f1(SIZE_TYPE x) { S3 return x; }
+SIZE_TYPE f2(SIZE_TYPE x) { S3 return x; }
+SIZE_TYPE f3(SIZE_TYPE x) { S3 return x; }
+SIZE_TYPE f4(SIZE_TYPE x) { S3 return x; }
+SIZE_TYPE f5(SIZE_TYPE x) { S3 return x; }
+SIZE_TYPE f6(SIZE_TYPE x) { S3 return x; }
+SIZE_TYPE f7(SIZE_TYPE x) { S3 return x; }
@@ -0,0 +1,40 @@
+// Hammer overload resolution with large overload sets, the way stream
+// insertion and expression templates do: every call builds a candidate set
+// with hundreds of candidates, and most argument types are distinct so the
+// calls cannot share results.
+
+struct ostream {};
+
+#define TYPE(i) struct T##i { operator int() const; };
+#define INSERT(i) ostream &operator<<(ostream &, const T##i &);
+#define PLUS(i) template <typename L> struct Plus##i { L l; T##i r; }; \
+  template <typename L> Plus##i<L> operator+(const L &, const T##i &); \
+  template <typename L> ostream &operator<<(ostream &, const Plus##i<L> &);
+
+#define EXPAND_2(M, i)  M(i##0) M(i##1)
+#define EXPAND_4(M, i)  EXPAND_2(M, i##0) EXPAND_2(M, i##1)
+#define EXPAND_8(M, i)  EXPAND_4(M, i##0) EXPAND_4(M, i##1)
+#define EXPAND_16(M, i) EXPAND_8(M, i##0) EXPAND_8(M, i##1)
+#define EXPAND_32(M, i) EXPAND_16(M, i##0) EXPAND_16(M, i##1)
+#define EXPAND_64(M, i) EXPAND_32(M, i##0) EXPAND_32(M, i##1)
+#define EXPAND_256(M)   EXPAND_64(M, 00) EXPAND_64(M, 01) \
+                        EXPAND_64(M, 10) EXPAND_64(M, 11)
+
+EXPAND_256(TYPE)
+EXPAND_256(INSERT)
+EXPAND_256(PLUS)
+
+#define USE(i) os << T##i() << T##i() + T##i() << (T##i() + 1 + T##i());
+
+void f(ostream &os) {
+  EXPAND_256(USE)
+}
+
+#define USE_IN_TEMPLATE(i) os << x << T##i() << (x + T##i());
+
+template <typename X> void g(ostream &os, const X &x) {
+  EXPAND_256(USE_IN_TEMPLATE)
+}
+
+template void g(ostream &, const T00000000 &);
+template void g(ostream &, const T11111111 &);
@@ -0,0 +1,24 @@
+// Hammer idexpr with a generator that synthesizes 10k accessors, each named
+// from the same prefixes and a different integer, the way generated
+// field_0 ... field_N members and their get_ helpers are.
+//
+// Compile with -std=c++1z -Xclang -freflection.
+
+#include <cppx/meta>
+
+struct Record {
+  constexpr {
+    for (int n = 0; n < 5000; ++n) {
+      __generate __fragment struct {
+        int idexpr("field_", n) = n;
+        int idexpr("get_", "field_", n)() const {
+          return idexpr("field_", n);
+        }
+      };
+    }
+  }
+};
+
+int sum(const Record &r) {
+  return r.get_field_0() + r.get_field_2500() + r.get_field_4999();
+}
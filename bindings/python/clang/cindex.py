@@ -1744,6 +1744,24 @@ class Cursor(Structure):
             children)
         return iter(children)
 
+    def get_tree(self, kinds=None):
+        """Return a CursorTree describing the descendants of this cursor.
+
+        Unlike walk_preorder(), which calls back into Python for every cursor,
+        this retrieves all descendants with a single call into libclang. If
+        kinds is given, only the cursors of those CursorKinds are recorded.
+        """
+        if kinds is None:
+            kind_ids = None
+            num_kinds = 0
+        else:
+            kinds = list(kinds)
+            kind_ids = (c_int * len(kinds))(*[kind.value for kind in kinds])
+            num_kinds = len(kinds)
+
+        tree = conf.lib.clang_getCursorTree(self, kind_ids, num_kinds)
+        return CursorTree(tree, self._tu)
+
     def walk_preorder(self):
         """Depth-first preorder walk over the cursor and its descendants.
 
@@ -1819,6 +1837,63 @@ class Cursor(Structure):
         res._tu = args[0]._tu
         return res
 
+class CursorRecord(Structure):
+    """
+    A compact description of one cursor of a CursorTree.
+
+    The offsets are file offsets of expansion locations, and parent is the
+    index of the record of the nearest recorded ancestor, or -1.
+    """
+    _fields_ = [("_kind_id", c_int),
+                ("parent", c_int),
+                ("_file", c_object_p),
+                ("offset", c_uint),
+                ("extent_start", c_uint),
+                ("extent_end", c_uint)]
+
+    @property
+    def kind(self):
+        """Return the kind of the cursor."""
+        return CursorKind.from_id(self._kind_id)
+
+    @property
+    def file(self):
+        """Return the File holding the location of the cursor, or None."""
+        if not self._file:
+            return None
+        return File(self._file)
+
+class CursorTree(ClangObject):
+    """
+    The descendants of a cursor, flattened in preorder by Cursor.get_tree().
+    """
+
+    def __init__(self, obj, tu):
+        ClangObject.__init__(self, obj)
+        self._tu = tu
+
+        # Copy the records so that they can outlive the tree.
+        count = conf.lib.clang_CursorTree_getNumRecords(self)
+        self.records = (CursorRecord * count)()
+        if count:
+            memmove(self.records, conf.lib.clang_CursorTree_getRecords(self),
+                    sizeof(self.records))
+
+    def __del__(self):
+        conf.lib.clang_CursorTree_dispose(self)
+
+    def __len__(self):
+        return len(self.records)
+
+    @property
+    def translation_unit(self):
+        """Returns the TranslationUnit the cursors belong to."""
+        return self._tu
+
+    def cursor(self, index):
+        """Return the Cursor described by the record at index."""
+        return conf.lib.clang_CursorTree_getCursor(self, index)
+
 class StorageClass(object):
     """
     Describes the storage class of a declaration
@@ -3382,6 +3457,10 @@ functionList = [
    _CXString,
    _CXString.from_result),
 
+  ("clang_getCursorTree",
+   [Cursor, POINTER(c_int), c_uint],
+   c_object_p),
+
   ("clang_getCursorType",
    [Cursor],
    Type,
@@ -3725,6 +3804,22 @@ functionList = [
    [Cursor, callbacks['cursor_visit'], py_object],
    c_uint),
 
+  ("clang_CursorTree_dispose",
+   [CursorTree]),
+
+  ("clang_CursorTree_getCursor",
+   [CursorTree, c_uint],
+   Cursor,
+   Cursor.from_result),
+
+  ("clang_CursorTree_getNumRecords",
+   [CursorTree],
+   c_uint),
+
+  ("clang_CursorTree_getRecords",
+   [CursorTree],
+   c_void_p),
+
   ("clang_Cursor_getNumArguments",
    [Cursor],
    c_int),
@@ -3957,6 +4052,8 @@ __all__ = [
     'CompileCommand',
     'CursorKind',
     'Cursor',
+    'CursorRecord',
+    'CursorTree',
     'Diagnostic',
     'File',
     'FixIt',
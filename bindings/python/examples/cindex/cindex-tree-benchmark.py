@@ -0,0 +1,59 @@
+#!/usr/bin/env python
+
+#===- cindex-tree-benchmark.py - cindex/Python Walk Timing ---*- python -*--===#
+#
+#                     The LLVM Compiler Infrastructure
+#
+# This file is distributed under the University of Illinois Open Source
+# License. See LICENSE.TXT for details.
+#
+#===------------------------------------------------------------------------===#
+
+"""
+A simple command line tool comparing the time it takes to walk all cursors of
+a translation unit with a callback per cursor (Cursor.walk_preorder) and with
+a single call into the Clang Index Library (Cursor.get_tree).
+"""
+
+import time
+
+def time_walk(cursor):
+    start = time.time()
+    kinds = {}
+    for node in cursor.walk_preorder():
+        kinds[node.kind] = kinds.get(node.kind, 0) + 1
+    return time.time() - start, sum(kinds.values()) - 1
+
+def time_tree(cursor):
+    start = time.time()
+    kinds = {}
+    for record in cursor.get_tree().records:
+        kinds[record.kind] = kinds.get(record.kind, 0) + 1
+    return time.time() - start, sum(kinds.values())
+
+def main():
+    from clang.cindex import Index
+    from optparse import OptionParser
+
+    parser = OptionParser("usage: %prog [options] {filename} [clang-args*]")
+    parser.add_option("", "--repeat", dest="repeat",
+                      help="Time each traversal N times and keep the best",
+                      metavar="N", type=int, default=3)
+    parser.disable_interspersed_args()
+    (opts, args) = parser.parse_args()
+
+    if len(args) == 0:
+        parser.error('invalid number arguments')
+
+    index = Index.create()
+    tu = index.parse(None, args)
+    if not tu:
+        parser.error("unable to load input")
+
+    for name, traverse in (('walk_preorder', time_walk),
+                           ('get_tree', time_tree)):
+        best, count = min(traverse(tu.cursor) for _ in range(opts.repeat))
+        print('%-14s %8d cursors %10.3fs' % (name, count, best))
+
+if __name__ == '__main__':
+    main()
@@ -68,6 +68,33 @@ def test_get_children():
     assert tu_nodes[2].displayname == 'f0(int, int)'
     assert tu_nodes[2].is_definition() == True
 
+def test_get_tree():
+    tu = get_tu(kInput)
+
+    # The tree holds the same cursors as a preorder walk, minus the root.
+    tree = tu.cursor.get_tree()
+    cursors = list(tu.cursor.walk_preorder())[1:]
+    assert len(tree) == len(cursors)
+    for i, record in enumerate(tree.records):
+        assert record.kind == cursors[i].kind
+        assert record.offset == cursors[i].location.offset
+        assert record.extent_start == cursors[i].extent.start.offset
+        assert record.extent_end == cursors[i].extent.end.offset
+        assert record.file.name == 't.c'
+        assert tree.cursor(i) == cursors[i]
+
+    decls = tu.cursor.get_tree([CursorKind.FUNCTION_DECL,
+                                CursorKind.PARM_DECL,
+                                CursorKind.VAR_DECL])
+    assert [r.kind for r in decls.records] == [CursorKind.FUNCTION_DECL,
+                                               CursorKind.PARM_DECL,
+                                               CursorKind.PARM_DECL,
+                                               CursorKind.VAR_DECL,
+                                               CursorKind.VAR_DECL]
+    assert [r.parent for r in decls.records] == [-1, 0, 0, 0, 0]
+    assert decls.cursor(3).spelling == 'l0'
+    assert decls.cursor(3).translation_unit is tu
+
 def test_references():
     """Ensure that references to TranslationUnit are kept."""
     tu = get_tu('int x;')
@@ -32,7 +32,7 @@
  * compatible, thus CINDEX_VERSION_MAJOR is expected to remain stable.
  */
 #define CINDEX_VERSION_MAJOR 0
-#define CINDEX_VERSION_MINOR 39
+#define CINDEX_VERSION_MINOR 40
 
 #define CINDEX_VERSION_ENCODE(major, minor) ( \
       ((major) * 10000)                       \
@@ -3815,6 +3815,97 @@ CINDEX_LINKAGE unsigned clang_visitChildrenWithBlock(CXCursor parent,
 #  endif
 #endif
 
+/**
+ * \brief A compact description of one cursor of a flattened cursor tree.
+ *
+ * File offsets are those of the expansion locations, and are 0 for cursors
+ * without a valid location.
+ */
+typedef struct {
+  /**
+   * \brief The kind of the cursor.
+   */
+  enum CXCursorKind kind;
+
+  /**
+   * \brief The index of the record of the nearest recorded ancestor of the
+   * cursor, or -1 if that ancestor is the root of the traversal.
+   */
+  int parent;
+
+  /**
+   * \brief The file holding the location of the cursor, or null.
+   */
+  CXFile file;
+
+  /**
+   * \brief The file offset of the location of the cursor, as returned by
+   * \c clang_getCursorLocation().
+   */
+  unsigned offset;
+
+  /**
+   * \brief The file offsets of the start and end of the extent of the
+   * cursor, as returned by \c clang_getCursorExtent().
+   */
+  unsigned extent_start;
+  unsigned extent_end;
+} CXCursorRecord;
+
+/**
+ * \brief An opaque type representing a flattened cursor tree.
+ */
+typedef struct CXCursorTreeImpl *CXCursorTree;
+
+/**
+ * \brief Flatten the descendants of a cursor into an array of records.
+ *
+ * This performs the same recursive traversal as \c clang_visitChildren()
+ * with a visitor that always returns \c CXChildVisit_Recurse, but records
+ * the visited cursors in a single call, which is much cheaper for clients
+ * that would otherwise pay for a callback per cursor (e.g., through a
+ * foreign function interface). The records are stored in traversal
+ * (pre-)order, so the record of a parent precedes those of its children.
+ *
+ * \param parent the cursor whose descendants are recorded. The cursor itself
+ * is not recorded.
+ *
+ * \param kinds if non-null, only cursors of one of these \p num_kinds kinds
+ * are recorded; the traversal still descends into the other cursors.
+ *
+ * \param num_kinds the number of elements of \p kinds.
+ *
+ * \returns the flattened tree, which must be disposed of with
+ * \c clang_CursorTree_dispose() and cannot outlive the translation unit of
+ * \p parent.
+ */
+CINDEX_LINKAGE CXCursorTree
+clang_getCursorTree(CXCursor parent, const enum CXCursorKind *kinds,
+                    unsigned num_kinds);
+
+/**
+ * \brief Destroy a flattened cursor tree.
+ */
+CINDEX_LINKAGE void clang_CursorTree_dispose(CXCursorTree tree);
+
+/**
+ * \brief Retrieve the number of records in a flattened cursor tree.
+ */
+CINDEX_LINKAGE unsigned clang_CursorTree_getNumRecords(CXCursorTree tree);
+
+/**
+ * \brief Retrieve the records of a flattened cursor tree, as a contiguous
+ * array of \c clang_CursorTree_getNumRecords() elements owned by \p tree.
+ */
+CINDEX_LINKAGE const CXCursorRecord *
+clang_CursorTree_getRecords(CXCursorTree tree);
+
+/**
+ * \brief Retrieve the cursor described by the record at \p index.
+ */
+CINDEX_LINKAGE CXCursor clang_CursorTree_getCursor(CXCursorTree tree,
+                                                   unsigned index);
+
 /**
  * @}
  */
@@ -15,6 +15,7 @@
 #ifndef LLVM_CLANG_AST_ASTCONTEXT_H
 #define LLVM_CLANG_AST_ASTCONTEXT_H
 
+#include "clang/AST/ASTMemoryReport.h"
 #include "clang/AST/ASTTypeTraits.h"
 #include "clang/AST/CanonicalType.h"
 #include "clang/AST/CommentCommandTraits.h"
@@ -123,6 +124,27 @@ struct TypeInfo {
       : Width(Width), Align(Align), AlignIsRequired(AlignIsRequired) {}
 };
 
+/// \brief Describes how an injected function was generated.
+struct InjectionOrigin {
+  /// \brief The function that was injected: a member of a fragment or a
+  /// cloned declaration. It may have been injected itself.
+  const FunctionDecl *Source;
+
+  /// \brief The class or namespace that received the function.
+  const Decl *Injectee;
+
+  /// \brief The constexpr-declaration whose evaluation injected the
+  /// function, if any.
+  const Decl *Generator;
+
+  /// \brief The metaclass that contributed the generator, if any.
+  const Decl *Metaclass;
+
+  InjectionOrigin()
+      : Source(nullptr), Injectee(nullptr), Generator(nullptr),
+        Metaclass(nullptr) {}
+};
+
 /// \brief Holds long-lived AST nodes (such as types and decls) that can be
 /// referred to throughout the semantic analysis of a file.
 class ASTContext : public RefCountedBase<ASTContext> {
@@ -433,6 +455,10 @@ private:
 
   llvm::DenseMap<FieldDecl *, FieldDecl *> InstantiatedFromUnnamedFieldDecl;
 
+  /// \brief Mapping from functions created by source code injection to the
+  /// declarations and metaprograms that generated them.
+  llvm::DenseMap<const FunctionDecl *, InjectionOrigin> InjectionOrigins;
+
   /// \brief Mapping that stores the methods overridden by a given C++
   /// member function.
   ///
@@ -481,6 +507,9 @@ private:
   /// should be imbued with the XRay "always" or "never" attributes.
   std::unique_ptr<XRayFunctionFilter> XRayFilter;
 
+  /// \brief The allocation records kept for -fast-memory-report, or null.
+  std::unique_ptr<ASTMemoryReport> MemoryReport;
+
   /// \brief The allocator used to create AST objects.
   ///
   /// AST objects are never destructed; rather, all memory associated with the
@@ -510,6 +539,10 @@ private:
   const TargetInfo *AuxTarget;
   clang::PrintingPolicy PrintingPolicy;
 
+  /// \brief Incremented whenever name lookup or a conversion could start
+  /// finding something it did not find before.
+  unsigned DeclarationGeneration;
+
 public:
   IdentifierTable &Idents;
   SelectorTable &Selectors;
@@ -637,6 +670,14 @@ public:
   /// Return the total memory used for various side tables.
   size_t getSideTableAllocatedMemory() const;
 
+  /// \brief Attribute the declarations and statements allocated from now on
+  /// to their files, kinds and origins, for -fast-memory-report.
+  void enableMemoryReport() { MemoryReport.reset(new ASTMemoryReport()); }
+
+  /// \brief Return the allocation records, or null if the memory report is
+  /// not enabled.
+  ASTMemoryReport *getMemoryReport() const { return MemoryReport.get(); }
+
   PartialDiagnostic::StorageAllocator &getDiagAllocator() {
     return DiagAllocator;
   }
@@ -876,6 +917,13 @@ public:
 
   void setInstantiatedFromUnnamedFieldDecl(FieldDecl *Inst, FieldDecl *Tmpl);
 
+  /// \brief If \p FD was created by source code injection, return how it
+  /// was generated; otherwise return null.
+  const InjectionOrigin *getInjectionOrigin(const FunctionDecl *FD) const;
+
+  /// \brief Remember that \p FD was created by source code injection.
+  void setInjectionOrigin(const FunctionDecl *FD, const InjectionOrigin &O);
+
   // Access to the set of methods overridden by the given C++ method.
   typedef CXXMethodVector::const_iterator overridden_cxx_method_iterator;
   overridden_cxx_method_iterator
@@ -1029,6 +1077,17 @@ public:
   /// with this AST context, if any.
   ASTMutationListener *getASTMutationListener() const { return Listener; }
 
+  /// \brief Retrieve the current declaration generation.
+  ///
+  /// The generation changes whenever a declaration becomes visible in a
+  /// namespace or in a complete class, and whenever a tag type is completed.
+  /// Results derived from name lookup that were computed in the same
+  /// generation are still valid.
+  unsigned getDeclarationGeneration() const { return DeclarationGeneration; }
+
+  /// \brief Note that previously computed lookup results may be stale.
+  void bumpDeclarationGeneration() { ++DeclarationGeneration; }
+
   void PrintStats() const;
   const SmallVectorImpl<Type *>& getTypes() const { return Types; }
 
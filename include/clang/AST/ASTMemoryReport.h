@@ -0,0 +1,117 @@
+//===--- ASTMemoryReport.h - Attribution of AST memory ----------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the ASTMemoryReport class, which attributes the memory
+//  allocated for declarations and statements to their source files, kinds
+//  and origins for -fast-memory-report.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_AST_ASTMEMORYREPORT_H
+#define LLVM_CLANG_AST_ASTMEMORYREPORT_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/SmallVector.h"
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace clang {
+
+class ASTContext;
+class Decl;
+class Stmt;
+
+/// \brief How the AST nodes being allocated came to be.
+enum class ASTNodeOrigin : unsigned char {
+  /// Built by the parser for code written in the source.
+  Parsed,
+  /// Built by template instantiation.
+  Instantiated,
+  /// Built by an injection context, from a fragment or a copied declaration.
+  Injected,
+  /// Built while specializing and completing the library template that
+  /// describes a reflected construct.
+  ReflectionSpecialization,
+  /// Read from a precompiled header or module.
+  Deserialized
+};
+
+/// \brief Records every declaration and statement allocated in an ASTContext
+/// along with its size and origin, and summarizes them by source file, node
+/// kind and origin.
+class ASTMemoryReport {
+public:
+  /// \brief The origin of the nodes allocated from now on.
+  ASTNodeOrigin getOrigin() const {
+    return Origins.empty() ? ASTNodeOrigin::Parsed : Origins.back();
+  }
+
+  /// \brief Attribute the nodes allocated until the matching popOrigin()
+  /// to \p O.  Instantiations performed to specialize a reflection type stay
+  /// attributed to the reflection.
+  void pushOrigin(ASTNodeOrigin O) {
+    if (O == ASTNodeOrigin::Instantiated &&
+        getOrigin() == ASTNodeOrigin::ReflectionSpecialization)
+      O = ASTNodeOrigin::ReflectionSpecialization;
+    Origins.push_back(O);
+  }
+
+  void popOrigin() {
+    assert(!Origins.empty() && "Unbalanced AST node origins");
+    Origins.pop_back();
+  }
+
+  void recordDecl(const Decl *D, size_t Size) {
+    Allocations.push_back({D, unsigned(Size), /*IsDecl=*/true, getOrigin()});
+  }
+
+  void recordStmt(const Stmt *S, size_t Size) {
+    Allocations.push_back({S, unsigned(Size), /*IsDecl=*/false, getOrigin()});
+  }
+
+  /// \brief Write the report as CSV, one line per source file, node kind and
+  /// origin, sorted by decreasing size.  Statements are recorded whether they
+  /// are allocated with Stmt::operator new or Stmt::allocate.  The memory of
+  /// \p Ctx that was not allocated for declarations or statements (types,
+  /// the side tables of the nodes, and slab slack) is reported on a final
+  /// "<other>" line.
+  void print(raw_ostream &OS, const ASTContext &Ctx) const;
+
+private:
+  struct Allocation {
+    const void *Node;
+    unsigned Size;
+    bool IsDecl;
+    ASTNodeOrigin Origin;
+  };
+
+  std::vector<Allocation> Allocations;
+  SmallVector<ASTNodeOrigin, 8> Origins;
+};
+
+/// \brief Attributes the nodes allocated in a scope to an origin, when
+/// -fast-memory-report is enabled.
+class ASTNodeOriginRAII {
+  ASTMemoryReport *Report;
+
+public:
+  ASTNodeOriginRAII(const ASTContext &Ctx, ASTNodeOrigin O);
+  ~ASTNodeOriginRAII() {
+    if (Report)
+      Report->popOrigin();
+  }
+
+  ASTNodeOriginRAII(const ASTNodeOriginRAII &) = delete;
+  ASTNodeOriginRAII &operator=(const ASTNodeOriginRAII &) = delete;
+};
+
+} // end namespace clang
+
+#endif
@@ -2420,6 +2420,10 @@ public:
   /// as appropriate for passing to ASTRecordLayout::getFieldOffset.
   unsigned getFieldIndex() const;
 
+  /// \brief Forget the cached field index. This must be called when the
+  /// field is moved to a different record.
+  void clearCachedFieldIndex() { CachedFieldIndex = 0; }
+
   /// isMutable - Determines whether this field is mutable (C++ only).
   bool isMutable() const { return Mutable; }
 
@@ -1366,6 +1366,10 @@ public:
 
   bool isStdNamespace() const;
 
+  /// \brief Determines whether this context is the cppx::meta namespace of
+  /// the reflection library, or an inline namespace within it.
+  bool isCppxMetaNamespace() const;
+
   bool isInlineNamespace() const;
 
   /// \brief Determines whether this context is dependent on a
@@ -630,6 +630,10 @@ class CXXRecordDecl : public RecordDecl {
   /// generate the definition of this class.
   Expr *Generator;
 
+  /// \brief True if this is a prototype class whose metaclass has been
+  /// applied. See isDiscarded().
+  bool Discarded;
+
   friend class DeclContext;
   friend class LambdaExpr;
 
@@ -1778,6 +1782,15 @@ public:
   /// \brief Associates a generating function with with a class.
   void setGenerator(Expr *E) { Generator = E; }
 
+  /// \brief Returns \c true if this is a prototype class whose metaclass has
+  /// been applied. The members of a discarded prototype have either been
+  /// adopted by the generated class or are no longer needed, so they are not
+  /// emitted by CodeGen or written to AST files.
+  bool isDiscarded() const { return Discarded; }
+
+  /// \brief Marks this prototype class as discarded.
+  void setDiscarded(bool D = true) { Discarded = D; }
+
   static bool classof(const Decl *D) { return classofKind(D->getKind()); }
   static bool classofKind(Kind K) {
     return K >= firstCXXRecord && K <= lastCXXRecord;
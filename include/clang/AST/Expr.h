@@ -114,12 +114,35 @@ struct InjectionInfo {
   QualType InjecteeType;
 };
 
+/// A sequence of fragment injections into the current context. Loops that
+/// inject a fragment on each iteration produce a single batch rather than
+/// one injection per iteration, so that the injections can be applied
+/// together.
+struct InjectionBatch {
+  /// The types of the injected fragments. Consecutive entries are often
+  /// the same.
+  SmallVector<QualType, 8> ReflectionTypes;
+
+  /// The values of the injected fragments (i.e., their captures).
+  SmallVector<APValue, 8> ReflectionValues;
+
+  /// Appends an injection to the batch, taking the value from V.
+  void add(QualType T, APValue &V) {
+    ReflectionTypes.push_back(T);
+    ReflectionValues.emplace_back();
+    ReflectionValues.back().swap(V);
+  }
+
+  std::size_t size() const { return ReflectionTypes.size(); }
+};
+
 /// Represents a side-effect to constexpr evaluation. When recorded,
 /// these are returned to the semantic analyzer for subsequent processing.
 struct EvalEffect
 {
   enum {
     InjectionEffect,
+    InjectionBatchEffect,
     DiagnosticEffect,
   } Kind;
 
@@ -127,19 +150,53 @@ struct EvalEffect
     /// Information about the injected entity.
     InjectionInfo *Injection;
 
+    /// A sequence of fragment injections.
+    InjectionBatch *Batch;
+
     /// The argument to the print function: a reflection value.
     APValue *DiagnosticArg;
   };
 
   EvalEffect()
-    : Injection(nullptr)
+    : Kind(InjectionEffect), Injection(nullptr)
   { }
 
+  EvalEffect(const EvalEffect &) = delete;
+  EvalEffect &operator=(const EvalEffect &) = delete;
+
+  /// Effects own their information. Moving an effect (e.g., when the 
+  /// effect list grows) transfers that ownership.
+  EvalEffect(EvalEffect &&E)
+    : Kind(E.Kind)
+  {
+    switch (Kind) {
+    case InjectionEffect:
+      Injection = E.Injection;
+      E.Injection = nullptr;
+      break;
+    case InjectionBatchEffect:
+      Batch = E.Batch;
+      E.Batch = nullptr;
+      break;
+    case DiagnosticEffect:
+      DiagnosticArg = E.DiagnosticArg;
+      E.DiagnosticArg = nullptr;
+      break;
+    }
+  }
+
   ~EvalEffect() {
-    if (Kind == InjectionEffect)
+    switch (Kind) {
+    case InjectionEffect:
       delete Injection;
-    else
+      break;
+    case InjectionBatchEffect:
+      delete Batch;
+      break;
+    case DiagnosticEffect:
       delete DiagnosticArg;
+      break;
+    }
   }
 };
 
@@ -294,6 +294,12 @@ public:
     return operator new(bytes, *C, alignment);
   }
 
+  /// \brief Allocate \p bytes in \p C for a statement that the caller then
+  /// constructs with placement new, as the Create functions of statements
+  /// with trailing objects do.
+  static void *allocate(const ASTContext &C, size_t bytes,
+                        unsigned alignment = 8);
+
   void *operator new(size_t bytes, void *mem) noexcept { return mem; }
 
   void operator delete(void *, const ASTContext &, unsigned) noexcept {}
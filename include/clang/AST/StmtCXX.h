@@ -340,13 +340,18 @@ class CXXTupleExpansionStmt : public CXXExpansionStmt {
   /// the initializer for the loop variable.
   TemplateParameterList *Parms;
 
+  /// \brief A single loop equivalent to the instantiated statements, if they
+  /// differ only in constant values. This is not a sub-expression.
+  Stmt *RolledStmt;
+
 public:
   CXXTupleExpansionStmt(TemplateParameterList *TP, DeclStmt *RangeVar,
                         DeclStmt *LoopVar, Stmt *Body, std::size_t N,
                         SourceLocation FL, SourceLocation EL, SourceLocation CL,
                         SourceLocation RPL);
   CXXTupleExpansionStmt(EmptyShell Empty)
-      : CXXExpansionStmt(CXXTupleExpansionStmtClass, Empty) {}
+      : CXXExpansionStmt(CXXTupleExpansionStmtClass, Empty),
+        RolledStmt(nullptr) {}
 
   /// \brief Returns the template parameter list of the declaration.
   TemplateParameterList *getTemplateParameters() { return Parms; }
@@ -362,6 +367,16 @@ public:
   Expr *getRangeInit();
   const Expr *getRangeInit() const;
 
+  /// \brief Returns the loop that code generation emits in place of the
+  /// instantiated statements, or null if they must be emitted one by one.
+  ///
+  /// The loop runs the statement instantiated for the first element once per
+  /// element, reading the constants that differ between the elements from
+  /// static tables indexed by the iteration count. The range variable is
+  /// not part of it.
+  Stmt *getRolledStatement() const { return RolledStmt; }
+  void setRolledStatement(Stmt *S) { RolledStmt = S; }
+
   static bool classof(const Stmt *T) {
     return T->getStmtClass() == CXXTupleExpansionStmtClass;
   }
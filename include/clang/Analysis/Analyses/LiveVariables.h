@@ -16,7 +16,7 @@
 
 #include "clang/AST/Decl.h"
 #include "clang/Analysis/AnalysisContext.h"
-#include "llvm/ADT/ImmutableSet.h"
+#include "llvm/ADT/SparseBitVector.h"
 
 namespace clang {
 
@@ -28,20 +28,29 @@ class SourceManager;
   
 class LiveVariables : public ManagedAnalysis {
 public:
+  /// Maps the statements and variables seen by the analysis to dense
+  /// indices into the bit vectors of LivenessValues.
+  class Numbering;
+
   class LivenessValues {
   public:
 
-    llvm::ImmutableSet<const Stmt *> liveStmts;
-    llvm::ImmutableSet<const VarDecl *> liveDecls;
+    /// The live statements, indexed by the numbering.  Only a handful of
+    /// statements are live at any point, so this set is kept sparse.
+    llvm::SparseBitVector<> liveStmts;
+
+    /// The live variables, indexed by the numbering.  A value is recorded
+    /// for every statement, so this set is kept sparse as well; a dense
+    /// vector would make those snapshots quadratic in the number of locals.
+    llvm::SparseBitVector<> liveDecls;
+
+    /// The numbering the bit vectors are indexed by, or null if nothing has
+    /// been recorded in this value yet.
+    const Numbering *numbering;
     
     bool equals(const LivenessValues &V) const;
 
-    LivenessValues()
-      : liveStmts(nullptr), liveDecls(nullptr) {}
-
-    LivenessValues(llvm::ImmutableSet<const Stmt *> LiveStmts,
-                   llvm::ImmutableSet<const VarDecl *> LiveDecls)
-      : liveStmts(LiveStmts), liveDecls(LiveDecls) {}
+    LivenessValues() : numbering(nullptr) {}
 
     bool isLive(const Stmt *S) const;
     bool isLive(const VarDecl *D) const;
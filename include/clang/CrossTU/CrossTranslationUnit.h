@@ -0,0 +1,161 @@
+//===--- CrossTranslationUnit.h - Cross-TU function import ------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file provides an interface to load the definitions of functions from
+//  the AST files of other translation units on demand, and to import them
+//  into the current ASTContext.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_CROSSTU_CROSSTRANSLATIONUNIT_H
+#define LLVM_CLANG_CROSSTU_CROSSTRANSLATIONUNIT_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Error.h"
+#include <list>
+#include <memory>
+#include <string>
+
+namespace clang {
+class ASTContext;
+class ASTImporter;
+class ASTUnit;
+class CompilerInstance;
+class FunctionDecl;
+class NamedDecl;
+
+namespace cross_tu {
+
+enum class index_error_code {
+  unspecified = 1,
+  missing_index_file,
+  invalid_index_format,
+  multiple_definitions,
+  missing_definition,
+  failed_import,
+  failed_to_get_external_ast
+};
+
+/// \brief The error reported when a cross translation unit definition
+/// cannot be found, loaded or imported.
+class IndexError : public llvm::ErrorInfo<IndexError> {
+public:
+  static char ID;
+  IndexError(index_error_code C) : Code(C), LineNo(0) {}
+  IndexError(index_error_code C, std::string FileName, int LineNo = 0)
+      : Code(C), FileName(std::move(FileName)), LineNo(LineNo) {}
+  void log(raw_ostream &OS) const override;
+  std::error_code convertToErrorCode() const override;
+  index_error_code getCode() const { return Code; }
+  int getLineNum() const { return LineNo; }
+  std::string getFileName() const { return FileName; }
+
+private:
+  index_error_code Code;
+  std::string FileName;
+  int LineNo;
+};
+
+/// \brief Parse an index file that maps the lookup names of function
+/// definitions to the AST files that contain them.
+///
+/// Each line of the index has the form "<lookup name> <AST file>".  Relative
+/// AST file names are resolved against \p CrossTUDir.
+llvm::Expected<llvm::StringMap<std::string>>
+parseCrossTUIndex(StringRef IndexPath, StringRef CrossTUDir);
+
+/// \brief Serialize \p Index in the format read by parseCrossTUIndex().
+std::string createCrossTUIndexString(const llvm::StringMap<std::string> &Index);
+
+/// \brief Loads the AST files of other translation units on demand and
+/// imports function definitions from them into the ASTContext of a compiler
+/// instance.
+///
+/// Loaded AST files are cached until the memory they use exceeds the limit
+/// set with setMemoryLimit(), at which point the least recently used ones are
+/// released.  Imported definitions stay in the current ASTContext, and every
+/// lookup, including failed ones, is memoized, so a function is never looked
+/// up or imported twice.
+class CrossTranslationUnitContext {
+public:
+  CrossTranslationUnitContext(CompilerInstance &CI);
+  ~CrossTranslationUnitContext();
+
+  /// \brief Return the definition of \p FD, importing it from the AST file
+  /// that the index in \p CrossTUDir names for it if \p FD has no body in
+  /// the current translation unit.
+  ///
+  /// \param IndexName The name of the index file, relative to \p CrossTUDir.
+  llvm::Expected<const FunctionDecl *>
+  getCrossTUDefinition(const FunctionDecl *FD, StringRef CrossTUDir,
+                       StringRef IndexName);
+
+  /// \brief Load the AST file that defines the function with lookup name
+  /// \p LookupName, or return the cached unit if it is already loaded.
+  llvm::Expected<ASTUnit *> loadExternalAST(StringRef LookupName,
+                                            StringRef CrossTUDir,
+                                            StringRef IndexName);
+
+  /// \brief Import the definition \p FD, which must belong to the loaded
+  /// unit \p Unit, into the current ASTContext.
+  llvm::Expected<const FunctionDecl *> importDefinition(const FunctionDecl *FD,
+                                                        ASTUnit *Unit);
+
+  /// \brief Release loaded AST files, least recently used first, until they
+  /// use no more than \p Bytes of AST memory.  Zero means no limit.
+  void setMemoryLimit(uint64_t Bytes);
+
+  /// \brief Return the name that identifies \p ND across translation units.
+  static std::string getLookupName(const NamedDecl *ND);
+
+private:
+  struct LoadedUnit {
+    std::string FileName;
+    std::unique_ptr<ASTUnit> Unit;
+    std::unique_ptr<ASTImporter> Importer;
+    uint64_t Bytes;
+  };
+
+  ASTImporter &getOrCreateImporter(LoadedUnit &Loaded);
+  void touch(std::list<LoadedUnit>::iterator It);
+  void evictUnits(const ASTUnit *Keep);
+
+  /// \brief Return the AST memory \p Unit uses now. Units deserialize lazily,
+  /// so this grows with every lookup in and import from the unit.
+  static uint64_t getUnitSize(const ASTUnit &Unit);
+
+  /// \brief Measure \p Unit again after it was used.
+  void updateUnitSize(const ASTUnit *Unit);
+
+  CompilerInstance &CI;
+  ASTContext &Context;
+
+  /// \brief The parsed index, by index file name.
+  llvm::StringMap<llvm::StringMap<std::string>> Indexes;
+
+  /// \brief The loaded units, most recently used first.
+  std::list<LoadedUnit> Units;
+  llvm::StringMap<std::list<LoadedUnit>::iterator> UnitsByFile;
+  llvm::DenseMap<const ASTUnit *, std::list<LoadedUnit>::iterator>
+      UnitsByPointer;
+  uint64_t LoadedBytes;
+  uint64_t MemoryLimit;
+
+  /// \brief The definitions found for each lookup name, and the reason the
+  /// lookup failed for the others.
+  llvm::StringMap<const FunctionDecl *> ImportedDefinitions;
+  llvm::StringMap<index_error_code> FailedLookups;
+};
+
+} // namespace cross_tu
+} // namespace clang
+
+#endif // LLVM_CLANG_CROSSTU_CROSSTRANSLATIONUNIT_H
@@ -221,6 +221,14 @@ public:
   /// or when using the -gen-reproducer driver flag.
   unsigned GenReproducer : 1;
 
+  /// Runs the integrated cc1 frontend in the driver's process, given the
+  /// argument vector it would get in a process of its own.
+  typedef int (*CC1ToolFunc)(ArrayRef<const char *> Argv);
+
+  /// The cc1 entry point of the driver binary, if it provides one; only
+  /// then can -fintegrated-cc1 skip spawning the frontend.
+  CC1ToolFunc CC1Main;
+
 private:
   /// Certain options suppress the 'no input files' warning.
   unsigned SuppressMissingInputWarning : 1;
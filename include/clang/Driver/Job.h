@@ -73,6 +73,9 @@ class Command {
   /// See Command::setEnvironment
   std::vector<const char *> Environment;
 
+  /// See Command::setInProcess
+  bool InProcess;
+
   /// When a response file is needed, we try to put most arguments in an
   /// exclusive file, while others remains as regular command line arguments.
   /// This functions fills a vector with the regular command line arguments,
@@ -121,6 +124,11 @@ public:
   ///         from the parent process will be used.
   void setEnvironment(llvm::ArrayRef<const char *> NewEnvironment);
 
+  /// \brief Sets whether the command may run inside the driver's process.
+  /// Only commands that know how to do that look at this.
+  void setInProcess(bool Value) { InProcess = Value; }
+  bool isInProcess() const { return InProcess; }
+
   const char *getExecutable() const { return Executable; }
 
   const llvm::opt::ArgStringList &getArguments() const { return Arguments; }
@@ -129,6 +137,20 @@ public:
   static void printArg(llvm::raw_ostream &OS, StringRef Arg, bool Quote);
 };
 
+/// Like Command, but runs the integrated cc1 frontend inside the driver's
+/// process when it is allowed to, instead of spawning a new one. A crash in
+/// the frontend is caught by a crash recovery context and reported like a
+/// crashed process.
+class CC1Command : public Command {
+public:
+  CC1Command(const Action &Source_, const Tool &Creator_,
+             const char *Executable_, const ArgStringList &Arguments_,
+             ArrayRef<InputInfo> Inputs);
+
+  int Execute(const StringRef **Redirects, std::string *ErrMsg,
+              bool *ExecutionFailed) const override;
+};
+
 /// Like Command, but with a fallback which is executed in case
 /// the primary command crashes.
 class FallbackCommand : public Command {
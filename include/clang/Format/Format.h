@@ -1626,6 +1626,10 @@ llvm::Expected<FormatStyle> getStyle(StringRef StyleName, StringRef FileName,
                                      StringRef Code = "",
                                      vfs::FileSystem *FS = nullptr);
 
+/// \brief Returns the language ``getStyle()`` picks for the file ``FileName``
+/// with the content ``Code``.
+FormatStyle::LanguageKind guessLanguage(StringRef FileName, StringRef Code);
+
 // \brief Returns a string representation of ``Language``.
 inline StringRef getLanguageName(FormatStyle::LanguageKind Language) {
   switch (Language) {
@@ -149,6 +149,10 @@ public:
   /// in the backend for setting the name in the skeleton cu.
   std::string SplitDwarfFile;
 
+  /// The file to which the origins of functions created by source code
+  /// injection are written, if any.
+  std::string InjectionMapFile;
+
   /// The name of the relocation model to use.
   std::string RelocationModel;
 
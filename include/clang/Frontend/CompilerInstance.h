@@ -44,6 +44,7 @@ class ExternalASTSource;
 class FileEntry;
 class FileManager;
 class FrontendAction;
+class IncludePrefetcher;
 class MemoryBufferCache;
 class Module;
 class Preprocessor;
@@ -88,6 +89,10 @@ class CompilerInstance : public ModuleLoader {
   /// The file manager.
   IntrusiveRefCntPtr<FileManager> FileMgr;
 
+  /// The file system layer that reads headers ahead of the preprocessor, if
+  /// enabled.
+  IntrusiveRefCntPtr<IncludePrefetcher> Prefetcher;
+
   /// The source manager.
   IntrusiveRefCntPtr<SourceManager> SourceMgr;
 
@@ -374,6 +379,9 @@ public:
 
   bool hasVirtualFileSystem() const { return VirtualFileSystem != nullptr; }
 
+  /// Return the include prefetcher, or null if it is not enabled.
+  IncludePrefetcher *getIncludePrefetcher() const { return Prefetcher.get(); }
+
   vfs::FileSystem &getVirtualFileSystem() const {
     assert(hasVirtualFileSystem() &&
            "Compiler instance has no virtual file system");
@@ -202,6 +202,8 @@ public:
                                            ///< files into the PCM file.
   unsigned IncludeTimestamps : 1;          ///< Whether timestamps should be
                                            ///< written to the produced PCH file.
+  unsigned CompressPCHTables : 1;          ///< Whether large lazily-loaded
+                                           ///< tables should be compressed.
 
   CodeCompleteOptions CodeCompleteOpts;
 
@@ -324,6 +326,9 @@ public:
   /// Filename to write statistics to.
   std::string StatsFile;
 
+  /// Filename to write the AST memory report to.
+  std::string ASTMemoryReportFile;
+
 public:
   FrontendOptions() :
     DisableFree(false), RelocatablePCH(false), ShowHelp(false),
@@ -333,7 +338,7 @@ public:
     SkipFunctionBodies(false), UseGlobalModuleIndex(true),
     GenerateGlobalModuleIndex(true), ASTDumpDecls(false), ASTDumpLookups(false),
     BuildingImplicitModule(false), ModulesEmbedAllFiles(false),
-    IncludeTimestamps(true), ARCMTAction(ARCMT_None),
+    IncludeTimestamps(true), CompressPCHTables(false), ARCMTAction(ARCMT_None),
     ObjCMTAction(ObjCMT_None), ProgramAction(frontend::ParseSyntaxOnly)
   {}
 
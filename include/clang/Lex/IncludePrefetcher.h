@@ -0,0 +1,156 @@
+//===--- IncludePrefetcher.h - Read headers ahead of the lexer --*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Defines the IncludePrefetcher interface, a file system that scans
+/// and reads headers on a producer thread ahead of the preprocessor.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_LEX_INCLUDEPREFETCHER_H
+#define LLVM_CLANG_LEX_INCLUDEPREFETCHER_H
+
+#include "clang/Basic/LangOptions.h"
+#include "clang/Basic/VirtualFileSystem.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Config/llvm-config.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace llvm {
+class MemoryBuffer;
+}
+
+namespace clang {
+
+class HeaderSearch;
+class PPCallbacks;
+class SourceManager;
+
+/// \brief A file system that raw-lexes source files on a producer thread to
+/// find their \#include directives, and reads the headers they name before
+/// the preprocessor gets to them.
+///
+/// This only takes file I/O off the preprocessor's thread. Lexing, macro
+/// expansion and include handling still run on the thread that parses, and
+/// no tokens are produced ahead of the parser: the preprocessor shares its
+/// identifier table, source manager and diagnostics with Sema.
+///
+/// The producer only ever looks at buffers it read itself and at a snapshot of
+/// the header search paths, so it shares no state with the preprocessor or
+/// Sema. Headers whose name is computed by a macro, headers found through
+/// header maps or frameworks, and module imports are not predicted; the
+/// preprocessor reads those synchronously from the underlying file system,
+/// just as it does for any prefetched file that changed on disk in between.
+/// A predicted header that the preprocessor opens before the producer got to
+/// it is moved to the front of the queue and waited for, rather than read
+/// twice.
+///
+/// Without thread support the producer never starts and nothing is queued.
+class IncludePrefetcher : public vfs::FileSystem {
+  struct PrefetchedFile {
+    vfs::Status Status;
+    std::unique_ptr<llvm::MemoryBuffer> Buffer;
+  };
+
+  IntrusiveRefCntPtr<vfs::FileSystem> Underlying;
+  LangOptions LangOpts;
+
+  /// \brief Directories searched for "quoted" and <angled> includes, in order.
+  std::vector<std::string> QuotedDirs;
+  std::vector<std::string> AngledDirs;
+
+  /// \brief The files already scanned; only touched by the producer thread.
+  llvm::StringSet<> Scanned;
+
+  /// \brief Protects everything below.
+  std::mutex Lock;
+  std::condition_variable QueueChanged;
+  std::condition_variable ScanFinished;
+
+  /// \brief Files waiting to be scanned, paired with whether their contents
+  /// should be kept for the preprocessor.
+  std::deque<std::pair<std::string, bool>> Queue;
+
+  /// \brief The file the producer is scanning, if any.
+  std::pair<std::string, bool> Scanning;
+
+  /// \brief Buffers read ahead of the preprocessor, keyed by path.
+  llvm::StringMap<PrefetchedFile> Prefetched;
+  uint64_t PrefetchedBytes;
+  bool Stopping;
+
+  unsigned NumPrefetched;
+  unsigned NumHits;
+  unsigned NumStale;
+
+#if LLVM_ENABLE_THREADS
+  std::thread Producer;
+#endif
+
+  void run();
+  void scan(StringRef Path, bool Keep);
+  void resolve(StringRef Includer, StringRef Filename, bool IsAngled);
+
+  /// \brief Whether the producer has yet to finish scanning \p Path, only
+  /// counting files it will keep if \p KeptOnly. Requires the lock.
+  bool isPending(StringRef Path, bool KeptOnly) const;
+
+  /// \brief Move \p Path to the front of the queue and wait until the
+  /// producer has scanned it.
+  void waitFor(StringRef Path, bool KeptOnly,
+               std::unique_lock<std::mutex> &Guard);
+
+public:
+  /// \brief The most bytes held in prefetched buffers at any one time.
+  static const uint64_t MaxPrefetchedBytes = 256 * 1024 * 1024;
+
+  IncludePrefetcher(IntrusiveRefCntPtr<vfs::FileSystem> FS,
+                    const LangOptions &LangOpts);
+  ~IncludePrefetcher() override;
+
+  /// \brief Start the producer thread, resolving includes against the search
+  /// paths of \p HS as they are now. A stopped prefetcher can be started
+  /// again.
+  void start(const HeaderSearch &HS);
+
+  /// \brief Stop the producer thread and release any buffers the preprocessor
+  /// did not ask for.
+  void stop();
+
+  /// \brief Ask the producer to scan the includes of \p Path, which the
+  /// preprocessor has already read. If \p Wait, only return once it has,
+  /// so that the headers \p Path names are queued before the preprocessor
+  /// can include them.
+  void enqueue(StringRef Path, bool Wait = false);
+
+  /// \brief Create callbacks that keep the producer following the files the
+  /// preprocessor enters, and stop it at the end of the main file.
+  std::unique_ptr<PPCallbacks> createPPCallbacks(SourceManager &SM);
+
+  void PrintStats() const;
+
+  llvm::ErrorOr<vfs::Status> status(const Twine &Path) override;
+  llvm::ErrorOr<std::unique_ptr<vfs::File>>
+  openFileForRead(const Twine &Path) override;
+  vfs::directory_iterator dir_begin(const Twine &Dir,
+                                    std::error_code &EC) override;
+  std::error_code setCurrentWorkingDirectory(const Twine &Path) override;
+  llvm::ErrorOr<std::string> getCurrentWorkingDirectory() const override;
+};
+
+} // end namespace clang
+
+#endif // LLVM_CLANG_LEX_INCLUDEPREFETCHER_H
@@ -22,11 +22,24 @@
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Allocator.h"
 #include <cassert>
+#include <utility>
 
 namespace clang {
 class Module;
 class ModuleMacro;
 class Preprocessor;
+class MacroInfo;
+
+/// \brief The fully expanded replacement list of an object-like macro, as
+/// cached by the preprocessor.
+struct CachedMacroExpansion {
+  /// \brief The expanded tokens, located at their spelling locations.
+  ArrayRef<Token> Tokens;
+
+  /// \brief Each identifier the expansion depends on, with the macro it named
+  /// when the expansion was cached (null if it named none).
+  ArrayRef<std::pair<const IdentifierInfo *, const MacroInfo *>> Dependencies;
+};
 
 /// \brief Encapsulates the data about a macro definition (e.g. its tokens).
 ///
@@ -108,6 +121,13 @@ class MacroInfo {
   /// \brief Whether this macro was used as header guard.
   bool UsedForHeaderGuard : 1;
 
+  /// \brief False if an expansion of this macro was found to depend on the
+  /// context it was expanded in, so it should not be cached.
+  bool IsExpansionCacheable : 1;
+
+  /// \brief The cached expansion of this object-like macro, if any.
+  const CachedMacroExpansion *ExpansionCache;
+
   // Only the Preprocessor gets to create and destroy these.
   MacroInfo(SourceLocation DefLoc);
   ~MacroInfo() = default;
@@ -266,6 +286,21 @@ public:
 
   void setUsedForHeaderGuard(bool Val) { UsedForHeaderGuard = Val; }
 
+  /// \brief Determine whether the expansion of this macro may be cached.
+  bool isExpansionCacheable() const { return IsExpansionCacheable; }
+
+  void setExpansionCacheable(bool Val) { IsExpansionCacheable = Val; }
+
+  /// \brief Return the cached expansion of this macro, or null if there is
+  /// none.
+  const CachedMacroExpansion *getExpansionCache() const {
+    return ExpansionCache;
+  }
+
+  void setExpansionCache(const CachedMacroExpansion *Cache) {
+    ExpansionCache = Cache;
+  }
+
   void dump() const;
 
 private:
@@ -186,6 +186,9 @@ class Preprocessor {
   /// \brief True if we are pre-expanding macro arguments.
   bool InMacroArgPreExpansion;
 
+  /// \brief True if the expansions of object-like macros are cached.
+  bool CacheMacroExpansions;
+
   /// \brief Mapping/lookup information for all identifiers in
   /// the program, including program keywords.
   mutable IdentifierTable Identifiers;
@@ -584,6 +587,7 @@ class Preprocessor {
   unsigned NumMacroExpanded, NumFnMacroExpanded, NumBuiltinMacroExpanded;
   unsigned NumFastMacroExpanded, NumTokenPaste, NumFastTokenPaste;
   unsigned NumSkipped;
+  unsigned NumCachedMacroExpansions, NumCachedMacroExpanded;
 
   /// \brief The predefined macros that preprocessor should use from the
   /// command line etc.
@@ -607,6 +611,30 @@ class Preprocessor {
   SmallVector<Token, 16> MacroExpandedTokens;
   std::vector<std::pair<TokenLexer *, size_t> > MacroExpandingLexersStack;
 
+  /// \brief The expansion of an object-like macro that is being recorded,
+  /// so that it can be cached once its token lexer is popped.
+  struct MacroExpansionRecording {
+    /// \brief The macro being expanded, or null if nothing is recorded.
+    MacroInfo *Macro = nullptr;
+
+    /// \brief The token lexer that expands the macro.
+    TokenLexer *Lexer = nullptr;
+
+    /// \brief The number of warnings emitted before the expansion started.
+    unsigned NumWarnings = 0;
+
+    /// \brief False if the expansion was found to depend on its context.
+    bool Cacheable = true;
+
+    /// \brief The tokens the expansion produced so far.
+    SmallVector<Token, 16> Tokens;
+
+    /// \brief The macros expanded so far.
+    SmallVector<std::pair<const IdentifierInfo *, const MacroInfo *>, 8>
+        Dependencies;
+  };
+  MacroExpansionRecording ExpansionRecording;
+
   /// \brief A record of the macro definitions and expansions that
   /// occurred during preprocessing.
   ///
@@ -1810,6 +1838,32 @@ private:
   /// otherwise the caller should lex again.
   bool HandleMacroExpandedIdentifier(Token &Tok, const MacroDefinition &MD);
 
+  /// \brief Determine whether the expansion of \p MI here may be taken from,
+  /// or recorded into, its expansion cache.
+  bool canCacheMacroExpansion(const MacroDefinition &MD,
+                              const MacroInfo *MI) const {
+    return CacheMacroExpansions && !MI->isFunctionLike() &&
+           MI->isExpansionCacheable() && !MD.isAmbiguous() && !Callbacks &&
+           !InMacroArgs;
+  }
+
+  /// \brief If the cached expansion of \p MI is still valid here, enter its
+  /// tokens as if \p MI had been expanded at \p Identifier.
+  ///
+  /// \returns true if the cached expansion was used.
+  bool EnterCachedMacroExpansion(Token &Identifier, SourceLocation ILEnd,
+                                 MacroInfo *MI);
+
+  /// \brief Record the tokens of the expansion of \p MI that was just entered.
+  void StartMacroExpansionRecording(MacroInfo *MI);
+
+  /// \brief Stop recording and cache the expansion if it turned out to be
+  /// independent of its context.
+  ///
+  /// \param Complete false if the expansion was cut short or ran into the
+  /// tokens that follow it.
+  void FinishMacroExpansionRecording(bool Complete);
+
   /// \brief Cache macro expanded tokens for TokenLexers.
   //
   /// Works like a stack; a TokenLexer adds the macro expanded tokens that is
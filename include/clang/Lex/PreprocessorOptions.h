@@ -54,6 +54,14 @@ public:
   /// definitions and expansions.
   unsigned DetailedRecord : 1;
 
+  /// \brief Whether headers should be found and read on a separate thread
+  /// ahead of the preprocessor.
+  unsigned PrefetchIncludes : 1;
+
+  /// \brief Whether the expansions of object-like macros that do not depend
+  /// on their context should be cached and reused.
+  unsigned CacheMacroExpansions : 1;
+
   /// The implicit PCH included at the start of the translation unit, or empty.
   std::string ImplicitPCHInclude;
 
@@ -140,6 +148,8 @@ public:
 
 public:
   PreprocessorOptions() : UsePredefines(true), DetailedRecord(false),
+                          PrefetchIncludes(false),
+                          CacheMacroExpansions(false),
                           DisablePCHValidation(false),
                           AllowPCHWithCompilerErrors(false),
                           DumpDeserializedPCHDecls(false),
@@ -16,7 +16,9 @@
 #define LLVM_CLANG_REWRITE_CORE_HTMLREWRITE_H
 
 #include "clang/Basic/SourceLocation.h"
+#include "llvm/ADT/ArrayRef.h"
 #include <string>
+#include <vector>
 
 namespace clang {
 
@@ -65,16 +67,39 @@ namespace html {
   void AddHeaderFooterInternalBuiltinCSS(Rewriter &R, FileID FID,
                                          StringRef title);
 
+  /// HighlightedRange - A range of a file, in file offsets, and the tags that
+  /// SyntaxHighlight or HighlightMacros wrap it in.
+  struct HighlightedRange {
+    unsigned Begin, End;
+    std::string StartTag, EndTag;
+  };
+
   /// SyntaxHighlight - Relex the specified FileID and annotate the HTML with
   /// information about keywords, comments, etc.
   void SyntaxHighlight(Rewriter &R, FileID FID, const Preprocessor &PP);
 
+  /// SyntaxHighlight - This is the same as the above method, but collects the
+  /// highlighted ranges instead of inserting them, so that they can be
+  /// applied to several rewriters with ApplyHighlights.
+  void SyntaxHighlight(std::vector<HighlightedRange> &Ranges, FileID FID,
+                       const Preprocessor &PP);
+
   /// HighlightMacros - This uses the macro table state from the end of the
   /// file, to reexpand macros and insert (into the HTML) information about the
   /// macro expansions.  This won't be perfectly perfect, but it will be
   /// reasonably close.
   void HighlightMacros(Rewriter &R, FileID FID, const Preprocessor &PP);
 
+  /// HighlightMacros - This is the same as the above method, but collects the
+  /// highlighted ranges instead of inserting them.
+  void HighlightMacros(std::vector<HighlightedRange> &Ranges, FileID FID,
+                       const Preprocessor &PP);
+
+  /// ApplyHighlights - Insert the tags of ranges collected by SyntaxHighlight
+  /// or HighlightMacros, in the order they were collected.
+  void ApplyHighlights(Rewriter &R, FileID FID,
+                       ArrayRef<HighlightedRange> Ranges);
+
 } // end html namespace
 } // end clang namespace
 
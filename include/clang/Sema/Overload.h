@@ -23,9 +23,9 @@
 #include "clang/AST/UnresolvedSet.h"
 #include "clang/Sema/SemaFixItUtils.h"
 #include "clang/Sema/TemplateDeduction.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
-#include "llvm/Support/AlignOf.h"
 #include "llvm/Support/Allocator.h"
 
 namespace clang {
@@ -722,6 +722,38 @@ namespace clang {
     }
   };
 
+  /// OverloadCandidateArenaPool - Bump allocators that back the candidates
+  /// and conversion sequences of OverloadCandidateSets. Candidate sets nest
+  /// (and outlive one another inside InitializationSequences), so each live
+  /// set borrows an allocator of its own; when the set is destroyed the
+  /// allocator is reset, keeping its first slab, and handed to the next set.
+  class OverloadCandidateArenaPool {
+  public:
+    typedef llvm::BumpPtrAllocatorImpl<llvm::MallocAllocator, 16384> Arena;
+
+  private:
+    SmallVector<std::unique_ptr<Arena>, 8> Free;
+
+    /// The most idle allocators kept around for reuse.
+    constexpr static unsigned MaxFree = 8;
+
+  public:
+    std::unique_ptr<Arena> acquire() {
+      if (Free.empty())
+        return llvm::make_unique<Arena>();
+      std::unique_ptr<Arena> A = std::move(Free.back());
+      Free.pop_back();
+      return A;
+    }
+
+    void release(std::unique_ptr<Arena> A) {
+      if (Free.size() == MaxFree)
+        return;
+      A->Reset();
+      Free.push_back(std::move(A));
+    }
+  };
+
   /// OverloadCandidateSet - A set of overload candidates, used in C++
   /// overload resolution (C++ 13.3).
   class OverloadCandidateSet {
@@ -737,56 +769,31 @@ namespace clang {
     };
 
   private:
-    SmallVector<OverloadCandidate, 16> Candidates;
-    llvm::SmallPtrSet<Decl *, 16> Functions;
+    OverloadCandidateArenaPool &Pool;
+
+    /// Storage for the candidates and their ConversionSequenceLists, borrowed
+    /// from Pool for the lifetime of this set.
+    std::unique_ptr<OverloadCandidateArenaPool::Arena> Arena;
 
-    // Allocator for ConversionSequenceLists. We store the first few of these
-    // inline to avoid allocation for small sets.
-    llvm::BumpPtrAllocator SlabAllocator;
+    OverloadCandidate *Candidates;
+    unsigned NumCandidates;
+    unsigned CandidateCapacity;
+    llvm::SmallPtrSet<Decl *, 16> Functions;
 
     SourceLocation Loc;
     CandidateSetKind Kind;
 
-    constexpr static unsigned NumInlineBytes =
-        24 * sizeof(ImplicitConversionSequence);
-    unsigned NumInlineBytesUsed;
-    llvm::AlignedCharArray<alignof(void *), NumInlineBytes> InlineSpace;
-
-    /// If we have space, allocates from inline storage. Otherwise, allocates
-    /// from the slab allocator.
-    /// FIXME: It would probably be nice to have a SmallBumpPtrAllocator
-    /// instead.
-    /// FIXME: Now that this only allocates ImplicitConversionSequences, do we
-    /// want to un-generalize this?
-    template <typename T>
-    T *slabAllocate(unsigned N) {
-      // It's simpler if this doesn't need to consider alignment.
-      static_assert(alignof(T) == alignof(void *),
-                    "Only works for pointer-aligned types.");
-      static_assert(std::is_trivial<T>::value ||
-                        std::is_same<ImplicitConversionSequence, T>::value,
-                    "Add destruction logic to OverloadCandidateSet::clear().");
-
-      unsigned NBytes = sizeof(T) * N;
-      if (NBytes > NumInlineBytes - NumInlineBytesUsed)
-        return SlabAllocator.Allocate<T>(N);
-      char *FreeSpaceStart = InlineSpace.buffer + NumInlineBytesUsed;
-      assert(uintptr_t(FreeSpaceStart) % alignof(void *) == 0 &&
-             "Misaligned storage!");
-
-      NumInlineBytesUsed += NBytes;
-      return reinterpret_cast<T *>(FreeSpaceStart);
-    }
-
     OverloadCandidateSet(const OverloadCandidateSet &) = delete;
     void operator=(const OverloadCandidateSet &) = delete;
 
     void destroyCandidates();
 
+    /// Move the candidates to a larger array in the arena.
+    void growCandidates();
+
   public:
-    OverloadCandidateSet(SourceLocation Loc, CandidateSetKind CSK)
-        : Loc(Loc), Kind(CSK), NumInlineBytesUsed(0) {}
-    ~OverloadCandidateSet() { destroyCandidates(); }
+    OverloadCandidateSet(Sema &S, SourceLocation Loc, CandidateSetKind CSK);
+    ~OverloadCandidateSet();
 
     SourceLocation getLocation() const { return Loc; }
     CandidateSetKind getKind() const { return Kind; }
@@ -800,19 +807,19 @@ namespace clang {
     /// \brief Clear out all of the candidates.
     void clear();
 
-    typedef SmallVectorImpl<OverloadCandidate>::iterator iterator;
-    iterator begin() { return Candidates.begin(); }
-    iterator end() { return Candidates.end(); }
+    typedef OverloadCandidate *iterator;
+    iterator begin() { return Candidates; }
+    iterator end() { return Candidates + NumCandidates; }
 
-    size_t size() const { return Candidates.size(); }
-    bool empty() const { return Candidates.empty(); }
+    size_t size() const { return NumCandidates; }
+    bool empty() const { return NumCandidates == 0; }
 
     /// \brief Allocate storage for conversion sequences for NumConversions
     /// conversions.
     ConversionSequenceList
     allocateConversionSequences(unsigned NumConversions) {
       ImplicitConversionSequence *Conversions =
-          slabAllocate<ImplicitConversionSequence>(NumConversions);
+          Arena->Allocate<ImplicitConversionSequence>(NumConversions);
 
       // Construct the new objects.
       for (unsigned I = 0; I != NumConversions; ++I)
@@ -828,8 +835,10 @@ namespace clang {
       assert((Conversions.empty() || Conversions.size() == NumConversions) &&
              "preallocated conversion sequence has wrong length");
 
-      Candidates.push_back(OverloadCandidate());
-      OverloadCandidate &C = Candidates.back();
+      if (NumCandidates == CandidateCapacity)
+        growCandidates();
+      OverloadCandidate &C =
+          *new (&Candidates[NumCandidates++]) OverloadCandidate();
       C.Conversions = Conversions.empty()
                           ? allocateConversionSequences(NumConversions)
                           : Conversions;
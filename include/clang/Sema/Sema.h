@@ -158,6 +158,7 @@ namespace clang {
   class OMPDeclareSimdDecl;
   class OMPClause;
   struct OverloadCandidate;
+  class OverloadCandidateArenaPool;
   class OverloadCandidateSet;
   class OverloadExpr;
   class ParenListExpr;
@@ -610,6 +611,13 @@ public:
   /// completed.
   std::deque<InjectionContext *> PendingClassMemberInjections;
 
+  /// \brief The number of declarations copied by CopyDeclaration.
+  unsigned NumCopiedDecls;
+
+  /// \brief The number of prototype members moved into their generated
+  /// class instead of being copied.
+  unsigned NumAdoptedDecls;
+
 
   class DelayedDiagnostics;
 
@@ -1010,6 +1018,58 @@ public:
   /// for C++ records.
   llvm::FoldingSet<SpecialMemberOverloadResultEntry> SpecialMemberCache;
 
+  /// \brief The function chosen by a successful overload resolution for a
+  /// call or an overloaded operator.
+  class MemoizedOverloadResolution : public llvm::FastFoldingSetNode {
+  public:
+    MemoizedOverloadResolution(const llvm::FoldingSetNodeID &ID)
+      : FastFoldingSetNode(ID), Function(nullptr),
+        HadMultipleCandidates(false), Generation(0) {}
+
+    DeclAccessPair FoundDecl;
+    FunctionDecl *Function;
+    bool HadMultipleCandidates;
+
+    /// \brief The declaration generation of the ASTContext in which the
+    /// result was computed.
+    unsigned Generation;
+  };
+
+  /// \brief A cache of overload resolutions for non-dependent calls, keyed by
+  /// the callee name, the functions found by name lookup, and the types and
+  /// value categories of the arguments.
+  llvm::FoldingSet<MemoizedOverloadResolution> OverloadResolutionCache;
+
+  /// \brief Statistics for the overload resolution cache.
+  unsigned NumOverloadCacheHits;
+  unsigned NumOverloadCacheMisses;
+  unsigned NumOverloadCacheBypasses;
+
+  /// \brief Allocators recycled between the overload candidate sets built
+  /// for each call, operator and initialization.
+  std::unique_ptr<OverloadCandidateArenaPool> OverloadCandidateArenas;
+
+  /// \brief An identifier synthesized by idexpr or declname.
+  class SynthesizedIdentifier : public llvm::FastFoldingSetNode {
+  public:
+    SynthesizedIdentifier(const llvm::FoldingSetNodeID &ID, IdentifierInfo *Id)
+      : FastFoldingSetNode(ID), Id(Id) {}
+
+    IdentifierInfo *Id;
+  };
+
+  /// \brief The identifiers synthesized by idexpr and declname, keyed by the
+  /// values of their operands.
+  llvm::FoldingSet<SynthesizedIdentifier> SynthesizedIdentifierCache;
+
+  /// \brief Statistics for the synthesized identifier cache.
+  unsigned NumSynthesizedIdentifiers;
+  unsigned NumSynthesizedIdentifierHits;
+
+  /// \brief The number of calls to the reflection library that were replaced
+  /// by their values.
+  unsigned NumFoldedReflectionQueries;
+
   /// \brief A cache of the flags available in enumerations with the flag_bits
   /// attribute.
   mutable llvm::DenseMap<const EnumDecl*, llvm::APInt> FlagBitsCache;
@@ -2854,6 +2914,20 @@ public:
                                    const UnresolvedSetImpl &Fns,
                                    Expr *LHS, Expr *RHS);
 
+  ExprResult BuildResolvedOverloadedBinOp(SourceLocation OpLoc,
+                                          BinaryOperatorKind Opc,
+                                          MutableArrayRef<Expr *> Args,
+                                          FunctionDecl *FnDecl,
+                                          DeclAccessPair FoundDecl,
+                                          bool HadMultipleCandidates);
+
+  MemoizedOverloadResolution *
+  findMemoizedOverloadResolution(const llvm::FoldingSetNodeID &ID);
+  void memoizeOverloadResolution(const llvm::FoldingSetNodeID &ID,
+                                 unsigned Generation,
+                                 OverloadCandidateSet &CandidateSet,
+                                 OverloadCandidate *Best);
+
   ExprResult CreateOverloadedArraySubscriptExpr(SourceLocation LLoc,
                                                 SourceLocation RLoc,
                                                 Expr *Base,Expr *Idx);
@@ -7429,6 +7503,10 @@ public:
   /// \brief The current injection context. Defined in SemaInject.cpp.
   InjectionContext *CurrentInjectionContext;
 
+  /// \brief The constexpr-declaration whose effects are being applied, if
+  /// any. Injected functions are attributed to it.
+  ConstexprDecl *CurrentMetaprogram;
+
   /// \brief Returns a list of expanded parameters.
   SmallVectorImpl<ParmVarDecl *>* GetInjectedParameterPack(ParmVarDecl *P);
 
@@ -8410,6 +8488,9 @@ public:
 
   ExprResult BuildConstantExpression(Expr *E);
 
+  bool isReflectionQuery(const FunctionDecl *FD);
+  ExprResult BuildReflectionQueryCall(CallExpr *Call);
+
   bool isReflectionType(QualType T);
   ReflectedConstruct EvaluateReflection(QualType T, SourceLocation Loc);
   ReflectedConstruct EvaluateReflection(Expr *E);
@@ -8526,6 +8607,7 @@ public:
   // Source code injection.
   bool ApplyEffects(SourceLocation POI, SmallVectorImpl<EvalEffect> &Injections);
   bool ApplyInjection(SourceLocation POI, InjectionInfo &II);
+  bool ApplyInjectionBatch(SourceLocation POI, InjectionBatch &IB);
   bool InjectFragment(SourceLocation POI, 
                       QualType ReflectionTy, 
                       const APValue &ReflectionVal, 
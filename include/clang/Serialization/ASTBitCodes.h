@@ -607,6 +607,23 @@ namespace clang {
 
       /// \brief Record code for \#pragma pack options.
       PACK_PRAGMA_OPTIONS = 61,
+
+      /// \brief Record code for a zlib-compressed identifier table.
+      ///
+      /// The record holds the bucket offset and the uncompressed size of
+      /// the IDENTIFIER_TABLE blob it replaces. The IDENTIFIER_OFFSET table
+      /// is not compressed; its offsets refer to the uncompressed data.
+      IDENTIFIER_TABLE_COMPRESSED = 62,
+
+      /// \brief The "interesting" identifiers of a compressed identifier
+      /// table, stored uncompressed so that they can be preloaded without
+      /// decompressing the table.
+      ///
+      /// The record holds a (local identifier ID, name length) pair for each
+      /// identifier, and the blob holds their names back to back. It
+      /// replaces INTERESTING_IDENTIFIERS, whose offsets point into the
+      /// table.
+      INTERESTING_IDENTIFIER_NAMES = 63,
     };
 
     /// \brief Record types used within a source manager block.
@@ -1218,7 +1235,10 @@ namespace clang {
       /// \brief A MetaclassDecl record.
       DECL_METACLASS,
       /// \brief A ConstexprDecl record.
-      DECL_CONSTEXPR
+      DECL_CONSTEXPR,
+      /// \brief A zlib-compressed DECL_CONTEXT_VISIBLE record, holding the
+      /// uncompressed size of the lookup table.
+      DECL_CONTEXT_VISIBLE_COMPRESSED
     };
 
     /// \brief Record codes for each kind of statement or expression.
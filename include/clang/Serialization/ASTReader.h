@@ -580,6 +580,13 @@ private:
                                      llvm::BitstreamCursor &Cursor,
                                      uint64_t Offset, serialization::DeclID ID);
 
+  /// \brief Decompress a table written with -fcompress-pch-tables into
+  /// storage owned by \p M.
+  ///
+  /// \returns the uncompressed table, or null if it could not be read.
+  const unsigned char *readCompressedTable(ModuleFile &M, StringRef Blob,
+                                           uint64_t Size);
+
   /// \brief A vector containing identifiers that have already been
   /// loaded.
   ///
@@ -933,6 +940,12 @@ private:
   /// \brief The number of lookups into identifier tables that succeed.
   unsigned NumIdentifierLookupHits = 0;
 
+  /// \brief The number of compressed tables that have been decompressed.
+  unsigned NumTablesDecompressed = 0;
+
+  /// \brief The number of bytes those tables decompressed to.
+  uint64_t NumBytesDecompressed = 0;
+
   /// \brief The number of selectors that have been read.
   unsigned NumSelectorsRead = 0;
 
@@ -1892,6 +1905,12 @@ public:
   /// chain of the identifier.
   IdentifierInfo *get(StringRef Name) override;
 
+  /// \brief Make the identifier table of \p M available, decompressing it if
+  /// this is the first time it is needed.
+  ///
+  /// \returns false if the table could not be read.
+  bool loadIdentifierTable(ModuleFile &M);
+
   /// \brief Retrieve an iterator into the set of all identifiers
   /// in all loaded AST files.
   IdentifierIterator *getIdentifiers() override;
@@ -23,6 +23,7 @@
 #include "clang/Serialization/ModuleFileExtension.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/Bitcode/BitstreamReader.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/Support/Endian.h"
 #include <memory>
 #include <string>
@@ -276,10 +277,28 @@ public:
   /// IdentifierHashTable.
   void *IdentifierLookupTable = nullptr;
 
+  /// \brief The compressed identifier table, if it was written compressed
+  /// and has not been needed yet.
+  StringRef CompressedIdentifierTable;
+
+  /// \brief The uncompressed size and bucket offset of
+  /// CompressedIdentifierTable.
+  uint64_t IdentifierTableSize = 0;
+  uint64_t IdentifierTableBucketOffset = 0;
+
   /// \brief Offsets of identifiers that we're going to preload within
   /// IdentifierTableData.
   std::vector<unsigned> PreloadIdentifierOffsets;
 
+  /// \brief The IDs and names of the identifiers we're going to preload, if
+  /// the identifier table was compressed. Read from the
+  /// INTERESTING_IDENTIFIER_NAMES blob.
+  StringRef PreloadIdentifierNames;
+
+  /// \brief Storage for the tables of this file that were decompressed
+  /// when first used.
+  llvm::BumpPtrAllocator DecompressedTables;
+
   // === Macros ===
 
   /// \brief The cursor to the start of the preprocessor block, which stores
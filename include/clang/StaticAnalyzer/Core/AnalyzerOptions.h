@@ -272,6 +272,18 @@ private:
   /// \sa shouldDisplayNotesAsEvents
   Optional<bool> DisplayNotesAsEvents;
 
+  /// \sa naiveCTUEnabled
+  Optional<bool> NaiveCTU;
+
+  /// \sa getCTUDir
+  Optional<StringRef> CTUDir;
+
+  /// \sa getCTUIndexName
+  Optional<StringRef> CTUIndexName;
+
+  /// \sa getCTUMemoryLimit
+  Optional<unsigned> CTUMemoryLimit;
+
   /// A helper function that retrieves option for a given full-qualified
   /// checker name.
   /// Options for checkers can be specified via 'analyzer-config' command-line
@@ -548,6 +560,36 @@ public:
   /// to false when unset.
   bool shouldDisplayNotesAsEvents();
 
+  /// Returns true if functions without a body in the current translation
+  /// unit should be imported from the AST files listed in the cross
+  /// translation unit index and inlined.
+  ///
+  /// This is controlled by the 'experimental-enable-naive-ctu-analysis'
+  /// option, which defaults to false when unset.
+  bool naiveCTUEnabled();
+
+  /// Returns the directory that holds the AST files of the other translation
+  /// units and their index.
+  ///
+  /// This is controlled by the 'ctu-dir' option, which defaults to the
+  /// empty string when unset.
+  StringRef getCTUDir();
+
+  /// Returns the name of the file, relative to the CTU directory, that maps
+  /// function USRs to the AST files that define them.
+  ///
+  /// This is controlled by the 'ctu-index-name' option, which defaults to
+  /// "externalFnMap.txt" when unset.
+  StringRef getCTUIndexName();
+
+  /// Returns the number of megabytes of AST memory that loaded cross
+  /// translation unit AST files may use before the least recently used ones
+  /// are released, or 0 for no limit.
+  ///
+  /// This is controlled by the 'ctu-memory-limit' option, which defaults to
+  /// 1024 when unset.
+  unsigned getCTUMemoryLimit();
+
 public:
   AnalyzerOptions() :
     AnalysisStoreOpt(RegionStoreModel),
@@ -38,6 +38,10 @@ class CXXThisExpr;
 class MaterializeTemporaryExpr;
 class ObjCAtSynchronizedStmt;
 class ObjCForCollectionStmt;
+
+namespace cross_tu {
+class CrossTranslationUnitContext;
+}
   
 namespace ento {
 
@@ -56,6 +60,8 @@ public:
   };
 
 private:
+  cross_tu::CrossTranslationUnitContext &CTU;
+
   AnalysisManager &AMgr;
   
   AnalysisDeclContextManager &AnalysisDeclContexts;
@@ -97,7 +103,8 @@ private:
   InliningModes HowToInline;
 
 public:
-  ExprEngine(AnalysisManager &mgr, bool gcEnabled,
+  ExprEngine(cross_tu::CrossTranslationUnitContext &CTU, AnalysisManager &mgr,
+             bool gcEnabled,
              SetOfConstDecls *VisitedCalleesIn,
              FunctionSummariesTy *FS,
              InliningModes HowToInlineIn);
@@ -302,6 +309,11 @@ public:
 
   ProgramStateManager& getStateManager() override { return StateMgr; }
 
+  cross_tu::CrossTranslationUnitContext *
+  getCrossTranslationUnitContext() override {
+    return &CTU;
+  }
+
   StoreManager& getStoreManager() { return StateMgr.getStoreManager(); }
 
   ConstraintManager& getConstraintManager() {
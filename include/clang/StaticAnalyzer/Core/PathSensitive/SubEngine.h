@@ -24,6 +24,10 @@ class CFGElement;
 class LocationContext;
 class Stmt;
 
+namespace cross_tu {
+class CrossTranslationUnitContext;
+}
+
 namespace ento {
   
 struct NodeBuilderContext;
@@ -51,6 +55,11 @@ public:
 
   virtual ProgramStateManager &getStateManager() = 0;
 
+  /// Returns the context that imports function definitions from other
+  /// translation units.
+  virtual cross_tu::CrossTranslationUnitContext *
+  getCrossTranslationUnitContext() = 0;
+
   /// Called by CoreEngine. Used to generate new successor
   /// nodes by processing the 'effects' of a block-level statement.
   virtual void processCFGElement(const CFGElement E, ExplodedNode* Pred,
@@ -22,6 +22,7 @@
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/LangOptions.h"
 #include "clang/Basic/SourceLocation.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Error.h"
@@ -36,6 +37,10 @@ namespace clang {
 
 class Rewriter;
 
+namespace vfs {
+class FileSystem;
+}
+
 namespace tooling {
 
 /// \brief A source range independent of the \c SourceManager.
@@ -325,6 +330,31 @@ bool applyAllReplacements(const Replacements &Replaces, Rewriter &Rewrite);
 llvm::Expected<std::string> applyAllReplacements(StringRef Code,
                                                  const Replacements &Replaces);
 
+/// \brief Applies \p Replaces, which must be sorted, to \p Code by copying the
+/// unchanged text and the replacement texts in order.
+///
+/// Conflicts are checked in a single pass over neighbouring replacements,
+/// rather than on every insertion as in \c Replacements::add: identical
+/// replacements are applied once, overlapping deletions and insertions at the
+/// same offset are merged if that does not depend on their order, and any
+/// other overlap is an error. The path stored in each replacement is ignored.
+llvm::Expected<std::string>
+applySortedReplacements(StringRef Code, ArrayRef<Replacement> Replaces);
+
+/// \brief Applies the replacements of many files at once.
+///
+/// Each file in \p FileToReplaces is read from \p FS, which must support
+/// concurrent reads, and rewritten with \c applySortedReplacements on a pool
+/// of \p ThreadCount threads (by default, one per hardware thread). No
+/// \c SourceManager or \c Rewriter is involved, so this scales to change sets
+/// that are too large to go through \c Replacements.
+///
+/// \returns the new contents of every file, or the error of the first file,
+/// in path order, that could not be read or rewritten.
+llvm::Expected<std::map<std::string, std::string>> applyAllReplacementsInBulk(
+    const std::map<std::string, std::vector<Replacement>> &FileToReplaces,
+    vfs::FileSystem &FS, unsigned ThreadCount = 0);
+
 /// \brief Collection of Replacements generated from a single translation unit.
 struct TranslationUnitReplacements {
   /// Name of the main source for the translation unit.
@@ -21,8 +21,6 @@
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/MemoryBuffer.h"
-#include "llvm/Support/SourceMgr.h"
-#include "llvm/Support/YAMLParser.h"
 #include <memory>
 #include <string>
 #include <vector>
@@ -55,6 +53,11 @@ namespace tooling {
 ///
 /// JSON compilation databases can for example be generated in CMake projects
 /// by setting the flag -DCMAKE_EXPORT_COMPILE_COMMANDS.
+///
+/// The database is scanned without building a tree of it: loading only
+/// records where each entry's JSON object is, and the commands of an entry are
+/// parsed when they are asked for. A binary index written next to the
+/// database (see writeIndex()) lets loading skip the scan as well.
 enum class JSONCommandLineSyntax { Windows, Gnu, AutoDetect };
 class JSONCompilationDatabase : public CompilationDatabase {
 public:
@@ -90,32 +93,54 @@ public:
   /// database.
   std::vector<CompileCommand> getAllCompileCommands() const override;
 
+  /// \brief Writes the index of the JSON compilation database in \p FilePath
+  /// to '<FilePath>.idx'.
+  ///
+  /// loadFromFile reads the index instead of scanning the database for as
+  /// long as the size and modification time of the database match the ones
+  /// recorded in it. loadFromFile never writes an index itself; whoever
+  /// generates the database decides whether to index it.
+  ///
+  /// Returns false and sets ErrorMessage if the database could not be loaded
+  /// or the index could not be written.
+  static bool writeIndex(StringRef FilePath, std::string &ErrorMessage,
+                         JSONCommandLineSyntax Syntax);
+
 private:
   /// \brief Constructs a JSON compilation database on a memory buffer.
   JSONCompilationDatabase(std::unique_ptr<llvm::MemoryBuffer> Database,
                           JSONCommandLineSyntax Syntax)
-      : Database(std::move(Database)), Syntax(Syntax),
-        YAMLStream(this->Database->getBuffer(), SM) {}
+      : Database(std::move(Database)), Syntax(Syntax) {}
 
-  /// \brief Parses the database file and creates the index.
+  /// \brief Scans the database and creates the index.
   ///
   /// Returns whether parsing succeeded. Sets ErrorMessage if parsing
   /// failed.
   bool parse(std::string &ErrorMessage);
 
-  // Tuple (directory, filename, commandline, output) where 'commandline'
-  // points to the corresponding scalar nodes in the YAML stream.
-  // If the command line contains a single argument, it is a shell-escaped
-  // command line.
-  // Otherwise, each entry in the command line vector is a literal
-  // argument to the compiler.
-  // The output field may be a nullptr.
-  typedef std::tuple<llvm::yaml::ScalarNode *,
-                     llvm::yaml::ScalarNode *,
-                     std::vector<llvm::yaml::ScalarNode *>,
-                     llvm::yaml::ScalarNode *> CompileCommandRef;
-
-  /// \brief Converts the given array of CompileCommandRefs to CompileCommands.
+  /// \brief Creates the index from the index file at \p IndexPath.
+  ///
+  /// Returns false if the file does not exist, is malformed, or was written
+  /// for a database of a different size or modification time.
+  bool readIndexFile(StringRef IndexPath, uint64_t Size, uint64_t ModTime);
+
+  /// \brief Writes the index to \p IndexPath, recording the size and
+  /// modification time of the database it was created from.
+  bool writeIndexFile(StringRef IndexPath, uint64_t Size, uint64_t ModTime,
+                      std::string &ErrorMessage) const;
+
+  /// \brief Adds the entry for \p FileName compiled in \p Directory, whose
+  /// JSON object is \p Entry, to the index.
+  void addEntry(StringRef Directory, StringRef FileName, StringRef Entry);
+
+  /// \brief The byte range of one entry's JSON object in the database.
+  struct CompileCommandRef {
+    uint64_t Offset;
+    uint32_t Length;
+  };
+
+  /// \brief Parses the JSON objects of the given CompileCommandRefs into
+  /// CompileCommands.
   void getCommands(ArrayRef<CompileCommandRef> CommandsRef,
                    std::vector<CompileCommand> &Commands) const;
 
@@ -130,8 +155,6 @@ private:
 
   std::unique_ptr<llvm::MemoryBuffer> Database;
   JSONCommandLineSyntax Syntax;
-  llvm::SourceMgr SM;
-  llvm::yaml::Stream YAMLStream;
 };
 
 } // end namespace tooling
@@ -752,7 +752,7 @@ ASTContext::ASTContext(LangOptions &LOpts, SourceManager &SM,
       XRayFilter(new XRayFunctionFilter(LangOpts.XRayAlwaysInstrumentFiles,
                                         LangOpts.XRayNeverInstrumentFiles, SM)),
       AddrSpaceMap(nullptr), Target(nullptr), AuxTarget(nullptr),
-      PrintingPolicy(LOpts), Idents(idents), Selectors(sels),
+      PrintingPolicy(LOpts), DeclarationGeneration(0), Idents(idents), Selectors(sels),
       BuiltinInfo(builtins), DeclarationNames(*this), ExternalSource(nullptr),
       Listener(nullptr), Comments(SM), CommentsLoaded(false),
       CommentCommandTraits(BumpAlloc, LOpts.CommentOpts), LastSDM(nullptr, 0) {
@@ -1330,6 +1330,21 @@ void ASTContext::setInstantiatedFromUnnamedFieldDecl(FieldDecl *Inst,
   InstantiatedFromUnnamedFieldDecl[Inst] = Tmpl;
 }
 
+const InjectionOrigin *
+ASTContext::getInjectionOrigin(const FunctionDecl *FD) const {
+  auto Pos = InjectionOrigins.find(FD);
+  if (Pos == InjectionOrigins.end())
+    return nullptr;
+
+  return &Pos->second;
+}
+
+void ASTContext::setInjectionOrigin(const FunctionDecl *FD,
+                                    const InjectionOrigin &O) {
+  assert(O.Source && O.Injectee && "Incomplete injection origin");
+  InjectionOrigins[FD] = O;
+}
+
 ASTContext::overridden_cxx_method_iterator
 ASTContext::overridden_methods_begin(const CXXMethodDecl *Method) const {
   llvm::DenseMap<const CXXMethodDecl *, CXXMethodVector>::const_iterator Pos =
@@ -9211,6 +9226,7 @@ size_t ASTContext::getSideTableAllocatedMemory() const {
          llvm::capacity_in_bytes(InstantiatedFromUsingDecl) +
          llvm::capacity_in_bytes(InstantiatedFromUsingShadowDecl) +
          llvm::capacity_in_bytes(InstantiatedFromUnnamedFieldDecl) +
+         llvm::capacity_in_bytes(InjectionOrigins) +
          llvm::capacity_in_bytes(OverriddenMethods) +
          llvm::capacity_in_bytes(Types) +
          llvm::capacity_in_bytes(VariableArrayTypes) +
@@ -1290,6 +1290,8 @@ void ASTDumper::VisitCXXTupleExpansionStmt(const CXXTupleExpansionStmt *Node) {
   if (Stmt **Iter = Node->begin_instantiated_statements())
     for (; Iter != Node->end_instantiated_statements(); ++Iter)
       dumpStmt(*Iter);
+  if (const Stmt *Rolled = Node->getRolledStatement())
+    dumpStmt(Rolled);
 }
 
 //===----------------------------------------------------------------------===//
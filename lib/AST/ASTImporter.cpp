@@ -1851,6 +1851,7 @@ Decl *ASTNodeImporter::VisitFunctionDecl(FunctionDecl *D) {
 
   // Try to find a function in our own ("to") context with the same name, same
   // type, and in the same context as the function we're importing.
+  FunctionDecl *FoundWithoutBody = nullptr;
   if (!LexicalDC->isFunctionOrMethod()) {
     SmallVector<NamedDecl *, 4> ConflictingDecls;
     unsigned IDNS = Decl::IDNS_Ordinary;
@@ -1865,6 +1866,15 @@ Decl *ASTNodeImporter::VisitFunctionDecl(FunctionDecl *D) {
             D->hasExternalFormalLinkage()) {
           if (Importer.IsStructurallyEquivalent(D->getType(), 
                                                 FoundFunction->getType())) {
+            // A definition of a function that is only declared in the "to"
+            // context is imported as a new redeclaration with its body.
+            const FunctionDecl *FromBodyDecl = nullptr;
+            D->hasBody(FromBodyDecl);
+            if (D == FromBodyDecl && !FoundFunction->hasBody()) {
+              FoundWithoutBody = FoundFunction;
+              break;
+            }
+
             // FIXME: Actually try to merge the body and other attributes.
             return Importer.Imported(D, FoundFunction);
           }
@@ -2009,6 +2019,9 @@ Decl *ASTNodeImporter::VisitFunctionDecl(FunctionDecl *D) {
   ToFunction->setPure(D->isPure());
   Importer.Imported(D, ToFunction);
 
+  if (FoundWithoutBody)
+    ToFunction->setPreviousDecl(FoundWithoutBody->getMostRecentDecl());
+
   // Set the parameters.
   for (unsigned I = 0, N = Parameters.size(); I != N; ++I) {
     Parameters[I]->setOwningFunction(ToFunction);
@@ -0,0 +1,133 @@
+//===--- ASTMemoryReport.cpp - Attribution of AST memory ------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements the ASTMemoryReport class.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/AST/ASTMemoryReport.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclBase.h"
+#include "clang/AST/Stmt.h"
+#include "clang/Basic/SourceManager.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+using namespace clang;
+
+ASTNodeOriginRAII::ASTNodeOriginRAII(const ASTContext &Ctx, ASTNodeOrigin O)
+    : Report(Ctx.getMemoryReport()) {
+  if (Report)
+    Report->pushOrigin(O);
+}
+
+static StringRef getOriginName(ASTNodeOrigin O) {
+  switch (O) {
+  case ASTNodeOrigin::Parsed:
+    return "parsed";
+  case ASTNodeOrigin::Instantiated:
+    return "instantiated";
+  case ASTNodeOrigin::Injected:
+    return "injected";
+  case ASTNodeOrigin::ReflectionSpecialization:
+    return "reflection";
+  case ASTNodeOrigin::Deserialized:
+    return "deserialized";
+  }
+  llvm_unreachable("Invalid ASTNodeOrigin");
+}
+
+static void printQuoted(raw_ostream &OS, StringRef Field) {
+  OS << '"';
+  for (char C : Field) {
+    if (C == '"')
+      OS << '"';
+    OS << C;
+  }
+  OS << '"';
+}
+
+namespace {
+/// \brief The nodes of one kind and origin allocated for one file.
+struct NodeSummary {
+  FileID File;
+  const void *Example;
+  bool IsDecl;
+  ASTNodeOrigin Origin;
+  uint64_t Count;
+  uint64_t Bytes;
+};
+}
+
+void ASTMemoryReport::print(raw_ostream &OS, const ASTContext &Ctx) const {
+  const SourceManager &SM = Ctx.getSourceManager();
+
+  // Keyed by file, node kind, whether the node is a declaration, and origin.
+  typedef std::tuple<unsigned, unsigned, bool, unsigned> SummaryKey;
+  std::map<SummaryKey, NodeSummary> Summaries;
+  uint64_t AttributedBytes = 0;
+  for (const Allocation &A : Allocations) {
+    SourceLocation Loc;
+    unsigned Kind;
+    if (A.IsDecl) {
+      const Decl *D = static_cast<const Decl *>(A.Node);
+      Loc = D->getLocation();
+      Kind = D->getKind();
+    } else {
+      const Stmt *S = static_cast<const Stmt *>(A.Node);
+      Loc = S->getLocStart();
+      Kind = S->getStmtClass();
+    }
+    FileID File;
+    if (Loc.isValid())
+      File = SM.getFileID(SM.getExpansionLoc(Loc));
+
+    SummaryKey Key(File.getHashValue(), Kind, A.IsDecl, unsigned(A.Origin));
+    auto Inserted = Summaries.insert(std::make_pair(
+        Key, NodeSummary{File, A.Node, A.IsDecl, A.Origin, 0, 0}));
+    NodeSummary &Summary = Inserted.first->second;
+    ++Summary.Count;
+    Summary.Bytes += A.Size;
+    AttributedBytes += A.Size;
+  }
+
+  std::vector<const NodeSummary *> Sorted;
+  Sorted.reserve(Summaries.size());
+  for (const auto &Entry : Summaries)
+    Sorted.push_back(&Entry.second);
+  std::stable_sort(Sorted.begin(), Sorted.end(),
+                   [](const NodeSummary *A, const NodeSummary *B) {
+                     return A->Bytes > B->Bytes;
+                   });
+
+  OS << "file,kind,origin,count,bytes\n";
+  for (const NodeSummary *Summary : Sorted) {
+    FileID File = Summary->File;
+    if (File.isValid())
+      printQuoted(OS, SM.getBufferName(SM.getLocForStartOfFile(File)));
+    else
+      printQuoted(OS, "<invalid>");
+    if (Summary->IsDecl)
+      OS << ',' << static_cast<const Decl *>(Summary->Example)->getDeclKindName()
+         << "Decl";
+    else
+      OS << ','
+         << static_cast<const Stmt *>(Summary->Example)->getStmtClassName();
+    OS << ',' << getOriginName(Summary->Origin) << ',' << Summary->Count << ','
+       << Summary->Bytes << '\n';
+  }
+
+  size_t TotalBytes = Ctx.getASTAllocatedMemory();
+  printQuoted(OS, "<other>");
+  OS << ",Other,other,0,"
+     << (TotalBytes > AttributedBytes ? TotalBytes - AttributedBytes : 0)
+     << '\n';
+}
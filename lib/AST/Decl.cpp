@@ -3670,6 +3670,7 @@ void TagDecl::completeDefinition() {
 
   IsCompleteDefinition = true;
   IsBeingDefined = false;
+  getASTContext().bumpDeclarationGeneration();
 
   if (ASTMutationListener *L = getASTMutationListener())
     L->CompletedTagDefinition(this);
@@ -67,6 +67,8 @@ void *Decl::operator new(std::size_t Size, const ASTContext &Context,
   // Store the global declaration ID in the second 4 bytes.
   PrefixPtr[1] = ID;
 
+  if (ASTMemoryReport *Report = Context.getMemoryReport())
+    Report->recordDecl(static_cast<Decl *>(Result), Size + Extra + 8);
   return Result;
 }
 
@@ -85,9 +87,16 @@ void *Decl::operator new(std::size_t Size, const ASTContext &Ctx,
     Buffer += ExtraAlign;
     auto *ParentModule =
         Parent ? cast<Decl>(Parent)->getOwningModule() : nullptr;
-    return new (Buffer) Module*(ParentModule) + 1;
+    void *Result = new (Buffer) Module*(ParentModule) + 1;
+    if (ASTMemoryReport *Report = Ctx.getMemoryReport())
+      Report->recordDecl(static_cast<Decl *>(Result),
+                         ExtraAlign + sizeof(Module *) + Size + Extra);
+    return Result;
   }
-  return ::operator new(Size + Extra, Ctx);
+  void *Result = ::operator new(Size + Extra, Ctx);
+  if (ASTMemoryReport *Report = Ctx.getMemoryReport())
+    Report->recordDecl(static_cast<Decl *>(Result), Size + Extra);
+  return Result;
 }
 
 Module *Decl::getOwningModuleSlow() const {
@@ -1014,6 +1023,25 @@ bool DeclContext::isStdNamespace() const {
   return II && II->isStr("std");
 }
 
+bool DeclContext::isCppxMetaNamespace() const {
+  if (!isNamespace())
+    return false;
+
+  const NamespaceDecl *ND = cast<NamespaceDecl>(this);
+  if (ND->isInline())
+    return ND->getParent()->isCppxMetaNamespace();
+
+  const IdentifierInfo *II = ND->getIdentifier();
+  if (!II || !II->isStr("meta"))
+    return false;
+
+  const auto *Cppx = dyn_cast<NamespaceDecl>(getParent());
+  if (!Cppx || !Cppx->getParent()->getRedeclContext()->isTranslationUnit())
+    return false;
+  II = Cppx->getIdentifier();
+  return II && II->isStr("cppx");
+}
+
 bool DeclContext::isDependentContext() const {
   if (isFileContext())
     return false;
@@ -1731,6 +1759,15 @@ void DeclContext::makeDeclVisibleInContextWithFlags(NamedDecl *D, bool Internal,
   if (shouldBeHidden(D))
     return;
 
+  // New namespace members, and user-written members of complete classes, can
+  // change the result of lookups that have already been performed. Members
+  // that are declared implicitly on demand were there all along.
+  if (isFileContext())
+    getParentASTContext().bumpDeclarationGeneration();
+  else if (auto *Record = dyn_cast<CXXRecordDecl>(this))
+    if (Record->isCompleteDefinition() && !D->isImplicit())
+      getParentASTContext().bumpDeclarationGeneration();
+
   // If we already have a lookup data structure, perform the insertion into
   // it. If we might have externally-stored decls with this name, look them
   // up and perform the insertion. If this decl was declared outside its
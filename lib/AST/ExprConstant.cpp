@@ -4068,11 +4068,26 @@ static EvalStmtResult EvaluateStmt(StmtResult &Result, EvalInfo &Info,
     if (!Evaluate(Result, Info, Reflection))
       return ESR_Failed;
 
-    // Queue the injection as a side effect.
-    Info.EvalStatus.Effects->emplace_back();
-    EvalEffect &Effect = Info.EvalStatus.Effects->back();
+    // Queue the injection as a side effect. Consecutive injections of
+    // fragments are collected into a single batch.
+    SmallVectorImpl<EvalEffect> &Effects = *Info.EvalStatus.Effects;
+    QualType ReflectionTy = Reflection->getType();
+    CXXRecordDecl *Class = ReflectionTy->getAsCXXRecordDecl();
+    if (Class && Class->isFragment()) {
+      if (Effects.empty() || 
+          Effects.back().Kind != EvalEffect::InjectionBatchEffect) {
+        Effects.emplace_back();
+        Effects.back().Kind = EvalEffect::InjectionBatchEffect;
+        Effects.back().Batch = new InjectionBatch();
+      }
+      Effects.back().Batch->add(ReflectionTy, Result);
+      return ESR_Succeeded;
+    }
+
+    Effects.emplace_back();
+    EvalEffect &Effect = Effects.back();
     Effect.Kind = EvalEffect::InjectionEffect;
-    Effect.Injection = new InjectionInfo{Reflection->getType(), Result, QualType()};
+    Effect.Injection = new InjectionInfo{ReflectionTy, Result, QualType()};
     return ESR_Succeeded;
   }
 
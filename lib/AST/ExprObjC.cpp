@@ -39,14 +39,14 @@ ObjCArrayLiteral *ObjCArrayLiteral::Create(const ASTContext &C,
                                            ArrayRef<Expr *> Elements,
                                            QualType T, ObjCMethodDecl *Method,
                                            SourceRange SR) {
-  void *Mem = C.Allocate(totalSizeToAlloc<Expr *>(Elements.size()));
+  void *Mem = allocate(C, totalSizeToAlloc<Expr *>(Elements.size()));
   return new (Mem) ObjCArrayLiteral(Elements, T, Method, SR);
 }
 
 ObjCArrayLiteral *ObjCArrayLiteral::CreateEmpty(const ASTContext &C,
                                                 unsigned NumElements) {
 
-  void *Mem = C.Allocate(totalSizeToAlloc<Expr *>(NumElements));
+  void *Mem = allocate(C, totalSizeToAlloc<Expr *>(NumElements));
   return new (Mem) ObjCArrayLiteral(EmptyShell(), NumElements);
 }
 
@@ -90,7 +90,7 @@ ObjCDictionaryLiteral::Create(const ASTContext &C,
                               ArrayRef<ObjCDictionaryElement> VK,
                               bool HasPackExpansions, QualType T,
                               ObjCMethodDecl *method, SourceRange SR) {
-  void *Mem = C.Allocate(totalSizeToAlloc<KeyValuePair, ExpansionData>(
+  void *Mem = allocate(C, totalSizeToAlloc<KeyValuePair, ExpansionData>(
       VK.size(), HasPackExpansions ? VK.size() : 0));
   return new (Mem) ObjCDictionaryLiteral(VK, HasPackExpansions, T, method, SR);
 }
@@ -98,7 +98,7 @@ ObjCDictionaryLiteral::Create(const ASTContext &C,
 ObjCDictionaryLiteral *
 ObjCDictionaryLiteral::CreateEmpty(const ASTContext &C, unsigned NumElements,
                                    bool HasPackExpansions) {
-  void *Mem = C.Allocate(totalSizeToAlloc<KeyValuePair, ExpansionData>(
+  void *Mem = allocate(C, totalSizeToAlloc<KeyValuePair, ExpansionData>(
       NumElements, HasPackExpansions ? NumElements : 0));
   return new (Mem)
       ObjCDictionaryLiteral(EmptyShell(), NumElements, HasPackExpansions);
@@ -276,7 +276,7 @@ ObjCMessageExpr *ObjCMessageExpr::alloc(const ASTContext &C,
 
 ObjCMessageExpr *ObjCMessageExpr::alloc(const ASTContext &C, unsigned NumArgs,
                                         unsigned NumStoredSelLocs) {
-  return (ObjCMessageExpr *)C.Allocate(
+  return (ObjCMessageExpr *)allocate(C,
       totalSizeToAlloc<void *, SourceLocation>(NumArgs + 1, NumStoredSelLocs),
       alignof(ObjCMessageExpr));
 }
@@ -52,7 +52,14 @@ static StmtClassNameTable &getStmtInfoTableEntry(Stmt::StmtClass E) {
 
 void *Stmt::operator new(size_t bytes, const ASTContext& C,
                          unsigned alignment) {
-  return ::operator new(bytes, C, alignment);
+  return allocate(C, bytes, alignment);
+}
+
+void *Stmt::allocate(const ASTContext &C, size_t bytes, unsigned alignment) {
+  void *Mem = ::operator new(bytes, C, alignment);
+  if (ASTMemoryReport *Report = C.getMemoryReport())
+    Report->recordStmt(static_cast<Stmt *>(Mem), bytes);
+  return Mem;
 }
 
 const char *Stmt::getStmtClassName() const {
@@ -314,16 +321,17 @@ AttributedStmt *AttributedStmt::Create(const ASTContext &C, SourceLocation Loc,
                                        ArrayRef<const Attr*> Attrs,
                                        Stmt *SubStmt) {
   assert(!Attrs.empty() && "Attrs should not be empty");
-  void *Mem = C.Allocate(sizeof(AttributedStmt) + sizeof(Attr *) * Attrs.size(),
-                         alignof(AttributedStmt));
+  void *Mem = allocate(C,
+                       sizeof(AttributedStmt) + sizeof(Attr *) * Attrs.size(),
+                       alignof(AttributedStmt));
   return new (Mem) AttributedStmt(Loc, Attrs, SubStmt);
 }
 
 AttributedStmt *AttributedStmt::CreateEmpty(const ASTContext &C,
                                             unsigned NumAttrs) {
   assert(NumAttrs > 0 && "NumAttrs should be greater than zero");
-  void *Mem = C.Allocate(sizeof(AttributedStmt) + sizeof(Attr *) * NumAttrs,
-                         alignof(AttributedStmt));
+  void *Mem = allocate(C, sizeof(AttributedStmt) + sizeof(Attr *) * NumAttrs,
+                       alignof(AttributedStmt));
   return new (Mem) AttributedStmt(EmptyShell(), NumAttrs);
 }
 
@@ -1065,7 +1073,7 @@ CapturedStmt *CapturedStmt::Create(const ASTContext &Context, Stmt *S,
     Size += sizeof(Capture) * Captures.size();
   }
 
-  void *Mem = Context.Allocate(Size);
+  void *Mem = allocate(Context, Size);
   return new (Mem) CapturedStmt(S, Kind, Captures, CaptureInits, CD, RD);
 }
 
@@ -1078,7 +1086,7 @@ CapturedStmt *CapturedStmt::CreateDeserialized(const ASTContext &Context,
     Size += sizeof(Capture) * NumCaptures;
   }
 
-  void *Mem = Context.Allocate(Size);
+  void *Mem = allocate(Context, Size);
   return new (Mem) CapturedStmt(EmptyShell(), NumCaptures);
 }
 
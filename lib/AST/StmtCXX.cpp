@@ -29,7 +29,7 @@ CXXTryStmt *CXXTryStmt::Create(const ASTContext &C, SourceLocation tryLoc,
   std::size_t Size = sizeof(CXXTryStmt);
   Size += ((handlers.size() + 1) * sizeof(Stmt *));
 
-  void *Mem = C.Allocate(Size, alignof(CXXTryStmt));
+  void *Mem = allocate(C, Size, alignof(CXXTryStmt));
   return new (Mem) CXXTryStmt(tryLoc, tryBlock, handlers);
 }
 
@@ -38,7 +38,7 @@ CXXTryStmt *CXXTryStmt::Create(const ASTContext &C, EmptyShell Empty,
   std::size_t Size = sizeof(CXXTryStmt);
   Size += ((numHandlers + 1) * sizeof(Stmt *));
 
-  void *Mem = C.Allocate(Size, alignof(CXXTryStmt));
+  void *Mem = allocate(C, Size, alignof(CXXTryStmt));
   return new (Mem) CXXTryStmt(Empty, numHandlers);
 }
 
@@ -121,7 +121,7 @@ CXXTupleExpansionStmt::CXXTupleExpansionStmt(
     SourceLocation CL, SourceLocation RPL)
     : CXXExpansionStmt(CXXTupleExpansionStmtClass, RangeVar, LoopVar, Body, N,
                        FL, EL, CL, RPL),
-      Parms(TP) {}
+      Parms(TP), RolledStmt(nullptr) {}
 
 NonTypeTemplateParmDecl *CXXTupleExpansionStmt::getPlaceholderParameter() {
   return cast<NonTypeTemplateParmDecl>(Parms->getParam(0));
@@ -151,7 +151,7 @@ CoroutineBodyStmt *CoroutineBodyStmt::Create(
   std::size_t Size = totalSizeToAlloc<Stmt *>(
       CoroutineBodyStmt::FirstParamMove + Args.ParamMoves.size());
 
-  void *Mem = C.Allocate(Size, alignof(CoroutineBodyStmt));
+  void *Mem = allocate(C, Size, alignof(CoroutineBodyStmt));
   return new (Mem) CoroutineBodyStmt(Args);
 }
 
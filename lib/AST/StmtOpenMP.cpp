@@ -60,7 +60,7 @@ OMPParallelDirective *OMPParallelDirective::Create(
   unsigned Size =
       llvm::alignTo(sizeof(OMPParallelDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
   OMPParallelDirective *Dir =
       new (Mem) OMPParallelDirective(StartLoc, EndLoc, Clauses.size());
   Dir->setClauses(Clauses);
@@ -75,7 +75,7 @@ OMPParallelDirective *OMPParallelDirective::CreateEmpty(const ASTContext &C,
   unsigned Size =
       llvm::alignTo(sizeof(OMPParallelDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
   return new (Mem) OMPParallelDirective(NumClauses);
 }
 
@@ -86,8 +86,8 @@ OMPSimdDirective::Create(const ASTContext &C, SourceLocation StartLoc,
                          const HelperExprs &Exprs) {
   unsigned Size = llvm::alignTo(sizeof(OMPSimdDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() +
-                 sizeof(Stmt *) * numLoopChildren(CollapsedNum, OMPD_simd));
+      allocate(C, Size + sizeof(OMPClause *) * Clauses.size() +
+                  sizeof(Stmt *) * numLoopChildren(CollapsedNum, OMPD_simd));
   OMPSimdDirective *Dir = new (Mem)
       OMPSimdDirective(StartLoc, EndLoc, CollapsedNum, Clauses.size());
   Dir->setClauses(Clauses);
@@ -114,8 +114,8 @@ OMPSimdDirective *OMPSimdDirective::CreateEmpty(const ASTContext &C,
                                                 EmptyShell) {
   unsigned Size = llvm::alignTo(sizeof(OMPSimdDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * NumClauses +
-                 sizeof(Stmt *) * numLoopChildren(CollapsedNum, OMPD_simd));
+      allocate(C, Size + sizeof(OMPClause *) * NumClauses +
+                  sizeof(Stmt *) * numLoopChildren(CollapsedNum, OMPD_simd));
   return new (Mem) OMPSimdDirective(CollapsedNum, NumClauses);
 }
 
@@ -126,8 +126,8 @@ OMPForDirective::Create(const ASTContext &C, SourceLocation StartLoc,
                         const HelperExprs &Exprs, bool HasCancel) {
   unsigned Size = llvm::alignTo(sizeof(OMPForDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() +
-                 sizeof(Stmt *) * numLoopChildren(CollapsedNum, OMPD_for));
+      allocate(C, Size + sizeof(OMPClause *) * Clauses.size() +
+                  sizeof(Stmt *) * numLoopChildren(CollapsedNum, OMPD_for));
   OMPForDirective *Dir =
       new (Mem) OMPForDirective(StartLoc, EndLoc, CollapsedNum, Clauses.size());
   Dir->setClauses(Clauses);
@@ -163,8 +163,8 @@ OMPForDirective *OMPForDirective::CreateEmpty(const ASTContext &C,
                                               EmptyShell) {
   unsigned Size = llvm::alignTo(sizeof(OMPForDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * NumClauses +
-                 sizeof(Stmt *) * numLoopChildren(CollapsedNum, OMPD_for));
+      allocate(C, Size + sizeof(OMPClause *) * NumClauses +
+                  sizeof(Stmt *) * numLoopChildren(CollapsedNum, OMPD_for));
   return new (Mem) OMPForDirective(CollapsedNum, NumClauses);
 }
 
@@ -176,8 +176,9 @@ OMPForSimdDirective::Create(const ASTContext &C, SourceLocation StartLoc,
   unsigned Size =
       llvm::alignTo(sizeof(OMPForSimdDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() +
-                 sizeof(Stmt *) * numLoopChildren(CollapsedNum, OMPD_for_simd));
+      allocate(C, Size + sizeof(OMPClause *) * Clauses.size() +
+                  sizeof(Stmt *) *
+                      numLoopChildren(CollapsedNum, OMPD_for_simd));
   OMPForSimdDirective *Dir = new (Mem)
       OMPForSimdDirective(StartLoc, EndLoc, CollapsedNum, Clauses.size());
   Dir->setClauses(Clauses);
@@ -213,8 +214,9 @@ OMPForSimdDirective *OMPForSimdDirective::CreateEmpty(const ASTContext &C,
   unsigned Size =
       llvm::alignTo(sizeof(OMPForSimdDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * NumClauses +
-                 sizeof(Stmt *) * numLoopChildren(CollapsedNum, OMPD_for_simd));
+      allocate(C, Size + sizeof(OMPClause *) * NumClauses +
+                  sizeof(Stmt *) *
+                      numLoopChildren(CollapsedNum, OMPD_for_simd));
   return new (Mem) OMPForSimdDirective(CollapsedNum, NumClauses);
 }
 
@@ -224,7 +226,7 @@ OMPSectionsDirective *OMPSectionsDirective::Create(
   unsigned Size =
       llvm::alignTo(sizeof(OMPSectionsDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
   OMPSectionsDirective *Dir =
       new (Mem) OMPSectionsDirective(StartLoc, EndLoc, Clauses.size());
   Dir->setClauses(Clauses);
@@ -239,7 +241,7 @@ OMPSectionsDirective *OMPSectionsDirective::CreateEmpty(const ASTContext &C,
   unsigned Size =
       llvm::alignTo(sizeof(OMPSectionsDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
   return new (Mem) OMPSectionsDirective(NumClauses);
 }
 
@@ -249,7 +251,7 @@ OMPSectionDirective *OMPSectionDirective::Create(const ASTContext &C,
                                                  Stmt *AssociatedStmt,
                                                  bool HasCancel) {
   unsigned Size = llvm::alignTo(sizeof(OMPSectionDirective), alignof(Stmt *));
-  void *Mem = C.Allocate(Size + sizeof(Stmt *));
+  void *Mem = allocate(C, Size + sizeof(Stmt *));
   OMPSectionDirective *Dir = new (Mem) OMPSectionDirective(StartLoc, EndLoc);
   Dir->setAssociatedStmt(AssociatedStmt);
   Dir->setHasCancel(HasCancel);
@@ -259,7 +261,7 @@ OMPSectionDirective *OMPSectionDirective::Create(const ASTContext &C,
 OMPSectionDirective *OMPSectionDirective::CreateEmpty(const ASTContext &C,
                                                       EmptyShell) {
   unsigned Size = llvm::alignTo(sizeof(OMPSectionDirective), alignof(Stmt *));
-  void *Mem = C.Allocate(Size + sizeof(Stmt *));
+  void *Mem = allocate(C, Size + sizeof(Stmt *));
   return new (Mem) OMPSectionDirective();
 }
 
@@ -271,7 +273,7 @@ OMPSingleDirective *OMPSingleDirective::Create(const ASTContext &C,
   unsigned Size =
       llvm::alignTo(sizeof(OMPSingleDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
   OMPSingleDirective *Dir =
       new (Mem) OMPSingleDirective(StartLoc, EndLoc, Clauses.size());
   Dir->setClauses(Clauses);
@@ -285,7 +287,7 @@ OMPSingleDirective *OMPSingleDirective::CreateEmpty(const ASTContext &C,
   unsigned Size =
       llvm::alignTo(sizeof(OMPSingleDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
   return new (Mem) OMPSingleDirective(NumClauses);
 }
 
@@ -294,7 +296,7 @@ OMPMasterDirective *OMPMasterDirective::Create(const ASTContext &C,
                                                SourceLocation EndLoc,
                                                Stmt *AssociatedStmt) {
   unsigned Size = llvm::alignTo(sizeof(OMPMasterDirective), alignof(Stmt *));
-  void *Mem = C.Allocate(Size + sizeof(Stmt *));
+  void *Mem = allocate(C, Size + sizeof(Stmt *));
   OMPMasterDirective *Dir = new (Mem) OMPMasterDirective(StartLoc, EndLoc);
   Dir->setAssociatedStmt(AssociatedStmt);
   return Dir;
@@ -303,7 +305,7 @@ OMPMasterDirective *OMPMasterDirective::Create(const ASTContext &C,
 OMPMasterDirective *OMPMasterDirective::CreateEmpty(const ASTContext &C,
                                                     EmptyShell) {
   unsigned Size = llvm::alignTo(sizeof(OMPMasterDirective), alignof(Stmt *));
-  void *Mem = C.Allocate(Size + sizeof(Stmt *));
+  void *Mem = allocate(C, Size + sizeof(Stmt *));
   return new (Mem) OMPMasterDirective();
 }
 
@@ -314,7 +316,7 @@ OMPCriticalDirective *OMPCriticalDirective::Create(
   unsigned Size =
       llvm::alignTo(sizeof(OMPCriticalDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
   OMPCriticalDirective *Dir =
       new (Mem) OMPCriticalDirective(Name, StartLoc, EndLoc, Clauses.size());
   Dir->setClauses(Clauses);
@@ -328,7 +330,7 @@ OMPCriticalDirective *OMPCriticalDirective::CreateEmpty(const ASTContext &C,
   unsigned Size =
       llvm::alignTo(sizeof(OMPCriticalDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
   return new (Mem) OMPCriticalDirective(NumClauses);
 }
 
@@ -338,8 +340,8 @@ OMPParallelForDirective *OMPParallelForDirective::Create(
     const HelperExprs &Exprs, bool HasCancel) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPParallelForDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() +
-                         sizeof(Stmt *) *
+  void *Mem = allocate(C, Size + sizeof(OMPClause *) * Clauses.size() +
+                          sizeof(Stmt *) *
                              numLoopChildren(CollapsedNum, OMPD_parallel_for));
   OMPParallelForDirective *Dir = new (Mem)
       OMPParallelForDirective(StartLoc, EndLoc, CollapsedNum, Clauses.size());
@@ -375,8 +377,8 @@ OMPParallelForDirective::CreateEmpty(const ASTContext &C, unsigned NumClauses,
                                      unsigned CollapsedNum, EmptyShell) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPParallelForDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(Size + sizeof(OMPClause *) * NumClauses +
-                         sizeof(Stmt *) *
+  void *Mem = allocate(C, Size + sizeof(OMPClause *) * NumClauses +
+                          sizeof(Stmt *) *
                              numLoopChildren(CollapsedNum, OMPD_parallel_for));
   return new (Mem) OMPParallelForDirective(CollapsedNum, NumClauses);
 }
@@ -387,7 +389,7 @@ OMPParallelForSimdDirective *OMPParallelForSimdDirective::Create(
     const HelperExprs &Exprs) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPParallelForSimdDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * Clauses.size() +
       sizeof(Stmt *) * numLoopChildren(CollapsedNum, OMPD_parallel_for_simd));
   OMPParallelForSimdDirective *Dir = new (Mem) OMPParallelForSimdDirective(
@@ -424,7 +426,7 @@ OMPParallelForSimdDirective::CreateEmpty(const ASTContext &C,
                                          unsigned CollapsedNum, EmptyShell) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPParallelForSimdDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * NumClauses +
       sizeof(Stmt *) * numLoopChildren(CollapsedNum, OMPD_parallel_for_simd));
   return new (Mem) OMPParallelForSimdDirective(CollapsedNum, NumClauses);
@@ -436,7 +438,7 @@ OMPParallelSectionsDirective *OMPParallelSectionsDirective::Create(
   unsigned Size =
       llvm::alignTo(sizeof(OMPParallelSectionsDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
   OMPParallelSectionsDirective *Dir =
       new (Mem) OMPParallelSectionsDirective(StartLoc, EndLoc, Clauses.size());
   Dir->setClauses(Clauses);
@@ -451,7 +453,7 @@ OMPParallelSectionsDirective::CreateEmpty(const ASTContext &C,
   unsigned Size =
       llvm::alignTo(sizeof(OMPParallelSectionsDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
   return new (Mem) OMPParallelSectionsDirective(NumClauses);
 }
 
@@ -461,7 +463,7 @@ OMPTaskDirective::Create(const ASTContext &C, SourceLocation StartLoc,
                          Stmt *AssociatedStmt, bool HasCancel) {
   unsigned Size = llvm::alignTo(sizeof(OMPTaskDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
   OMPTaskDirective *Dir =
       new (Mem) OMPTaskDirective(StartLoc, EndLoc, Clauses.size());
   Dir->setClauses(Clauses);
@@ -475,14 +477,14 @@ OMPTaskDirective *OMPTaskDirective::CreateEmpty(const ASTContext &C,
                                                 EmptyShell) {
   unsigned Size = llvm::alignTo(sizeof(OMPTaskDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
   return new (Mem) OMPTaskDirective(NumClauses);
 }
 
 OMPTaskyieldDirective *OMPTaskyieldDirective::Create(const ASTContext &C,
                                                      SourceLocation StartLoc,
                                                      SourceLocation EndLoc) {
-  void *Mem = C.Allocate(sizeof(OMPTaskyieldDirective));
+  void *Mem = allocate(C, sizeof(OMPTaskyieldDirective));
   OMPTaskyieldDirective *Dir =
       new (Mem) OMPTaskyieldDirective(StartLoc, EndLoc);
   return Dir;
@@ -490,35 +492,35 @@ OMPTaskyieldDirective *OMPTaskyieldDirective::Create(const ASTContext &C,
 
 OMPTaskyieldDirective *OMPTaskyieldDirective::CreateEmpty(const ASTContext &C,
                                                           EmptyShell) {
-  void *Mem = C.Allocate(sizeof(OMPTaskyieldDirective));
+  void *Mem = allocate(C, sizeof(OMPTaskyieldDirective));
   return new (Mem) OMPTaskyieldDirective();
 }
 
 OMPBarrierDirective *OMPBarrierDirective::Create(const ASTContext &C,
                                                  SourceLocation StartLoc,
                                                  SourceLocation EndLoc) {
-  void *Mem = C.Allocate(sizeof(OMPBarrierDirective));
+  void *Mem = allocate(C, sizeof(OMPBarrierDirective));
   OMPBarrierDirective *Dir = new (Mem) OMPBarrierDirective(StartLoc, EndLoc);
   return Dir;
 }
 
 OMPBarrierDirective *OMPBarrierDirective::CreateEmpty(const ASTContext &C,
                                                       EmptyShell) {
-  void *Mem = C.Allocate(sizeof(OMPBarrierDirective));
+  void *Mem = allocate(C, sizeof(OMPBarrierDirective));
   return new (Mem) OMPBarrierDirective();
 }
 
 OMPTaskwaitDirective *OMPTaskwaitDirective::Create(const ASTContext &C,
                                                    SourceLocation StartLoc,
                                                    SourceLocation EndLoc) {
-  void *Mem = C.Allocate(sizeof(OMPTaskwaitDirective));
+  void *Mem = allocate(C, sizeof(OMPTaskwaitDirective));
   OMPTaskwaitDirective *Dir = new (Mem) OMPTaskwaitDirective(StartLoc, EndLoc);
   return Dir;
 }
 
 OMPTaskwaitDirective *OMPTaskwaitDirective::CreateEmpty(const ASTContext &C,
                                                         EmptyShell) {
-  void *Mem = C.Allocate(sizeof(OMPTaskwaitDirective));
+  void *Mem = allocate(C, sizeof(OMPTaskwaitDirective));
   return new (Mem) OMPTaskwaitDirective();
 }
 
@@ -527,7 +529,7 @@ OMPTaskgroupDirective *OMPTaskgroupDirective::Create(const ASTContext &C,
                                                      SourceLocation EndLoc,
                                                      Stmt *AssociatedStmt) {
   unsigned Size = llvm::alignTo(sizeof(OMPTaskgroupDirective), alignof(Stmt *));
-  void *Mem = C.Allocate(Size + sizeof(Stmt *));
+  void *Mem = allocate(C, Size + sizeof(Stmt *));
   OMPTaskgroupDirective *Dir =
       new (Mem) OMPTaskgroupDirective(StartLoc, EndLoc);
   Dir->setAssociatedStmt(AssociatedStmt);
@@ -537,7 +539,7 @@ OMPTaskgroupDirective *OMPTaskgroupDirective::Create(const ASTContext &C,
 OMPTaskgroupDirective *OMPTaskgroupDirective::CreateEmpty(const ASTContext &C,
                                                           EmptyShell) {
   unsigned Size = llvm::alignTo(sizeof(OMPTaskgroupDirective), alignof(Stmt *));
-  void *Mem = C.Allocate(Size + sizeof(Stmt *));
+  void *Mem = allocate(C, Size + sizeof(Stmt *));
   return new (Mem) OMPTaskgroupDirective();
 }
 
@@ -546,7 +548,7 @@ OMPCancellationPointDirective *OMPCancellationPointDirective::Create(
     OpenMPDirectiveKind CancelRegion) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPCancellationPointDirective), alignof(Stmt *));
-  void *Mem = C.Allocate(Size);
+  void *Mem = allocate(C, Size);
   OMPCancellationPointDirective *Dir =
       new (Mem) OMPCancellationPointDirective(StartLoc, EndLoc);
   Dir->setCancelRegion(CancelRegion);
@@ -557,7 +559,7 @@ OMPCancellationPointDirective *
 OMPCancellationPointDirective::CreateEmpty(const ASTContext &C, EmptyShell) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPCancellationPointDirective), alignof(Stmt *));
-  void *Mem = C.Allocate(Size);
+  void *Mem = allocate(C, Size);
   return new (Mem) OMPCancellationPointDirective();
 }
 
@@ -568,7 +570,7 @@ OMPCancelDirective::Create(const ASTContext &C, SourceLocation StartLoc,
   unsigned Size = llvm::alignTo(sizeof(OMPCancelDirective) +
                                     sizeof(OMPClause *) * Clauses.size(),
                                 alignof(Stmt *));
-  void *Mem = C.Allocate(Size);
+  void *Mem = allocate(C, Size);
   OMPCancelDirective *Dir =
       new (Mem) OMPCancelDirective(StartLoc, EndLoc, Clauses.size());
   Dir->setClauses(Clauses);
@@ -582,7 +584,7 @@ OMPCancelDirective *OMPCancelDirective::CreateEmpty(const ASTContext &C,
   unsigned Size = llvm::alignTo(sizeof(OMPCancelDirective) +
                                     sizeof(OMPClause *) * NumClauses,
                                 alignof(Stmt *));
-  void *Mem = C.Allocate(Size);
+  void *Mem = allocate(C, Size);
   return new (Mem) OMPCancelDirective(NumClauses);
 }
 
@@ -592,7 +594,7 @@ OMPFlushDirective *OMPFlushDirective::Create(const ASTContext &C,
                                              ArrayRef<OMPClause *> Clauses) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPFlushDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(Size + sizeof(OMPClause *) * Clauses.size());
+  void *Mem = allocate(C, Size + sizeof(OMPClause *) * Clauses.size());
   OMPFlushDirective *Dir =
       new (Mem) OMPFlushDirective(StartLoc, EndLoc, Clauses.size());
   Dir->setClauses(Clauses);
@@ -604,7 +606,7 @@ OMPFlushDirective *OMPFlushDirective::CreateEmpty(const ASTContext &C,
                                                   EmptyShell) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPFlushDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(Size + sizeof(OMPClause *) * NumClauses);
+  void *Mem = allocate(C, Size + sizeof(OMPClause *) * NumClauses);
   return new (Mem) OMPFlushDirective(NumClauses);
 }
 
@@ -616,7 +618,7 @@ OMPOrderedDirective *OMPOrderedDirective::Create(const ASTContext &C,
   unsigned Size =
       llvm::alignTo(sizeof(OMPOrderedDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(Stmt *) + sizeof(OMPClause *) * Clauses.size());
+      allocate(C, Size + sizeof(Stmt *) + sizeof(OMPClause *) * Clauses.size());
   OMPOrderedDirective *Dir =
       new (Mem) OMPOrderedDirective(StartLoc, EndLoc, Clauses.size());
   Dir->setClauses(Clauses);
@@ -630,7 +632,7 @@ OMPOrderedDirective *OMPOrderedDirective::CreateEmpty(const ASTContext &C,
   unsigned Size =
       llvm::alignTo(sizeof(OMPOrderedDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(Stmt *) + sizeof(OMPClause *) * NumClauses);
+      allocate(C, Size + sizeof(Stmt *) + sizeof(OMPClause *) * NumClauses);
   return new (Mem) OMPOrderedDirective(NumClauses);
 }
 
@@ -640,8 +642,8 @@ OMPAtomicDirective *OMPAtomicDirective::Create(
     Expr *E, Expr *UE, bool IsXLHSInRHSPart, bool IsPostfixUpdate) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPAtomicDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() +
-                         5 * sizeof(Stmt *));
+  void *Mem = allocate(C, Size + sizeof(OMPClause *) * Clauses.size() +
+                          5 * sizeof(Stmt *));
   OMPAtomicDirective *Dir =
       new (Mem) OMPAtomicDirective(StartLoc, EndLoc, Clauses.size());
   Dir->setClauses(Clauses);
@@ -661,7 +663,7 @@ OMPAtomicDirective *OMPAtomicDirective::CreateEmpty(const ASTContext &C,
   unsigned Size =
       llvm::alignTo(sizeof(OMPAtomicDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * NumClauses + 5 * sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * NumClauses + 5 * sizeof(Stmt *));
   return new (Mem) OMPAtomicDirective(NumClauses);
 }
 
@@ -673,7 +675,7 @@ OMPTargetDirective *OMPTargetDirective::Create(const ASTContext &C,
   unsigned Size =
       llvm::alignTo(sizeof(OMPTargetDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
   OMPTargetDirective *Dir =
       new (Mem) OMPTargetDirective(StartLoc, EndLoc, Clauses.size());
   Dir->setClauses(Clauses);
@@ -687,7 +689,7 @@ OMPTargetDirective *OMPTargetDirective::CreateEmpty(const ASTContext &C,
   unsigned Size =
       llvm::alignTo(sizeof(OMPTargetDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
   return new (Mem) OMPTargetDirective(NumClauses);
 }
 
@@ -697,7 +699,7 @@ OMPTargetParallelDirective *OMPTargetParallelDirective::Create(
   unsigned Size =
       llvm::alignTo(sizeof(OMPTargetParallelDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
   OMPTargetParallelDirective *Dir =
       new (Mem) OMPTargetParallelDirective(StartLoc, EndLoc, Clauses.size());
   Dir->setClauses(Clauses);
@@ -711,7 +713,7 @@ OMPTargetParallelDirective::CreateEmpty(const ASTContext &C,
   unsigned Size =
       llvm::alignTo(sizeof(OMPTargetParallelDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
   return new (Mem) OMPTargetParallelDirective(NumClauses);
 }
 
@@ -721,7 +723,7 @@ OMPTargetParallelForDirective *OMPTargetParallelForDirective::Create(
     const HelperExprs &Exprs, bool HasCancel) {
   unsigned Size = llvm::alignTo(sizeof(OMPTargetParallelForDirective),
                                 alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * Clauses.size() +
       sizeof(Stmt *) * numLoopChildren(CollapsedNum, OMPD_target_parallel_for));
   OMPTargetParallelForDirective *Dir = new (Mem) OMPTargetParallelForDirective(
@@ -759,7 +761,7 @@ OMPTargetParallelForDirective::CreateEmpty(const ASTContext &C,
                                            unsigned CollapsedNum, EmptyShell) {
   unsigned Size = llvm::alignTo(sizeof(OMPTargetParallelForDirective),
                                 alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * NumClauses +
       sizeof(Stmt *) * numLoopChildren(CollapsedNum, OMPD_target_parallel_for));
   return new (Mem) OMPTargetParallelForDirective(CollapsedNum, NumClauses);
@@ -768,7 +770,7 @@ OMPTargetParallelForDirective::CreateEmpty(const ASTContext &C,
 OMPTargetDataDirective *OMPTargetDataDirective::Create(
     const ASTContext &C, SourceLocation StartLoc, SourceLocation EndLoc,
     ArrayRef<OMPClause *> Clauses, Stmt *AssociatedStmt) {
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       llvm::alignTo(sizeof(OMPTargetDataDirective), alignof(OMPClause *)) +
       sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
   OMPTargetDataDirective *Dir =
@@ -781,7 +783,7 @@ OMPTargetDataDirective *OMPTargetDataDirective::Create(
 OMPTargetDataDirective *OMPTargetDataDirective::CreateEmpty(const ASTContext &C,
                                                             unsigned N,
                                                             EmptyShell) {
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       llvm::alignTo(sizeof(OMPTargetDataDirective), alignof(OMPClause *)) +
       sizeof(OMPClause *) * N + sizeof(Stmt *));
   return new (Mem) OMPTargetDataDirective(N);
@@ -790,7 +792,7 @@ OMPTargetDataDirective *OMPTargetDataDirective::CreateEmpty(const ASTContext &C,
 OMPTargetEnterDataDirective *OMPTargetEnterDataDirective::Create(
     const ASTContext &C, SourceLocation StartLoc, SourceLocation EndLoc,
     ArrayRef<OMPClause *> Clauses) {
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       llvm::alignTo(sizeof(OMPTargetEnterDataDirective), alignof(OMPClause *)) +
       sizeof(OMPClause *) * Clauses.size());
   OMPTargetEnterDataDirective *Dir =
@@ -802,7 +804,7 @@ OMPTargetEnterDataDirective *OMPTargetEnterDataDirective::Create(
 OMPTargetEnterDataDirective *
 OMPTargetEnterDataDirective::CreateEmpty(const ASTContext &C, unsigned N,
                                          EmptyShell) {
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       llvm::alignTo(sizeof(OMPTargetEnterDataDirective), alignof(OMPClause *)) +
       sizeof(OMPClause *) * N);
   return new (Mem) OMPTargetEnterDataDirective(N);
@@ -812,7 +814,7 @@ OMPTargetExitDataDirective *
 OMPTargetExitDataDirective::Create(const ASTContext &C, SourceLocation StartLoc,
                                    SourceLocation EndLoc,
                                    ArrayRef<OMPClause *> Clauses) {
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       llvm::alignTo(sizeof(OMPTargetExitDataDirective), alignof(OMPClause *)) +
       sizeof(OMPClause *) * Clauses.size());
   OMPTargetExitDataDirective *Dir =
@@ -824,7 +826,7 @@ OMPTargetExitDataDirective::Create(const ASTContext &C, SourceLocation StartLoc,
 OMPTargetExitDataDirective *
 OMPTargetExitDataDirective::CreateEmpty(const ASTContext &C, unsigned N,
                                         EmptyShell) {
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       llvm::alignTo(sizeof(OMPTargetExitDataDirective), alignof(OMPClause *)) +
       sizeof(OMPClause *) * N);
   return new (Mem) OMPTargetExitDataDirective(N);
@@ -838,7 +840,7 @@ OMPTeamsDirective *OMPTeamsDirective::Create(const ASTContext &C,
   unsigned Size =
       llvm::alignTo(sizeof(OMPTeamsDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
   OMPTeamsDirective *Dir =
       new (Mem) OMPTeamsDirective(StartLoc, EndLoc, Clauses.size());
   Dir->setClauses(Clauses);
@@ -852,7 +854,7 @@ OMPTeamsDirective *OMPTeamsDirective::CreateEmpty(const ASTContext &C,
   unsigned Size =
       llvm::alignTo(sizeof(OMPTeamsDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
   return new (Mem) OMPTeamsDirective(NumClauses);
 }
 
@@ -863,8 +865,9 @@ OMPTaskLoopDirective *OMPTaskLoopDirective::Create(
   unsigned Size =
       llvm::alignTo(sizeof(OMPTaskLoopDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() +
-                 sizeof(Stmt *) * numLoopChildren(CollapsedNum, OMPD_taskloop));
+      allocate(C, Size + sizeof(OMPClause *) * Clauses.size() +
+                  sizeof(Stmt *) *
+                      numLoopChildren(CollapsedNum, OMPD_taskloop));
   OMPTaskLoopDirective *Dir = new (Mem)
       OMPTaskLoopDirective(StartLoc, EndLoc, CollapsedNum, Clauses.size());
   Dir->setClauses(Clauses);
@@ -900,8 +903,9 @@ OMPTaskLoopDirective *OMPTaskLoopDirective::CreateEmpty(const ASTContext &C,
   unsigned Size =
       llvm::alignTo(sizeof(OMPTaskLoopDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * NumClauses +
-                 sizeof(Stmt *) * numLoopChildren(CollapsedNum, OMPD_taskloop));
+      allocate(C, Size + sizeof(OMPClause *) * NumClauses +
+                  sizeof(Stmt *) *
+                      numLoopChildren(CollapsedNum, OMPD_taskloop));
   return new (Mem) OMPTaskLoopDirective(CollapsedNum, NumClauses);
 }
 
@@ -911,8 +915,8 @@ OMPTaskLoopSimdDirective *OMPTaskLoopSimdDirective::Create(
     const HelperExprs &Exprs) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPTaskLoopSimdDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() +
-                         sizeof(Stmt *) *
+  void *Mem = allocate(C, Size + sizeof(OMPClause *) * Clauses.size() +
+                          sizeof(Stmt *) *
                              numLoopChildren(CollapsedNum, OMPD_taskloop_simd));
   OMPTaskLoopSimdDirective *Dir = new (Mem)
       OMPTaskLoopSimdDirective(StartLoc, EndLoc, CollapsedNum, Clauses.size());
@@ -947,8 +951,8 @@ OMPTaskLoopSimdDirective::CreateEmpty(const ASTContext &C, unsigned NumClauses,
                                       unsigned CollapsedNum, EmptyShell) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPTaskLoopSimdDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(Size + sizeof(OMPClause *) * NumClauses +
-                         sizeof(Stmt *) *
+  void *Mem = allocate(C, Size + sizeof(OMPClause *) * NumClauses +
+                          sizeof(Stmt *) *
                              numLoopChildren(CollapsedNum, OMPD_taskloop_simd));
   return new (Mem) OMPTaskLoopSimdDirective(CollapsedNum, NumClauses);
 }
@@ -959,8 +963,8 @@ OMPDistributeDirective *OMPDistributeDirective::Create(
     const HelperExprs &Exprs) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPDistributeDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() +
-                         sizeof(Stmt *) *
+  void *Mem = allocate(C, Size + sizeof(OMPClause *) * Clauses.size() +
+                          sizeof(Stmt *) *
                              numLoopChildren(CollapsedNum, OMPD_distribute));
   OMPDistributeDirective *Dir = new (Mem)
       OMPDistributeDirective(StartLoc, EndLoc, CollapsedNum, Clauses.size());
@@ -995,8 +999,8 @@ OMPDistributeDirective::CreateEmpty(const ASTContext &C, unsigned NumClauses,
                                     unsigned CollapsedNum, EmptyShell) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPDistributeDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(Size + sizeof(OMPClause *) * NumClauses +
-                         sizeof(Stmt *) *
+  void *Mem = allocate(C, Size + sizeof(OMPClause *) * NumClauses +
+                          sizeof(Stmt *) *
                              numLoopChildren(CollapsedNum, OMPD_distribute));
   return new (Mem) OMPDistributeDirective(CollapsedNum, NumClauses);
 }
@@ -1007,7 +1011,7 @@ OMPTargetUpdateDirective::Create(const ASTContext &C, SourceLocation StartLoc,
                                  ArrayRef<OMPClause *> Clauses) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPTargetUpdateDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(Size + sizeof(OMPClause *) * Clauses.size());
+  void *Mem = allocate(C, Size + sizeof(OMPClause *) * Clauses.size());
   OMPTargetUpdateDirective *Dir =
       new (Mem) OMPTargetUpdateDirective(StartLoc, EndLoc, Clauses.size());
   Dir->setClauses(Clauses);
@@ -1019,7 +1023,7 @@ OMPTargetUpdateDirective::CreateEmpty(const ASTContext &C, unsigned NumClauses,
                                       EmptyShell) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPTargetUpdateDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(Size + sizeof(OMPClause *) * NumClauses);
+  void *Mem = allocate(C, Size + sizeof(OMPClause *) * NumClauses);
   return new (Mem) OMPTargetUpdateDirective(NumClauses);
 }
 
@@ -1029,7 +1033,7 @@ OMPDistributeParallelForDirective *OMPDistributeParallelForDirective::Create(
     const HelperExprs &Exprs) {
   unsigned Size = llvm::alignTo(sizeof(OMPDistributeParallelForDirective),
                                 alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * Clauses.size() +
       sizeof(Stmt *) *
           numLoopChildren(CollapsedNum, OMPD_distribute_parallel_for));
@@ -1080,7 +1084,7 @@ OMPDistributeParallelForDirective::CreateEmpty(const ASTContext &C,
                                                EmptyShell) {
   unsigned Size = llvm::alignTo(sizeof(OMPDistributeParallelForDirective),
                                 alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * NumClauses +
       sizeof(Stmt *) *
           numLoopChildren(CollapsedNum, OMPD_distribute_parallel_for));
@@ -1094,7 +1098,7 @@ OMPDistributeParallelForSimdDirective::Create(
     const HelperExprs &Exprs) {
   unsigned Size = llvm::alignTo(sizeof(OMPDistributeParallelForSimdDirective),
                                 alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * Clauses.size() +
       sizeof(Stmt *) *
           numLoopChildren(CollapsedNum, OMPD_distribute_parallel_for_simd));
@@ -1145,7 +1149,7 @@ OMPDistributeParallelForSimdDirective::CreateEmpty(const ASTContext &C,
                                                    EmptyShell) {
   unsigned Size = llvm::alignTo(sizeof(OMPDistributeParallelForSimdDirective),
                                 alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * NumClauses +
       sizeof(Stmt *) *
           numLoopChildren(CollapsedNum, OMPD_distribute_parallel_for_simd));
@@ -1159,7 +1163,7 @@ OMPDistributeSimdDirective *OMPDistributeSimdDirective::Create(
     const HelperExprs &Exprs) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPDistributeSimdDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * Clauses.size() +
       sizeof(Stmt *) *
           numLoopChildren(CollapsedNum, OMPD_distribute_simd));
@@ -1197,7 +1201,7 @@ OMPDistributeSimdDirective::CreateEmpty(const ASTContext &C,
                                         unsigned CollapsedNum, EmptyShell) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPDistributeSimdDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * NumClauses +
       sizeof(Stmt *) *
           numLoopChildren(CollapsedNum, OMPD_distribute_simd));
@@ -1210,7 +1214,7 @@ OMPTargetParallelForSimdDirective *OMPTargetParallelForSimdDirective::Create(
     const HelperExprs &Exprs) {
   unsigned Size = llvm::alignTo(sizeof(OMPTargetParallelForSimdDirective),
                                 alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * Clauses.size() +
       sizeof(Stmt *) * 
           numLoopChildren(CollapsedNum, OMPD_target_parallel_for_simd));
@@ -1250,7 +1254,7 @@ OMPTargetParallelForSimdDirective::CreateEmpty(const ASTContext &C,
                                                EmptyShell) {
   unsigned Size = llvm::alignTo(sizeof(OMPTargetParallelForSimdDirective),
                                 alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * NumClauses +
       sizeof(Stmt *) * 
           numLoopChildren(CollapsedNum, OMPD_target_parallel_for_simd));
@@ -1264,8 +1268,8 @@ OMPTargetSimdDirective::Create(const ASTContext &C, SourceLocation StartLoc,
                                Stmt *AssociatedStmt, const HelperExprs &Exprs) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPTargetSimdDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() +
-                         sizeof(Stmt *) * 
+  void *Mem = allocate(C, Size + sizeof(OMPClause *) * Clauses.size() +
+                          sizeof(Stmt *) *
                              numLoopChildren(CollapsedNum, OMPD_target_simd));
   OMPTargetSimdDirective *Dir = new (Mem)
       OMPTargetSimdDirective(StartLoc, EndLoc, CollapsedNum, Clauses.size());
@@ -1292,8 +1296,8 @@ OMPTargetSimdDirective::CreateEmpty(const ASTContext &C, unsigned NumClauses,
                                     unsigned CollapsedNum, EmptyShell) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPTargetSimdDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(Size + sizeof(OMPClause *) * NumClauses +
-                         sizeof(Stmt *) * 
+  void *Mem = allocate(C, Size + sizeof(OMPClause *) * NumClauses +
+                          sizeof(Stmt *) *
                              numLoopChildren(CollapsedNum, OMPD_target_simd));
   return new (Mem) OMPTargetSimdDirective(CollapsedNum, NumClauses);
 }
@@ -1304,7 +1308,7 @@ OMPTeamsDistributeDirective *OMPTeamsDistributeDirective::Create(
     const HelperExprs &Exprs) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPTeamsDistributeDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * Clauses.size() +
       sizeof(Stmt *) * numLoopChildren(CollapsedNum, OMPD_teams_distribute));
   OMPTeamsDistributeDirective *Dir = new (Mem) OMPTeamsDistributeDirective(
@@ -1341,7 +1345,7 @@ OMPTeamsDistributeDirective::CreateEmpty(const ASTContext &C,
                                          unsigned CollapsedNum, EmptyShell) {
   unsigned Size =
       llvm::alignTo(sizeof(OMPTeamsDistributeDirective), alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * NumClauses +
       sizeof(Stmt *) * numLoopChildren(CollapsedNum, OMPD_teams_distribute));
   return new (Mem) OMPTeamsDistributeDirective(CollapsedNum, NumClauses);
@@ -1354,8 +1358,8 @@ OMPTeamsDistributeSimdDirective *OMPTeamsDistributeSimdDirective::Create(
   unsigned Size = llvm::alignTo(sizeof(OMPTeamsDistributeSimdDirective),
                                 alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() +
-                 sizeof(Stmt *) *
+      allocate(C, Size + sizeof(OMPClause *) * Clauses.size() +
+                  sizeof(Stmt *) *
                      numLoopChildren(CollapsedNum, OMPD_teams_distribute_simd));
   OMPTeamsDistributeSimdDirective *Dir =
       new (Mem) OMPTeamsDistributeSimdDirective(StartLoc, EndLoc, CollapsedNum,
@@ -1392,8 +1396,8 @@ OMPTeamsDistributeSimdDirective *OMPTeamsDistributeSimdDirective::CreateEmpty(
   unsigned Size = llvm::alignTo(sizeof(OMPTeamsDistributeSimdDirective),
                                 alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * NumClauses +
-                 sizeof(Stmt *) *
+      allocate(C, Size + sizeof(OMPClause *) * NumClauses +
+                  sizeof(Stmt *) *
                      numLoopChildren(CollapsedNum, OMPD_teams_distribute_simd));
   return new (Mem) OMPTeamsDistributeSimdDirective(CollapsedNum, NumClauses);
 }
@@ -1406,8 +1410,8 @@ OMPTeamsDistributeParallelForSimdDirective::Create(
   auto Size = llvm::alignTo(sizeof(OMPTeamsDistributeParallelForSimdDirective),
                             alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() +
-                 sizeof(Stmt *) *
+      allocate(C, Size + sizeof(OMPClause *) * Clauses.size() +
+                  sizeof(Stmt *) *
                      numLoopChildren(CollapsedNum,
                                      OMPD_teams_distribute_parallel_for_simd));
   OMPTeamsDistributeParallelForSimdDirective *Dir = new (Mem)
@@ -1458,8 +1462,8 @@ OMPTeamsDistributeParallelForSimdDirective::CreateEmpty(const ASTContext &C,
   auto Size = llvm::alignTo(sizeof(OMPTeamsDistributeParallelForSimdDirective),
                             alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * NumClauses +
-                 sizeof(Stmt *) *
+      allocate(C, Size + sizeof(OMPClause *) * NumClauses +
+                  sizeof(Stmt *) *
                      numLoopChildren(CollapsedNum,
                                      OMPD_teams_distribute_parallel_for_simd));
   return new (Mem)
@@ -1473,7 +1477,7 @@ OMPTeamsDistributeParallelForDirective::Create(
     const HelperExprs &Exprs) {
   auto Size = llvm::alignTo(sizeof(OMPTeamsDistributeParallelForDirective),
                             alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * Clauses.size() +
       sizeof(Stmt *) *
           numLoopChildren(CollapsedNum, OMPD_teams_distribute_parallel_for));
@@ -1524,7 +1528,7 @@ OMPTeamsDistributeParallelForDirective::CreateEmpty(const ASTContext &C,
                                                     EmptyShell) {
   auto Size = llvm::alignTo(sizeof(OMPTeamsDistributeParallelForDirective),
                             alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * NumClauses +
       sizeof(Stmt *) *
           numLoopChildren(CollapsedNum, OMPD_teams_distribute_parallel_for));
@@ -1538,7 +1542,7 @@ OMPTargetTeamsDirective *OMPTargetTeamsDirective::Create(
   auto Size =
       llvm::alignTo(sizeof(OMPTargetTeamsDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
   OMPTargetTeamsDirective *Dir =
       new (Mem) OMPTargetTeamsDirective(StartLoc, EndLoc, Clauses.size());
   Dir->setClauses(Clauses);
@@ -1552,7 +1556,7 @@ OMPTargetTeamsDirective::CreateEmpty(const ASTContext &C, unsigned NumClauses,
   auto Size =
       llvm::alignTo(sizeof(OMPTargetTeamsDirective), alignof(OMPClause *));
   void *Mem =
-      C.Allocate(Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
+      allocate(C, Size + sizeof(OMPClause *) * NumClauses + sizeof(Stmt *));
   return new (Mem) OMPTargetTeamsDirective(NumClauses);
 }
 
@@ -1562,7 +1566,7 @@ OMPTargetTeamsDistributeDirective *OMPTargetTeamsDistributeDirective::Create(
     const HelperExprs &Exprs) {
   auto Size = llvm::alignTo(sizeof(OMPTargetTeamsDistributeDirective),
                             alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * Clauses.size() +
       sizeof(Stmt *) *
           numLoopChildren(CollapsedNum, OMPD_target_teams_distribute));
@@ -1602,7 +1606,7 @@ OMPTargetTeamsDistributeDirective::CreateEmpty(const ASTContext &C,
                                                EmptyShell) {
   auto Size = llvm::alignTo(sizeof(OMPTargetTeamsDistributeDirective),
                             alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * NumClauses +
       sizeof(Stmt *) *
            numLoopChildren(CollapsedNum, OMPD_target_teams_distribute));
@@ -1617,7 +1621,7 @@ OMPTargetTeamsDistributeParallelForDirective::Create(
   auto Size =
       llvm::alignTo(sizeof(OMPTargetTeamsDistributeParallelForDirective),
                     alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * Clauses.size() +
       sizeof(Stmt *) *
           numLoopChildren(CollapsedNum,
@@ -1670,7 +1674,7 @@ OMPTargetTeamsDistributeParallelForDirective::CreateEmpty(const ASTContext &C,
   auto Size =
       llvm::alignTo(sizeof(OMPTargetTeamsDistributeParallelForDirective),
                     alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * NumClauses +
       sizeof(Stmt *) *
            numLoopChildren(CollapsedNum,
@@ -1687,7 +1691,7 @@ OMPTargetTeamsDistributeParallelForSimdDirective::Create(
   auto Size =
       llvm::alignTo(sizeof(OMPTargetTeamsDistributeParallelForSimdDirective),
                     alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * Clauses.size() +
       sizeof(Stmt *) *
           numLoopChildren(CollapsedNum,
@@ -1739,7 +1743,7 @@ OMPTargetTeamsDistributeParallelForSimdDirective::CreateEmpty(
   auto Size =
       llvm::alignTo(sizeof(OMPTargetTeamsDistributeParallelForSimdDirective),
                     alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * NumClauses +
       sizeof(Stmt *) *
           numLoopChildren(CollapsedNum,
@@ -1755,7 +1759,7 @@ OMPTargetTeamsDistributeSimdDirective::Create(
     const HelperExprs &Exprs) {
   auto Size = llvm::alignTo(sizeof(OMPTargetTeamsDistributeSimdDirective),
                             alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * Clauses.size() +
       sizeof(Stmt *) *
           numLoopChildren(CollapsedNum, OMPD_target_teams_distribute_simd));
@@ -1795,7 +1799,7 @@ OMPTargetTeamsDistributeSimdDirective::CreateEmpty(const ASTContext &C,
                                                    EmptyShell) {
   auto Size = llvm::alignTo(sizeof(OMPTargetTeamsDistributeSimdDirective),
                             alignof(OMPClause *));
-  void *Mem = C.Allocate(
+  void *Mem = allocate(C,
       Size + sizeof(OMPClause *) * NumClauses +
       sizeof(Stmt *) *
           numLoopChildren(CollapsedNum, OMPD_target_teams_distribute_simd));
@@ -17,6 +17,7 @@
 #include "clang/Analysis/Analyses/PostOrderCFGView.h"
 #include "clang/Analysis/AnalysisContext.h"
 #include "clang/Analysis/CFG.h"
+#include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/PostOrderIterator.h"
 #include "llvm/ADT/PriorityQueue.h"
@@ -71,21 +72,61 @@ const CFGBlock *DataflowWorklist::dequeue() {
   return b;
 }
 
+class LiveVariables::Numbering {
+  llvm::DenseMap<const Stmt *, unsigned> StmtIndices;
+  llvm::DenseMap<const VarDecl *, unsigned> DeclIndices;
+  std::vector<const VarDecl *> Decls;
+
+public:
+  /// Return the index of \p S, assigning it the next free one if \p S has
+  /// not been seen yet.
+  unsigned getIndex(const Stmt *S) {
+    return StmtIndices.insert(std::make_pair(S, StmtIndices.size()))
+        .first->second;
+  }
+
+  /// Return the index of \p D, assigning it the next free one if \p D has
+  /// not been seen yet.
+  unsigned getIndex(const VarDecl *D) {
+    auto Result = DeclIndices.insert(std::make_pair(D, Decls.size()));
+    if (Result.second)
+      Decls.push_back(D);
+    return Result.first->second;
+  }
+
+  /// Return the index of \p S, or -1 if it has never been numbered.
+  int lookup(const Stmt *S) const {
+    auto It = StmtIndices.find(S);
+    return It == StmtIndices.end() ? -1 : int(It->second);
+  }
+
+  /// Return the index of \p D, or -1 if it has never been numbered.
+  int lookup(const VarDecl *D) const {
+    auto It = DeclIndices.find(D);
+    return It == DeclIndices.end() ? -1 : int(It->second);
+  }
+
+  const VarDecl *getDecl(unsigned Index) const { return Decls[Index]; }
+};
+
 namespace {
 class LiveVariablesImpl {
 public:  
   AnalysisDeclContext &analysisContext;
-  llvm::ImmutableSet<const Stmt *>::Factory SSetFact;
-  llvm::ImmutableSet<const VarDecl *>::Factory DSetFact;
+  LiveVariables::Numbering numbering;
   llvm::DenseMap<const CFGBlock *, LiveVariables::LivenessValues> blocksEndToLiveness;
   llvm::DenseMap<const CFGBlock *, LiveVariables::LivenessValues> blocksBeginToLiveness;
   llvm::DenseMap<const Stmt *, LiveVariables::LivenessValues> stmtsToLiveness;
   llvm::DenseMap<const DeclRefExpr *, unsigned> inAssignment;
   const bool killAtAssign;
   
-  LiveVariables::LivenessValues
-  merge(LiveVariables::LivenessValues valsA,
-        LiveVariables::LivenessValues valsB);
+  void merge(LiveVariables::LivenessValues &Into,
+             const LiveVariables::LivenessValues &From);
+
+  void addLive(LiveVariables::LivenessValues &Vals, const Stmt *S);
+  void addLive(LiveVariables::LivenessValues &Vals, const VarDecl *D);
+  void removeLive(LiveVariables::LivenessValues &Vals, const Stmt *S);
+  void removeLive(LiveVariables::LivenessValues &Vals, const VarDecl *D);
 
   LiveVariables::LivenessValues
   runOnBlock(const CFGBlock *block, LiveVariables::LivenessValues val,
@@ -94,10 +135,7 @@ public:
   void dumpBlockLiveness(const SourceManager& M);
 
   LiveVariablesImpl(AnalysisDeclContext &ac, bool KillAtAssign)
-    : analysisContext(ac),
-      SSetFact(false), // Do not canonicalize ImmutableSets by default.
-      DSetFact(false), // This is a *major* performance win.
-      killAtAssign(KillAtAssign) {}
+    : analysisContext(ac), killAtAssign(KillAtAssign) {}
 };
 }
 
@@ -110,49 +148,54 @@ static LiveVariablesImpl &getImpl(void *x) {
 //===----------------------------------------------------------------------===//
 
 bool LiveVariables::LivenessValues::isLive(const Stmt *S) const {
-  return liveStmts.contains(S);
+  if (!numbering)
+    return false;
+  int Index = numbering->lookup(S);
+  return Index >= 0 && liveStmts.test(Index);
 }
 
 bool LiveVariables::LivenessValues::isLive(const VarDecl *D) const {
-  return liveDecls.contains(D);
+  if (!numbering)
+    return false;
+  int Index = numbering->lookup(D);
+  return Index >= 0 && liveDecls.test(Index);
 }
 
-namespace {
-  template <typename SET>
-  SET mergeSets(SET A, SET B) {
-    if (A.isEmpty())
-      return B;
-    
-    for (typename SET::iterator it = B.begin(), ei = B.end(); it != ei; ++it) {
-      A = A.add(*it);
-    }
-    return A;
-  }
+void LiveVariables::Observer::anchor() { }
+
+void LiveVariablesImpl::merge(LiveVariables::LivenessValues &Into,
+                              const LiveVariables::LivenessValues &From) {
+  if (!From.numbering)
+    return;
+  Into.numbering = From.numbering;
+  Into.liveStmts |= From.liveStmts;
+  Into.liveDecls |= From.liveDecls;
 }
 
-void LiveVariables::Observer::anchor() { }
+void LiveVariablesImpl::addLive(LiveVariables::LivenessValues &Vals,
+                                const Stmt *S) {
+  Vals.numbering = &numbering;
+  Vals.liveStmts.set(numbering.getIndex(S));
+}
 
-LiveVariables::LivenessValues
-LiveVariablesImpl::merge(LiveVariables::LivenessValues valsA,
-                         LiveVariables::LivenessValues valsB) {  
-  
-  llvm::ImmutableSetRef<const Stmt *>
-    SSetRefA(valsA.liveStmts.getRootWithoutRetain(), SSetFact.getTreeFactory()),
-    SSetRefB(valsB.liveStmts.getRootWithoutRetain(), SSetFact.getTreeFactory());
-                                                
-  
-  llvm::ImmutableSetRef<const VarDecl *>
-    DSetRefA(valsA.liveDecls.getRootWithoutRetain(), DSetFact.getTreeFactory()),
-    DSetRefB(valsB.liveDecls.getRootWithoutRetain(), DSetFact.getTreeFactory());
-  
+void LiveVariablesImpl::addLive(LiveVariables::LivenessValues &Vals,
+                                const VarDecl *D) {
+  Vals.numbering = &numbering;
+  Vals.liveDecls.set(numbering.getIndex(D));
+}
 
-  SSetRefA = mergeSets(SSetRefA, SSetRefB);
-  DSetRefA = mergeSets(DSetRefA, DSetRefB);
-  
-  // asImmutableSet() canonicalizes the tree, allowing us to do an easy
-  // comparison afterwards.
-  return LiveVariables::LivenessValues(SSetRefA.asImmutableSet(),
-                                       DSetRefA.asImmutableSet());  
+void LiveVariablesImpl::removeLive(LiveVariables::LivenessValues &Vals,
+                                   const Stmt *S) {
+  int Index = numbering.lookup(S);
+  if (Index >= 0)
+    Vals.liveStmts.reset(Index);
+}
+
+void LiveVariablesImpl::removeLive(LiveVariables::LivenessValues &Vals,
+                                   const VarDecl *D) {
+  int Index = numbering.lookup(D);
+  if (Index >= 0)
+    Vals.liveDecls.reset(Index);
 }
 
 bool LiveVariables::LivenessValues::equals(const LivenessValues &V) const {
@@ -237,10 +280,9 @@ static const Stmt *LookThroughStmt(const Stmt *S) {
   return S;
 }
 
-static void AddLiveStmt(llvm::ImmutableSet<const Stmt *> &Set,
-                        llvm::ImmutableSet<const Stmt *>::Factory &F,
-                        const Stmt *S) {
-  Set = F.add(Set, LookThroughStmt(S));
+static void AddLiveStmt(LiveVariablesImpl &LV,
+                        LiveVariables::LivenessValues &Vals, const Stmt *S) {
+  LV.addLive(Vals, LookThroughStmt(S));
 }
 
 void TransferFunctions::Visit(Stmt *S) {
@@ -250,7 +292,7 @@ void TransferFunctions::Visit(Stmt *S) {
   StmtVisitor<TransferFunctions>::Visit(S);
   
   if (isa<Expr>(S)) {
-    val.liveStmts = LV.SSetFact.remove(val.liveStmts, S);
+    LV.removeLive(val, S);
   }
 
   // Mark all children expressions live.
@@ -267,7 +309,7 @@ void TransferFunctions::Visit(Stmt *S) {
       // Include the implicit "this" pointer as being live.
       CXXMemberCallExpr *CE = cast<CXXMemberCallExpr>(S);
       if (Expr *ImplicitObj = CE->getImplicitObjectArgument()) {
-        AddLiveStmt(val.liveStmts, LV.SSetFact, ImplicitObj);
+        AddLiveStmt(LV, val, ImplicitObj);
       }
       break;
     }
@@ -275,8 +317,7 @@ void TransferFunctions::Visit(Stmt *S) {
       // In calls to super, include the implicit "self" pointer as being live.
       ObjCMessageExpr *CE = cast<ObjCMessageExpr>(S);
       if (CE->getReceiverKind() == ObjCMessageExpr::SuperInstance)
-        val.liveDecls = LV.DSetFact.add(val.liveDecls,
-                                        LV.analysisContext.getSelfDecl());
+        LV.addLive(val, LV.analysisContext.getSelfDecl());
       break;
     }
     case Stmt::DeclStmtClass: {
@@ -284,7 +325,7 @@ void TransferFunctions::Visit(Stmt *S) {
       if (const VarDecl *VD = dyn_cast<VarDecl>(DS->getSingleDecl())) {
         for (const VariableArrayType* VA = FindVA(VD->getType());
              VA != nullptr; VA = FindVA(VA->getElementType())) {
-          AddLiveStmt(val.liveStmts, LV.SSetFact, VA->getSizeExpr());
+          AddLiveStmt(LV, val, VA->getSizeExpr());
         }
       }
       break;
@@ -297,7 +338,7 @@ void TransferFunctions::Visit(Stmt *S) {
       if (OpaqueValueExpr *OV = dyn_cast<OpaqueValueExpr>(child))
         child = OV->getSourceExpr();
       child = child->IgnoreParens();
-      val.liveStmts = LV.SSetFact.add(val.liveStmts, child);
+      LV.addLive(val, child);
       return;
     }
 
@@ -318,7 +359,7 @@ void TransferFunctions::Visit(Stmt *S) {
 
   for (Stmt *Child : S->children()) {
     if (Child)
-      AddLiveStmt(val.liveStmts, LV.SSetFact, Child);
+      AddLiveStmt(LV, val, Child);
   }
 }
 
@@ -338,7 +379,7 @@ void TransferFunctions::VisitBinaryOperator(BinaryOperator *B) {
 
         if (!isAlwaysAlive(VD)) {
           // The variable is now dead.
-          val.liveDecls = LV.DSetFact.remove(val.liveDecls, VD);
+          LV.removeLive(val, VD);
         }
 
         if (observer)
@@ -352,21 +393,21 @@ void TransferFunctions::VisitBlockExpr(BlockExpr *BE) {
        LV.analysisContext.getReferencedBlockVars(BE->getBlockDecl())) {
     if (isAlwaysAlive(VD))
       continue;
-    val.liveDecls = LV.DSetFact.add(val.liveDecls, VD);
+    LV.addLive(val, VD);
   }
 }
 
 void TransferFunctions::VisitDeclRefExpr(DeclRefExpr *DR) {
   if (const VarDecl *D = dyn_cast<VarDecl>(DR->getDecl()))
     if (!isAlwaysAlive(D) && LV.inAssignment.find(DR) == LV.inAssignment.end())
-      val.liveDecls = LV.DSetFact.add(val.liveDecls, D);
+      LV.addLive(val, D);
 }
 
 void TransferFunctions::VisitDeclStmt(DeclStmt *DS) {
   for (const auto *DI : DS->decls())
     if (const auto *VD = dyn_cast<VarDecl>(DI)) {
       if (!isAlwaysAlive(VD))
-        val.liveDecls = LV.DSetFact.remove(val.liveDecls, VD);
+        LV.removeLive(val, VD);
     }
 }
 
@@ -384,7 +425,7 @@ void TransferFunctions::VisitObjCForCollectionStmt(ObjCForCollectionStmt *OS) {
   }
   
   if (VD) {
-    val.liveDecls = LV.DSetFact.remove(val.liveDecls, VD);
+    LV.removeLive(val, VD);
     if (observer && DR)
       observer->observerKill(DR);
   }
@@ -402,7 +443,7 @@ VisitUnaryExprOrTypeTraitExpr(UnaryExprOrTypeTraitExpr *UE)
   const Expr *subEx = UE->getArgumentExpr();
   if (subEx->getType()->isVariableArrayType()) {
     assert(subEx->isLValue());
-    val.liveStmts = LV.SSetFact.add(val.liveStmts, subEx->IgnoreParens());
+    LV.addLive(val, subEx->IgnoreParens());
   }
 }
 
@@ -448,7 +489,7 @@ LiveVariablesImpl::runOnBlock(const CFGBlock *block,
 
     if (Optional<CFGAutomaticObjDtor> Dtor =
             elem.getAs<CFGAutomaticObjDtor>()) {
-      val.liveDecls = DSetFact.add(val.liveDecls, Dtor->getVarDecl());
+      addLive(val, Dtor->getVarDecl());
       continue;
     }
 
@@ -531,7 +572,7 @@ LiveVariables::computeLiveness(AnalysisDeclContext &AC,
     for (CFGBlock::const_succ_iterator it = block->succ_begin(),
                                        ei = block->succ_end(); it != ei; ++it) {
       if (const CFGBlock *succ = *it) {     
-        val = LV->merge(val, LV->blocksBeginToLiveness[succ]);
+        LV->merge(val, LV->blocksBeginToLiveness[succ]);
       }
     }
     
@@ -574,14 +615,11 @@ void LiveVariablesImpl::dumpBlockLiveness(const SourceManager &M) {
     llvm::errs() << "\n[ B" << (*it)->getBlockID()
                  << " (live variables at block exit) ]\n";
     
-    LiveVariables::LivenessValues vals = blocksEndToLiveness[*it];
+    const LiveVariables::LivenessValues &vals = blocksEndToLiveness[*it];
     declVec.clear();
     
-    for (llvm::ImmutableSet<const VarDecl *>::iterator si =
-          vals.liveDecls.begin(),
-          se = vals.liveDecls.end(); si != se; ++si) {
-      declVec.push_back(*si);      
-    }
+    for (unsigned I : vals.liveDecls)
+      declVec.push_back(numbering.getDecl(I));
 
     std::sort(declVec.begin(), declVec.end(), [](const Decl *A, const Decl *B) {
       return A->getLocStart() < B->getLocStart();
@@ -62,6 +62,8 @@ static uint32_t getDeclAlignIfRequired(const Decl *D, const ASTContext &Ctx) {
 CGDebugInfo::CGDebugInfo(CodeGenModule &CGM)
     : CGM(CGM), DebugKind(CGM.getCodeGenOpts().getDebugInfo()),
       DebugTypeExtRefs(CGM.getCodeGenOpts().DebugTypeExtRefs),
+      CompactReflectionDebugInfo(
+          CGM.getCodeGenOpts().CompactReflectionDebugInfo),
       DBuilder(CGM.getModule()) {
   for (const auto &KV : CGM.getCodeGenOpts().DebugPrefixMap)
     DebugPrefixMap[KV.first] = KV.second;
@@ -1816,12 +1818,29 @@ static bool isDefinedInClangModule(const RecordDecl *RD) {
   return true;
 }
 
+/// Is this one of the types the reflection library instantiates for every
+/// reflected entity, or the closure type of a fragment expression?
+static bool isReflectionType(const RecordDecl *RD) {
+  if (RD->isFragment() && RD->isImplicit())
+    return true;
+  return RD->getEnclosingNamespaceContext()->isCppxMetaNamespace();
+}
+
 static bool shouldOmitDefinition(codegenoptions::DebugInfoKind DebugKind,
-                                 bool DebugTypeExtRefs, const RecordDecl *RD,
+                                 bool DebugTypeExtRefs,
+                                 bool CompactReflectionDebugInfo,
+                                 const RecordDecl *RD,
                                  const LangOptions &LangOpts) {
   if (DebugTypeExtRefs && isDefinedInClangModule(RD->getDefinition()))
     return true;
 
+  // Reflection types are named after the address of the reflected entity and
+  // are rarely inspected in a debugger; with -fcompact-reflection-debug-info
+  // they only get a declaration, whatever the debug info kind.
+  if (CompactReflectionDebugInfo && LangOpts.Reflection &&
+      isReflectionType(RD))
+    return true;
+
   if (auto *ES = RD->getASTContext().getExternalSource())
     if (ES->hasExternalDefinitions(RD) == ExternalASTSource::EK_Always)
       return true;
@@ -1863,7 +1882,8 @@ static bool shouldOmitDefinition(codegenoptions::DebugInfoKind DebugKind,
 }
 
 void CGDebugInfo::completeRequiredType(const RecordDecl *RD) {
-  if (shouldOmitDefinition(DebugKind, DebugTypeExtRefs, RD, CGM.getLangOpts()))
+  if (shouldOmitDefinition(DebugKind, DebugTypeExtRefs,
+                           CompactReflectionDebugInfo, RD, CGM.getLangOpts()))
     return;
 
   QualType Ty = CGM.getContext().getRecordType(RD);
@@ -1875,7 +1895,8 @@ void CGDebugInfo::completeRequiredType(const RecordDecl *RD) {
 llvm::DIType *CGDebugInfo::CreateType(const RecordType *Ty) {
   RecordDecl *RD = Ty->getDecl();
   llvm::DIType *T = cast_or_null<llvm::DIType>(getTypeOrNull(QualType(Ty, 0)));
-  if (T || shouldOmitDefinition(DebugKind, DebugTypeExtRefs, RD,
+  if (T || shouldOmitDefinition(DebugKind, DebugTypeExtRefs,
+                                CompactReflectionDebugInfo, RD,
                                 CGM.getLangOpts())) {
     if (!T)
       T = getOrCreateRecordFwdDecl(Ty, getDeclContextDescriptor(RD));
@@ -3265,6 +3286,39 @@ void CGDebugInfo::EmitInlineFunctionStart(CGBuilderTy &Builder, GlobalDecl GD) {
   EmitLocation(Builder, FD->getLocation());
 }
 
+void CGDebugInfo::EmitInjectedFunctionStart(CGBuilderTy &Builder,
+                                            const InjectionOrigin &Origin) {
+  const FunctionDecl *Source = Origin.Source;
+  SourceLocation Loc = Source->getLocation();
+  llvm::TrackingMDRef &Cached = InjectionSourceCache[Source];
+  auto *SP = cast_or_null<llvm::DISubprogram>(Cached.get());
+  if (!SP) {
+    // Name the subprogram after the metaclass or fragment that supplied the
+    // body, so that the code it generated for every class is grouped
+    // together.
+    SmallString<64> Name;
+    llvm::raw_svector_ostream OS(Name);
+    if (const auto *Metaclass = dyn_cast_or_null<NamedDecl>(Origin.Metaclass))
+      OS << Metaclass->getName() << "::";
+    else if (Source->isInFragment())
+      OS << "__fragment::";
+    OS << Source->getDeclName();
+
+    llvm::DIFile *Unit = getOrCreateFile(Loc);
+    unsigned Line = getLineNumber(Loc);
+    SP = DBuilder.createFunction(
+        Unit, OS.str(), StringRef(), Unit, Line,
+        DBuilder.createSubroutineType(DBuilder.getOrCreateTypeArray(None)),
+        /*isLocalToUnit=*/true, /*isDefinition=*/true, Line,
+        llvm::DINode::FlagPrototyped, CGM.getLangOpts().Optimize);
+    Cached.reset(SP);
+  }
+  FnBeginRegionCount.push_back(LexicalBlockStack.size());
+  LexicalBlockStack.emplace_back(SP);
+  setInlinedAt(Builder.getCurrentDebugLocation());
+  EmitLocation(Builder, Loc);
+}
+
 void CGDebugInfo::EmitInlineFunctionEnd(CGBuilderTy &Builder) {
   assert(CurInlinedAt && "unbalanced inline scope stack");
   EmitFunctionEnd(Builder);
@@ -36,6 +36,7 @@ class MDNode;
 namespace clang {
 class ClassTemplateSpecializationDecl;
 class GlobalDecl;
+struct InjectionOrigin;
 class ModuleMap;
 class ObjCInterfaceDecl;
 class ObjCIvarDecl;
@@ -56,6 +57,7 @@ class CGDebugInfo {
   CodeGenModule &CGM;
   const codegenoptions::DebugInfoKind DebugKind;
   bool DebugTypeExtRefs;
+  bool CompactReflectionDebugInfo;
   llvm::DIBuilder DBuilder;
   llvm::DICompileUnit *TheCU = nullptr;
   ModuleMap *ClangModuleMap = nullptr;
@@ -122,6 +124,8 @@ class CGDebugInfo {
 
   llvm::DenseMap<const char *, llvm::TrackingMDRef> DIFileCache;
   llvm::DenseMap<const FunctionDecl *, llvm::TrackingMDRef> SPCache;
+  /// Cache of the subprograms describing the sources of injected functions.
+  llvm::DenseMap<const FunctionDecl *, llvm::TrackingMDRef> InjectionSourceCache;
   /// Cache declarations relevant to DW_TAG_imported_declarations (C++
   /// using declarations) that aren't covered by other more specific caches.
   llvm::DenseMap<const Decl *, llvm::TrackingMDRef> DeclCache;
@@ -363,6 +367,12 @@ public:
   /// End an inlined function scope.
   void EmitInlineFunctionEnd(CGBuilderTy &Builder);
 
+  /// Start a new scope for the body of an injected function, inlined from
+  /// the fragment or declaration described by \p Origin. End it with
+  /// EmitInlineFunctionEnd.
+  void EmitInjectedFunctionStart(CGBuilderTy &Builder,
+                                 const InjectionOrigin &Origin);
+
   /// Emit debug info for a function declaration.
   void EmitFunctionDecl(GlobalDecl GD, SourceLocation Loc, QualType FnType);
 
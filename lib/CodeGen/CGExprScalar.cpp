@@ -628,8 +628,11 @@ public:
     return Builder.getInt1(E->getValue());
   }
 
-  // FIXME: We should never actually get here... except that apparently
-  // functions calling these expressions are sometimes odr-used.
+  // Only the traits with effects, which have type void, survive translation;
+  // the others are replaced by their values, and runtime calls to the
+  // reflection library are folded by Sema. We can still get here through a
+  // library function that is odr-used some other way, e.g. by taking its
+  // address.
   Value *VisitReflectionTraitExpr(const ReflectionTraitExpr *E) {
     return nullptr;
   }
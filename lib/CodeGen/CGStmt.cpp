@@ -1020,6 +1020,15 @@ CodeGenFunction::EmitCXXForRangeStmt(const CXXForRangeStmt &S,
 void
 CodeGenFunction::EmitCXXTupleExpansionStmt(const CXXTupleExpansionStmt &S,
                                            ArrayRef<const Attr *> ForAttrs) {
+  // When the instantiations differ only in constants, emit them as a single
+  // loop over the tables of those constants.
+  if (const Stmt *Rolled = S.getRolledStatement()) {
+    LexicalScope ForScope(*this, S.getSourceRange());
+    EmitStmt(S.getRangeVarStmt());
+    EmitStmt(Rolled);
+    return;
+  }
+
   JumpDest LoopExit = getJumpDestInCurrentScope("expand.end");
 
   // Create a basic block for each instantiation.
@@ -1145,6 +1145,22 @@ void CodeGenFunction::GenerateCode(GlobalDecl GD, llvm::Function *Fn,
     if (SpecDecl->hasBody(SpecDecl))
       Loc = SpecDecl->getLocation();
 
+  // An injected function is located at its point of injection, and its body
+  // is described as inlined there from the fragment or declaration it was
+  // generated from.
+  SourceLocation ScopeLoc = BodyRange.getBegin();
+  SourceLocation EndLoc = BodyRange.getEnd();
+  const InjectionOrigin *InjectedFrom = CGM.getInjectionOrigin(FD);
+  bool DescribeInjection = InjectedFrom && getDebugInfo() &&
+                           CGM.getCodeGenOpts().DebugInjectionOrigins;
+  if (DescribeInjection) {
+    const Decl *POI = InjectedFrom->Generator ? InjectedFrom->Generator
+                                              : InjectedFrom->Injectee;
+    Loc = ScopeLoc = EndLoc = POI->getLocation();
+  }
+  if (InjectedFrom && !CGM.getCodeGenOpts().InjectionMapFile.empty())
+    CGM.addInjectedFunction(Fn, FD);
+
   Stmt *Body = FD->getBody();
 
   // Initialize helper which will detect jumps which can cause invalid lifetime
@@ -1153,7 +1169,10 @@ void CodeGenFunction::GenerateCode(GlobalDecl GD, llvm::Function *Fn,
     Bypasses.Init(Body);
 
   // Emit the standard function prologue.
-  StartFunction(GD, ResTy, Fn, FnInfo, Args, Loc, BodyRange.getBegin());
+  StartFunction(GD, ResTy, Fn, FnInfo, Args, Loc, ScopeLoc);
+
+  if (DescribeInjection)
+    getDebugInfo()->EmitInjectedFunctionStart(Builder, *InjectedFrom);
 
   // Generate the body of the function.
   PGO.assignRegionCounters(GD, CurFn);
@@ -1213,8 +1232,14 @@ void CodeGenFunction::GenerateCode(GlobalDecl GD, llvm::Function *Fn,
     }
   }
 
+  if (DescribeInjection) {
+    getDebugInfo()->EmitInlineFunctionEnd(Builder);
+    // The epilogue belongs to the point of injection, not to the fragment.
+    LastStopPoint = EndLoc;
+  }
+
   // Emit the standard function epilogue.
-  FinishFunction(BodyRange.getEnd());
+  FinishFunction(EndLoc);
 
   // If we haven't marked the function nothrow through other means, do
   // a quick pass now to see if we can.
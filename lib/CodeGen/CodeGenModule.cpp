@@ -55,7 +55,9 @@
 #include "llvm/ProfileData/InstrProfReader.h"
 #include "llvm/Support/ConvertUTF.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MD5.h"
+#include "llvm/Support/raw_ostream.h"
 
 using namespace clang;
 using namespace CodeGen;
@@ -419,6 +421,7 @@ void CodeGenModule::Release() {
     CodeGenFunction(*this).EmitCfiCheckStub();
   }
   emitAtAvailableLinkGuard();
+  EmitInjectionMap();
   emitLLVMUsed();
   if (SanStats)
     SanStats->finish();
@@ -4196,6 +4199,70 @@ bool CodeGenModule::lookupRepresentativeDecl(StringRef MangledName,
   return true;
 }
 
+const InjectionOrigin *
+CodeGenModule::getInjectionOrigin(const FunctionDecl *FD) const {
+  if (const InjectionOrigin *Origin = Context.getInjectionOrigin(FD))
+    return Origin;
+  if (const FunctionDecl *Pattern = FD->getTemplateInstantiationPattern())
+    return Context.getInjectionOrigin(Pattern);
+  return nullptr;
+}
+
+/// Writes one line for each step of the injection chain of each injected
+/// function defined in this module. The tab-separated fields are the symbol,
+/// the depth of the step (0 for the injection that created the function),
+/// the injectee, the location of the injected declaration, the location of
+/// the metaprogram that injected it and the name of the metaclass that
+/// contributed that metaprogram. Missing fields are written as '-'.
+void CodeGenModule::EmitInjectionMap() {
+  if (CodeGenOpts.InjectionMapFile.empty())
+    return;
+
+  std::error_code EC;
+  llvm::raw_fd_ostream OS(CodeGenOpts.InjectionMapFile, EC,
+                          llvm::sys::fs::F_Text);
+  if (EC) {
+    getDiags().Report(diag::err_cannot_open_file)
+        << CodeGenOpts.InjectionMapFile << EC.message();
+    return;
+  }
+
+  const SourceManager &SM = Context.getSourceManager();
+  auto PrintName = [&](const Decl *D) {
+    if (const auto *ND = dyn_cast_or_null<NamedDecl>(D))
+      ND->printQualifiedName(OS);
+    else if (D && isa<TranslationUnitDecl>(D))
+      OS << "::";
+    else
+      OS << '-';
+  };
+  auto PrintLoc = [&](const Decl *D) {
+    if (D && D->getLocation().isValid())
+      D->getLocation().print(OS, SM);
+    else
+      OS << '-';
+  };
+
+  for (const auto &Entry : InjectedFunctions) {
+    if (!Entry.first)
+      continue;
+    StringRef Symbol = Entry.first->getName();
+    unsigned Depth = 0;
+    for (const InjectionOrigin *Origin = getInjectionOrigin(Entry.second);
+         Origin; Origin = getInjectionOrigin(Origin->Source), ++Depth) {
+      OS << Symbol << '\t' << Depth << '\t';
+      PrintName(Origin->Injectee);
+      OS << '\t';
+      PrintLoc(Origin->Source);
+      OS << '\t';
+      PrintLoc(Origin->Generator);
+      OS << '\t';
+      PrintName(Origin->Metaclass);
+      OS << '\n';
+    }
+  }
+}
+
 /// Emits metadata nodes associating all the global values in the
 /// current module with the Decls they came from.  This is useful for
 /// projects using IR gen as a subroutine.
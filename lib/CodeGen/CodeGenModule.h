@@ -341,6 +341,11 @@ private:
   /// A queue of (optional) vtables to consider emitting.
   std::vector<const CXXRecordDecl*> DeferredVTables;
 
+  /// Functions created by source code injection, listed in the file named by
+  /// -finjection-map.
+  std::vector<std::pair<llvm::WeakTrackingVH, const FunctionDecl *>>
+    InjectedFunctions;
+
   /// List of global values which are required to be present in the object file;
   /// bitcast to i8*. This is used for forcing visibility of symbols which may
   /// otherwise be optimized out.
@@ -510,6 +515,15 @@ public:
   /// Finalize LLVM code generation.
   void Release();
 
+  /// If \p FD, or the pattern it was instantiated from, was created by source
+  /// code injection, return how it was generated.
+  const InjectionOrigin *getInjectionOrigin(const FunctionDecl *FD) const;
+
+  /// Note that \p Fn is the definition of the injected function \p FD.
+  void addInjectedFunction(llvm::Function *Fn, const FunctionDecl *FD) {
+    InjectedFunctions.emplace_back(Fn, FD);
+  }
+
   /// Return a reference to the configured Objective-C runtime.
   CGObjCRuntime &getObjCRuntime() {
     if (!ObjCRuntime) createObjCRuntime();
@@ -1305,6 +1319,10 @@ private:
 
   void EmitDeclMetadata();
 
+  /// \brief Write the origins of injected functions to the file named by
+  /// -finjection-map.
+  void EmitInjectionMap();
+
   /// \brief Emit the Clang version as llvm.ident metadata.
   void EmitVersionIdentMetadata();
 
@@ -162,8 +162,13 @@ namespace {
       // methods may be added during this loop, since ASTConsumer callbacks
       // can be invoked if AST inspection results in declarations being added.
       HandlingTopLevelDeclRAII HandlingDecl(*this);
-      for (unsigned I = 0; I != DeferredInlineMethodDefinitions.size(); ++I)
-        Builder->EmitTopLevelDecl(DeferredInlineMethodDefinitions[I]);
+      for (unsigned I = 0; I != DeferredInlineMethodDefinitions.size(); ++I) {
+        // Skip the remaining members of discarded metaclass prototypes.
+        CXXMethodDecl *MD = DeferredInlineMethodDefinitions[I];
+        if (MD->getParent()->isDiscarded())
+          continue;
+        Builder->EmitTopLevelDecl(MD);
+      }
       DeferredInlineMethodDefinitions.clear();
     }
 
@@ -0,0 +1,351 @@
+//===--- CrossTranslationUnit.cpp - Cross-TU function import --------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements the CrossTranslationUnitContext class, which imports
+//  function definitions from the AST files of other translation units.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/CrossTU/CrossTranslationUnit.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/ASTImporter.h"
+#include "clang/AST/Decl.h"
+#include "clang/Frontend/ASTUnit.h"
+#include "clang/Frontend/CompilerInstance.h"
+#include "clang/Frontend/TextDiagnosticPrinter.h"
+#include "clang/Index/USRGeneration.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include <fstream>
+#include <sstream>
+
+using namespace clang;
+using namespace cross_tu;
+
+#define DEBUG_TYPE "CrossTranslationUnit"
+STATISTIC(NumGetCTUCalled, "The # of cross-TU definitions requested");
+STATISTIC(NumNoUnit, "The # of requests whose AST file could not be loaded");
+STATISTIC(NumMemoizedLookups, "The # of lookups answered from the memo");
+STATISTIC(NumUnitsLoaded, "The # of AST files loaded");
+STATISTIC(NumUnitsEvicted, "The # of AST files released to stay in the limit");
+STATISTIC(NumFunctionsImported, "The # of functions imported");
+
+namespace {
+
+class IndexErrorCategory : public std::error_category {
+public:
+  const char *name() const noexcept override { return "clang.index"; }
+
+  std::string message(int Condition) const override {
+    switch (static_cast<index_error_code>(Condition)) {
+    case index_error_code::unspecified:
+      return "An unknown error has occurred.";
+    case index_error_code::missing_index_file:
+      return "The index file is missing.";
+    case index_error_code::invalid_index_format:
+      return "Invalid index file format.";
+    case index_error_code::multiple_definitions:
+      return "Multiple definitions in the index file.";
+    case index_error_code::missing_definition:
+      return "Missing definition from the index file.";
+    case index_error_code::failed_import:
+      return "Failed to import the definition.";
+    case index_error_code::failed_to_get_external_ast:
+      return "Failed to load external AST source.";
+    }
+    llvm_unreachable("Unrecognized index_error_code.");
+  }
+};
+
+} // end anonymous namespace
+
+static llvm::ManagedStatic<IndexErrorCategory> Category;
+
+char IndexError::ID;
+
+void IndexError::log(raw_ostream &OS) const {
+  OS << Category->message(static_cast<int>(Code)) << '\n';
+}
+
+std::error_code IndexError::convertToErrorCode() const {
+  return std::error_code(static_cast<int>(Code), *Category);
+}
+
+llvm::Expected<llvm::StringMap<std::string>>
+cross_tu::parseCrossTUIndex(StringRef IndexPath, StringRef CrossTUDir) {
+  std::ifstream ExternalFnMapFile(IndexPath);
+  if (!ExternalFnMapFile)
+    return llvm::make_error<IndexError>(index_error_code::missing_index_file,
+                                        IndexPath.str());
+
+  llvm::StringMap<std::string> Result;
+  std::string Line;
+  unsigned LineNo = 1;
+  while (std::getline(ExternalFnMapFile, Line)) {
+    StringRef LineRef(Line);
+    StringRef LookupName, FileName;
+    std::tie(LookupName, FileName) = LineRef.split(' ');
+    if (LookupName.empty() || FileName.empty())
+      return llvm::make_error<IndexError>(
+          index_error_code::invalid_index_format, IndexPath.str(), LineNo);
+
+    SmallString<256> FilePath = FileName;
+    if (llvm::sys::path::is_relative(FileName)) {
+      FilePath = CrossTUDir;
+      llvm::sys::path::append(FilePath, FileName);
+    }
+    if (!Result.insert(std::make_pair(LookupName, FilePath.str().str()))
+             .second)
+      return llvm::make_error<IndexError>(
+          index_error_code::multiple_definitions, IndexPath.str(), LineNo);
+    ++LineNo;
+  }
+  return std::move(Result);
+}
+
+std::string
+cross_tu::createCrossTUIndexString(const llvm::StringMap<std::string> &Index) {
+  std::ostringstream Result;
+  for (const auto &E : Index)
+    Result << E.getKey().str() << " " << E.getValue() << '\n';
+  return Result.str();
+}
+
+CrossTranslationUnitContext::CrossTranslationUnitContext(CompilerInstance &CI)
+    : CI(CI), Context(CI.getASTContext()), LoadedBytes(0), MemoryLimit(0) {}
+
+CrossTranslationUnitContext::~CrossTranslationUnitContext() {}
+
+std::string CrossTranslationUnitContext::getLookupName(const NamedDecl *ND) {
+  SmallString<128> DeclUSR;
+  bool Ret = index::generateUSRForDecl(ND, DeclUSR);
+  (void)Ret;
+  assert(!Ret && "Unable to generate USR");
+  return DeclUSR.str();
+}
+
+/// \brief Find the definition of the function with lookup name
+/// \p LookupName among the declarations of \p DC and its nested namespaces
+/// and classes.
+static const FunctionDecl *findFunctionInDeclContext(const DeclContext *DC,
+                                                     StringRef LookupName) {
+  for (const Decl *D : DC->decls()) {
+    if (isa<FunctionDecl>(D)) {
+      const FunctionDecl *Def;
+      if (!cast<FunctionDecl>(D)->hasBody(Def) || Def != D)
+        continue;
+      if (CrossTranslationUnitContext::getLookupName(Def) == LookupName)
+        return Def;
+      continue;
+    }
+    if (const auto *SubDC = dyn_cast<DeclContext>(D))
+      if (const FunctionDecl *FD = findFunctionInDeclContext(SubDC, LookupName))
+        return FD;
+  }
+  return nullptr;
+}
+
+llvm::Expected<const FunctionDecl *>
+CrossTranslationUnitContext::getCrossTUDefinition(const FunctionDecl *FD,
+                                                  StringRef CrossTUDir,
+                                                  StringRef IndexName) {
+  ++NumGetCTUCalled;
+  const FunctionDecl *Def;
+  if (FD->hasBody(Def))
+    return Def;
+
+  std::string LookupName = getLookupName(FD);
+  auto Imported = ImportedDefinitions.find(LookupName);
+  if (Imported != ImportedDefinitions.end()) {
+    ++NumMemoizedLookups;
+    return Imported->second;
+  }
+  auto Failed = FailedLookups.find(LookupName);
+  if (Failed != FailedLookups.end()) {
+    ++NumMemoizedLookups;
+    return llvm::make_error<IndexError>(Failed->second);
+  }
+
+  // Remember why the lookup failed, so that the index and the AST file are
+  // not consulted again for this function.
+  auto Fail = [&](llvm::Error Err) -> llvm::Error {
+    return llvm::handleErrors(std::move(Err), [&](const IndexError &IE) {
+      FailedLookups[LookupName] = IE.getCode();
+      return llvm::make_error<IndexError>(IE);
+    });
+  };
+
+  llvm::Expected<ASTUnit *> Unit =
+      loadExternalAST(LookupName, CrossTUDir, IndexName);
+  if (!Unit)
+    return Fail(Unit.takeError());
+
+  const TranslationUnitDecl *TU =
+      (*Unit)->getASTContext().getTranslationUnitDecl();
+  const FunctionDecl *ExternalDef = findFunctionInDeclContext(TU, LookupName);
+  // Walking the unit deserialized its declarations.
+  updateUnitSize(*Unit);
+  if (!ExternalDef) {
+    evictUnits(nullptr);
+    return Fail(
+        llvm::make_error<IndexError>(index_error_code::missing_definition));
+  }
+
+  llvm::Expected<const FunctionDecl *> Result =
+      importDefinition(ExternalDef, *Unit);
+  if (!Result)
+    return Fail(Result.takeError());
+  ImportedDefinitions[LookupName] = *Result;
+  return Result;
+}
+
+llvm::Expected<ASTUnit *>
+CrossTranslationUnitContext::loadExternalAST(StringRef LookupName,
+                                             StringRef CrossTUDir,
+                                             StringRef IndexName) {
+  auto IndexIt = Indexes.find(IndexName);
+  if (IndexIt == Indexes.end()) {
+    SmallString<256> IndexFile = CrossTUDir;
+    if (llvm::sys::path::is_absolute(IndexName))
+      IndexFile = IndexName;
+    else
+      llvm::sys::path::append(IndexFile, IndexName);
+    llvm::Expected<llvm::StringMap<std::string>> Index =
+        parseCrossTUIndex(IndexFile, CrossTUDir);
+    if (!Index) {
+      // Do not parse a broken index again; every later lookup will report
+      // a missing definition.
+      Indexes[IndexName];
+      return Index.takeError();
+    }
+    IndexIt = Indexes.insert(std::make_pair(IndexName, std::move(*Index)))
+                  .first;
+  }
+
+  auto FileIt = IndexIt->second.find(LookupName);
+  if (FileIt == IndexIt->second.end())
+    return llvm::make_error<IndexError>(index_error_code::missing_definition);
+  StringRef ASTFileName = FileIt->second;
+
+  auto Cached = UnitsByFile.find(ASTFileName);
+  if (Cached != UnitsByFile.end()) {
+    touch(Cached->second);
+    return Cached->second->Unit.get();
+  }
+
+  IntrusiveRefCntPtr<DiagnosticOptions> DiagOpts = new DiagnosticOptions();
+  TextDiagnosticPrinter *DiagClient =
+      new TextDiagnosticPrinter(llvm::errs(), &*DiagOpts);
+  IntrusiveRefCntPtr<DiagnosticIDs> DiagID(new DiagnosticIDs());
+  IntrusiveRefCntPtr<DiagnosticsEngine> Diags(
+      new DiagnosticsEngine(DiagID, &*DiagOpts, DiagClient));
+
+  std::unique_ptr<ASTUnit> Unit(ASTUnit::LoadFromASTFile(
+      ASTFileName, CI.getPCHContainerReader(), Diags, CI.getFileSystemOpts()));
+  if (!Unit) {
+    ++NumNoUnit;
+    return llvm::make_error<IndexError>(
+        index_error_code::failed_to_get_external_ast, ASTFileName.str());
+  }
+  ++NumUnitsLoaded;
+
+  LoadedUnit Loaded;
+  Loaded.FileName = ASTFileName.str();
+  Loaded.Bytes = getUnitSize(*Unit);
+  Loaded.Unit = std::move(Unit);
+  Units.push_front(std::move(Loaded));
+  UnitsByFile[ASTFileName] = Units.begin();
+  UnitsByPointer[Units.front().Unit.get()] = Units.begin();
+  LoadedBytes += Units.front().Bytes;
+
+  ASTUnit *Result = Units.front().Unit.get();
+  evictUnits(Result);
+  return Result;
+}
+
+llvm::Expected<const FunctionDecl *>
+CrossTranslationUnitContext::importDefinition(const FunctionDecl *FD,
+                                              ASTUnit *Unit) {
+  auto It = UnitsByPointer.find(Unit);
+  assert(It != UnitsByPointer.end() && "Importing from an unknown unit");
+  ASTImporter &Importer = getOrCreateImporter(*It->second);
+
+  auto *ToDecl = cast_or_null<FunctionDecl>(
+      Importer.Import(const_cast<FunctionDecl *>(FD)));
+  // Importing deserialized the body and everything it refers to. The
+  // imported definition lives in the current ASTContext, so the unit itself
+  // can go if that puts it over the limit.
+  updateUnitSize(Unit);
+  evictUnits(nullptr);
+
+  const FunctionDecl *Def;
+  if (!ToDecl || !ToDecl->hasBody(Def))
+    return llvm::make_error<IndexError>(index_error_code::failed_import);
+  ++NumFunctionsImported;
+  return Def;
+}
+
+void CrossTranslationUnitContext::setMemoryLimit(uint64_t Bytes) {
+  MemoryLimit = Bytes;
+  evictUnits(nullptr);
+}
+
+ASTImporter &CrossTranslationUnitContext::getOrCreateImporter(
+    LoadedUnit &Loaded) {
+  if (!Loaded.Importer) {
+    ASTUnit &Unit = *Loaded.Unit;
+    Loaded.Importer.reset(new ASTImporter(
+        Context, Context.getSourceManager().getFileManager(),
+        Unit.getASTContext(), Unit.getFileManager(), /*MinimalImport=*/false));
+  }
+  return *Loaded.Importer;
+}
+
+uint64_t CrossTranslationUnitContext::getUnitSize(const ASTUnit &Unit) {
+  const ASTContext &UnitContext = Unit.getASTContext();
+  return UnitContext.getASTAllocatedMemory() +
+         UnitContext.getSideTableAllocatedMemory();
+}
+
+void CrossTranslationUnitContext::updateUnitSize(const ASTUnit *Unit) {
+  auto It = UnitsByPointer.find(Unit);
+  if (It == UnitsByPointer.end())
+    return;
+  LoadedUnit &Loaded = *It->second;
+  LoadedBytes -= Loaded.Bytes;
+  Loaded.Bytes = getUnitSize(*Loaded.Unit);
+  LoadedBytes += Loaded.Bytes;
+}
+
+void CrossTranslationUnitContext::touch(std::list<LoadedUnit>::iterator It) {
+  Units.splice(Units.begin(), Units, It);
+}
+
+void CrossTranslationUnitContext::evictUnits(const ASTUnit *Keep) {
+  if (!MemoryLimit)
+    return;
+  // The declarations imported from an evicted unit live in the current
+  // ASTContext, which owns copies of their identifiers and source buffers,
+  // so only the importer needs to go along with the unit.
+  auto It = Units.end();
+  while (LoadedBytes > MemoryLimit && It != Units.begin()) {
+    --It;
+    if (It->Unit.get() == Keep)
+      continue;
+    LoadedBytes -= It->Bytes;
+    UnitsByFile.erase(It->FileName);
+    UnitsByPointer.erase(It->Unit.get());
+    It = Units.erase(It);
+    ++NumUnitsEvicted;
+  }
+}
@@ -19,9 +19,13 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/CrashRecoveryContext.h"
+#include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/Program.h"
+#include "llvm/Support/Signals.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cassert>
 using namespace clang::driver;
@@ -33,7 +37,7 @@ Command::Command(const Action &Source, const Tool &Creator,
                  const char *Executable, const ArgStringList &Arguments,
                  ArrayRef<InputInfo> Inputs)
     : Source(Source), Creator(Creator), Executable(Executable),
-      Arguments(Arguments), ResponseFile(nullptr) {
+      Arguments(Arguments), ResponseFile(nullptr), InProcess(false) {
   for (const auto &II : Inputs)
     if (II.isFilename())
       InputFilenames.push_back(II.getFilename());
@@ -356,6 +360,46 @@ int Command::Execute(const StringRef **Redirects, std::string *ErrMsg,
                                    /*memoryLimit*/ 0, ErrMsg, ExecutionFailed);
 }
 
+CC1Command::CC1Command(const Action &Source_, const Tool &Creator_,
+                       const char *Executable_,
+                       const ArgStringList &Arguments_,
+                       ArrayRef<InputInfo> Inputs)
+    : Command(Source_, Creator_, Executable_, Arguments_, Inputs) {
+  setInProcess(true);
+}
+
+int CC1Command::Execute(const StringRef **Redirects, std::string *ErrMsg,
+                        bool *ExecutionFailed) const {
+  // Redirected output needs a process of its own.
+  const Driver &D = getCreator().getToolChain().getDriver();
+  if (!isInProcess() || !D.CC1Main || Redirects)
+    return Command::Execute(Redirects, ErrMsg, ExecutionFailed);
+
+  // There is no command line length limit to work around, so a response file
+  // is never needed here.
+  SmallVector<const char *, 128> Argv;
+  Argv.push_back(getExecutable());
+  Argv.append(getArguments().begin(), getArguments().end());
+
+  if (ExecutionFailed)
+    *ExecutionFailed = false;
+
+  llvm::CrashRecoveryContext::Enable();
+  llvm::CrashRecoveryContext CRC;
+  const void *PrettyState = llvm::SavePrettyStackState();
+  int Res = 0;
+  if (CRC.RunSafely([&] { Res = D.CC1Main(Argv); }))
+    return Res;
+
+  // The frontend crashed, or hit a fatal error that asked for crash
+  // diagnostics. Undo what it left behind, remove its partial outputs the way
+  // a signal would have, and report it the way a crashed process is reported.
+  llvm::RestorePrettyStackState(PrettyState);
+  llvm::remove_fatal_error_handler();
+  llvm::sys::RunInterruptHandlers();
+  return -1;
+}
+
 FallbackCommand::FallbackCommand(const Action &Source_, const Tool &Creator_,
                                  const char *Executable_,
                                  const ArgStringList &Arguments_,
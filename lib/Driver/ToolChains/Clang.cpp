@@ -2021,6 +2021,20 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
       CmdArgs.push_back("-emit-pch");
     else
       CmdArgs.push_back("-emit-pth");
+
+    // Code emitted into the PCH object file replaces the per-TU copies, so
+    // instantiate templates up front when it is requested.
+    bool PCHCodegen =
+        Args.hasFlag(options::OPT_fpch_codegen, options::OPT_fno_pch_codegen,
+                     false);
+    if (Args.hasFlag(options::OPT_fpch_instantiate_templates,
+                     options::OPT_fno_pch_instantiate_templates, PCHCodegen))
+      CmdArgs.push_back("-fpch-instantiate-templates");
+    if (PCHCodegen)
+      CmdArgs.push_back("-fmodules-codegen");
+    if (Args.hasFlag(options::OPT_fpch_debuginfo,
+                     options::OPT_fno_pch_debuginfo, false))
+      CmdArgs.push_back("-fmodules-debuginfo");
   } else if (isa<VerifyPCHJobAction>(JA)) {
     CmdArgs.push_back("-verify-pch");
   } else {
@@ -2821,6 +2835,20 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
     CmdArgs.push_back("-generate-type-units");
   }
 
+  // -fcompact-reflection-debug-info describes the reflection library's types
+  // and fragment types by declarations only.
+  if (Args.hasFlag(options::OPT_fcompact_reflection_debug_info,
+                   options::OPT_fno_compact_reflection_debug_info, false))
+    CmdArgs.push_back("-fcompact-reflection-debug-info");
+
+  // -fdebug-injection-origins attributes injected functions to the fragments
+  // and metaprograms that generated them.
+  if (Args.hasFlag(options::OPT_fdebug_injection_origins,
+                   options::OPT_fno_debug_injection_origins, false))
+    CmdArgs.push_back("-fdebug-injection-origins");
+  Args.AddLastArg(CmdArgs, options::OPT_finjection_map_EQ);
+  Args.AddLastArg(CmdArgs, options::OPT_fast_memory_report_EQ);
+
   bool UseSeparateSections = isUseSeparateSections(Triple);
 
   if (Args.hasFlag(options::OPT_ffunction_sections,
@@ -3881,6 +3909,12 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
                    options::OPT_fno_relaxed_template_template_args, false))
     CmdArgs.push_back("-frelaxed-template-template-args");
 
+  // for... statements whose expansions differ only in constants are emitted
+  // as a loop over a table of those constants unless this is turned off.
+  if (!Args.hasFlag(options::OPT_froll_expansion_statements,
+                    options::OPT_fno_roll_expansion_statements, true))
+    CmdArgs.push_back("-fno-roll-expansion-statements");
+
   // -fsized-deallocation is off by default, as it is an ABI-breaking change for
   // most platforms.
   if (Args.hasFlag(options::OPT_fsized_deallocation,
@@ -4398,7 +4432,11 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
     CmdArgs.push_back("-fwhole-program-vtables");
   }
 
-  // Finally add the compile command to the compilation.
+  // Finally add the compile command to the compilation. The crash
+  // diagnostics rerun it in a process of its own.
+  bool IntegratedCC1 = Args.hasFlag(options::OPT_fintegrated_cc1,
+                                    options::OPT_fno_integrated_cc1, false) &&
+                       D.CC1Main && !D.CCGenDiagnostics;
   if (Args.hasArg(options::OPT__SLASH_fallback) &&
       Output.getType() == types::TY_Object &&
       (InputType == types::TY_C || InputType == types::TY_CXX)) {
@@ -4412,6 +4450,9 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
     // fails, so that the main compilation's fallback to cl.exe runs.
     C.addCommand(llvm::make_unique<ForceSuccessCommand>(JA, *this, Exec,
                                                         CmdArgs, Inputs));
+  } else if (IntegratedCC1) {
+    C.addCommand(
+        llvm::make_unique<CC1Command>(JA, *this, Exec, CmdArgs, Inputs));
   } else {
     C.addCommand(llvm::make_unique<Command>(JA, *this, Exec, CmdArgs, Inputs));
   }
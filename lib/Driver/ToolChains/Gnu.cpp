@@ -14,6 +14,7 @@
 #include "Arch/Sparc.h"
 #include "Arch/SystemZ.h"
 #include "CommonArgs.h"
+#include "clang/Basic/Version.h"
 #include "clang/Basic/VirtualFileSystem.h"
 #include "clang/Config/config.h" // for GCC_INSTALL_PREFIX
 #include "clang/Driver/Compilation.h"
@@ -23,8 +24,12 @@
 #include "clang/Driver/Tool.h"
 #include "llvm/Option/ArgList.h"
 #include "llvm/Support/CodeGen.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TargetParser.h"
+#include "llvm/Support/raw_ostream.h"
 #include <system_error>
 
 using namespace clang::driver;
@@ -1665,7 +1670,8 @@ void Generic_GCC::GCCInstallationDetector::init(
   // if --gcc-toolchain is not provided or equal to the Gentoo install
   // in /usr. This avoids accidentally enforcing the system GCC version
   // when using a custom toolchain.
-  if (GCCToolchainDir == "" || GCCToolchainDir == D.SysRoot + "/usr") {
+  if ((GCCToolchainDir == "" || GCCToolchainDir == D.SysRoot + "/usr") &&
+      D.getVFS().exists(D.SysRoot + "/etc/env.d/gcc")) {
     for (StringRef CandidateTriple : ExtraTripleAliases) {
       if (ScanGentooGccConfig(TargetTriple, Args, CandidateTriple))
         return;
@@ -1680,30 +1686,76 @@ void Generic_GCC::GCCInstallationDetector::init(
     }
   }
 
-  // Loop over the various components which exist and select the best GCC
-  // installation available. GCC installs are ranked by version number.
-  Version = GCCVersion::Parse("0.0.0");
-  for (const std::string &Prefix : Prefixes) {
-    if (!D.getVFS().exists(Prefix))
-      continue;
-    for (StringRef Suffix : CandidateLibDirs) {
-      const std::string LibDir = Prefix + Suffix.str();
-      if (!D.getVFS().exists(LibDir))
-        continue;
-      for (StringRef Candidate : ExtraTripleAliases) // Try these first.
-        ScanLibDirForGCCTriple(TargetTriple, Args, LibDir, Candidate);
-      for (StringRef Candidate : CandidateTripleAliases)
-        ScanLibDirForGCCTriple(TargetTriple, Args, LibDir, Candidate);
+  // Scanning the lib directories is what takes the time, so it can be cached
+  // across driver invocations. Which of the installations found is usable
+  // depends on the multilib flags, so that is always decided afresh.
+  SmallString<128> CachePath;
+  std::string CacheKey;
+  if (const Arg *A = Args.getLastArg(options::OPT_gcc_install_cache)) {
+    if (TargetTriple.getOS() != llvm::Triple::Solaris) {
+      llvm::raw_string_ostream OS(CacheKey);
+      OS << getClangFullVersion() << '\t' << TargetTriple.str();
+      for (StringRef Alias : ExtraTripleAliases)
+        OS << '\t' << Alias;
+      OS << "\t-";
+      for (const std::string &Prefix : Prefixes)
+        OS << '\t' << Prefix;
+      OS.flush();
+
+      llvm::MD5 Hash;
+      Hash.update(CacheKey);
+      llvm::MD5::MD5Result Result;
+      Hash.final(Result);
+      SmallString<32> HashText;
+      llvm::MD5::stringifyResult(Result, HashText);
+      CachePath = A->getValue();
+      llvm::sys::path::append(CachePath,
+                              "gcc-install-" + HashText.str() + ".txt");
     }
-    for (StringRef Suffix : CandidateBiarchLibDirs) {
-      const std::string LibDir = Prefix + Suffix.str();
-      if (!D.getVFS().exists(LibDir))
+  }
+
+  // Loop over the various components which exist and collect the GCC
+  // installations available.
+  Version = GCCVersion::Parse("0.0.0");
+  std::vector<GCCInstallCandidate> Candidates;
+  if (CachePath.empty() || !readInstallCache(CachePath, CacheKey, Candidates)) {
+    RecordScannedDirs = !CachePath.empty();
+    for (const std::string &Prefix : Prefixes) {
+      watchScannedDir(Prefix);
+      if (!D.getVFS().exists(Prefix))
         continue;
-      for (StringRef Candidate : CandidateBiarchTripleAliases)
-        ScanLibDirForGCCTriple(TargetTriple, Args, LibDir, Candidate,
-                               /*NeedsBiarchSuffix=*/ true);
+      for (StringRef Suffix : CandidateLibDirs) {
+        const std::string LibDir = Prefix + Suffix.str();
+        watchScannedDir(LibDir);
+        if (!D.getVFS().exists(LibDir))
+          continue;
+        for (StringRef Candidate : ExtraTripleAliases) // Try these first.
+          ScanLibDirForGCCTriple(TargetTriple, Args, LibDir, Candidate,
+                                 Candidates);
+        for (StringRef Candidate : CandidateTripleAliases)
+          ScanLibDirForGCCTriple(TargetTriple, Args, LibDir, Candidate,
+                                 Candidates);
+      }
+      for (StringRef Suffix : CandidateBiarchLibDirs) {
+        const std::string LibDir = Prefix + Suffix.str();
+        watchScannedDir(LibDir);
+        if (!D.getVFS().exists(LibDir))
+          continue;
+        for (StringRef Candidate : CandidateBiarchTripleAliases)
+          ScanLibDirForGCCTriple(TargetTriple, Args, LibDir, Candidate,
+                                 Candidates, /*NeedsBiarchSuffix=*/ true);
+      }
     }
+    if (RecordScannedDirs)
+      writeInstallCache(CachePath, CacheKey, Candidates);
+    RecordScannedDirs = false;
+    ScannedDirs.clear();
   }
+
+  // Select the best GCC installation available. GCC installs are ranked by
+  // version number.
+  for (const GCCInstallCandidate &Candidate : Candidates)
+    SelectGCCInstallation(TargetTriple, Args, Candidate);
 }
 
 void Generic_GCC::GCCInstallationDetector::print(raw_ostream &OS) const {
@@ -2070,7 +2122,7 @@ bool Generic_GCC::GCCInstallationDetector::ScanGCCForMultilibs(
 void Generic_GCC::GCCInstallationDetector::ScanLibDirForGCCTriple(
     const llvm::Triple &TargetTriple, const ArgList &Args,
     const std::string &LibDir, StringRef CandidateTriple,
-    bool NeedsBiarchSuffix) {
+    std::vector<GCCInstallCandidate> &Candidates, bool NeedsBiarchSuffix) {
   if (TargetTriple.getOS() == llvm::Triple::Solaris) {
     scanLibDirForGCCTripleSolaris(TargetTriple, Args, LibDir, CandidateTriple,
                                   NeedsBiarchSuffix);
@@ -2120,6 +2172,7 @@ void Generic_GCC::GCCInstallationDetector::ScanLibDirForGCCTriple(
       continue;
 
     StringRef LibSuffix = Suffix.LibSuffix;
+    watchScannedDir(LibDir + "/" + LibSuffix.str());
     std::error_code EC;
     for (vfs::directory_iterator
              LI = D.getVFS().dir_begin(LibDir + "/" + LibSuffix, EC),
@@ -2127,28 +2180,162 @@ void Generic_GCC::GCCInstallationDetector::ScanLibDirForGCCTriple(
          !EC && LI != LE; LI = LI.increment(EC)) {
       StringRef VersionText = llvm::sys::path::filename(LI->getName());
       GCCVersion CandidateVersion = GCCVersion::Parse(VersionText);
-      if (CandidateVersion.Major != -1) // Filter obviously bad entries.
-        if (!CandidateGCCInstallPaths.insert(LI->getName()).second)
-          continue; // Saw this path before; no need to look at it again.
-      if (CandidateVersion.isOlderThan(4, 1, 1))
-        continue;
-      if (CandidateVersion <= Version)
-        continue;
-
-      if (!ScanGCCForMultilibs(TargetTriple, Args, LI->getName(),
-                               NeedsBiarchSuffix))
+      if (CandidateVersion.Major == -1) // Filter obviously bad entries.
         continue;
+      if (!CandidateGCCInstallPaths.insert(LI->getName()).second)
+        continue; // Saw this path before; no need to look at it again.
 
-      Version = CandidateVersion;
-      GCCTriple.setTriple(CandidateTriple);
+      GCCInstallCandidate Candidate;
+      Candidate.Path = LI->getName();
       // FIXME: We hack together the directory name here instead of
       // using LI to ensure stable path separators across Windows and
       // Linux.
-      GCCInstallPath = (LibDir + "/" + LibSuffix + "/" + VersionText).str();
-      GCCParentLibPath = (GCCInstallPath + "/../" + Suffix.ReversePath).str();
-      IsValid = true;
+      Candidate.InstallPath =
+          (LibDir + "/" + LibSuffix + "/" + VersionText).str();
+      Candidate.ParentLibPath =
+          (Candidate.InstallPath + "/../" + Suffix.ReversePath).str();
+      Candidate.Triple = CandidateTriple;
+      Candidate.VersionText = VersionText;
+      Candidate.NeedsBiarchSuffix = NeedsBiarchSuffix;
+      Candidates.push_back(std::move(Candidate));
+    }
+  }
+}
+
+void Generic_GCC::GCCInstallationDetector::SelectGCCInstallation(
+    const llvm::Triple &TargetTriple, const ArgList &Args,
+    const GCCInstallCandidate &Candidate) {
+  GCCVersion CandidateVersion = GCCVersion::Parse(Candidate.VersionText);
+  if (CandidateVersion.isOlderThan(4, 1, 1))
+    return;
+  if (CandidateVersion <= Version)
+    return;
+
+  if (!ScanGCCForMultilibs(TargetTriple, Args, Candidate.Path,
+                           Candidate.NeedsBiarchSuffix))
+    return;
+
+  Version = CandidateVersion;
+  GCCTriple.setTriple(Candidate.Triple);
+  GCCInstallPath = Candidate.InstallPath;
+  GCCParentLibPath = Candidate.ParentLibPath;
+  IsValid = true;
+}
+
+void Generic_GCC::GCCInstallationDetector::watchScannedDir(StringRef Path) {
+  if (!RecordScannedDirs)
+    return;
+  // A path that does not exist stays that way for as long as its closest
+  // existing ancestor is not modified.
+  for (StringRef Dir = Path; !Dir.empty();
+       Dir = llvm::sys::path::parent_path(Dir)) {
+    llvm::ErrorOr<vfs::Status> Status = D.getVFS().status(Dir);
+    if (Status) {
+      ScannedDirs[Dir] = Status->getLastModificationTime();
+      return;
+    }
+  }
+}
+
+// An installation cache file starts with a line holding the cache key. Then
+// come "dir" lines with the modification time of each directory the scan
+// looked at, and "candidate" lines with the installations it found, in order.
+// Fields are separated by tabs.
+
+bool Generic_GCC::GCCInstallationDetector::readInstallCache(
+    StringRef CachePath, StringRef Key,
+    std::vector<GCCInstallCandidate> &Candidates) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> File =
+      llvm::MemoryBuffer::getFile(CachePath);
+  if (!File)
+    return false;
+
+  SmallVector<StringRef, 32> Lines;
+  File.get()->getBuffer().split(Lines, "\n", /*MaxSplit=*/-1,
+                                /*KeepEmpty=*/false);
+  if (Lines.empty() || Lines[0] != Key)
+    return false;
+  std::vector<GCCInstallCandidate> Cached;
+  for (StringRef Line : llvm::makeArrayRef(Lines).drop_front()) {
+    SmallVector<StringRef, 7> Fields;
+    Line.split(Fields, '\t');
+    if (Fields[0] == "dir" && Fields.size() == 3) {
+      long long ModTime;
+      if (Fields[1].getAsInteger(10, ModTime))
+        return false;
+      llvm::ErrorOr<vfs::Status> Status = D.getVFS().status(Fields[2]);
+      if (!Status ||
+          Status->getLastModificationTime().time_since_epoch().count() !=
+              ModTime)
+        return false;
+    } else if (Fields[0] == "candidate" && Fields.size() == 7) {
+      GCCInstallCandidate Candidate;
+      Candidate.NeedsBiarchSuffix = Fields[1] == "1";
+      Candidate.Triple = Fields[2];
+      Candidate.VersionText = Fields[3];
+      Candidate.Path = Fields[4];
+      Candidate.InstallPath = Fields[5];
+      Candidate.ParentLibPath = Fields[6];
+      Cached.push_back(std::move(Candidate));
+    } else {
+      return false;
+    }
+  }
+
+  for (const GCCInstallCandidate &Candidate : Cached)
+    CandidateGCCInstallPaths.insert(Candidate.Path);
+  Candidates = std::move(Cached);
+  return true;
+}
+
+void Generic_GCC::GCCInstallationDetector::writeInstallCache(
+    StringRef CachePath, StringRef Key,
+    ArrayRef<GCCInstallCandidate> Candidates) const {
+  // A directory modified in the last few seconds might be modified again
+  // without its (possibly coarse) modification time changing.
+  auto Recent = std::chrono::system_clock::now() - std::chrono::seconds(2);
+  auto HasSeparator = [](StringRef Field) {
+    return Field.find_first_of("\t\n") != StringRef::npos;
+  };
+  if (Key.find('\n') != StringRef::npos)
+    return;
+  for (const auto &Dir : ScannedDirs)
+    if (Dir.getValue() > Recent || HasSeparator(Dir.getKey()))
+      return;
+  for (const GCCInstallCandidate &Candidate : Candidates)
+    if (HasSeparator(Candidate.Path) || HasSeparator(Candidate.InstallPath) ||
+        HasSeparator(Candidate.ParentLibPath) ||
+        HasSeparator(Candidate.Triple))
+      return;
+
+  // The cache is only an optimization, so any failure to write it is
+  // ignored. Write a temporary file and move it into place, so that
+  // concurrent drivers never read half an entry.
+  llvm::sys::fs::create_directories(llvm::sys::path::parent_path(CachePath));
+  int FD;
+  SmallString<128> TempPath;
+  if (llvm::sys::fs::createUniqueFile(CachePath + "-%%%%%%%%", FD, TempPath))
+    return;
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    OS << Key << '\n';
+    for (const auto &Dir : ScannedDirs)
+      OS << "dir\t" << Dir.getValue().time_since_epoch().count() << '\t'
+         << Dir.getKey() << '\n';
+    for (const GCCInstallCandidate &Candidate : Candidates)
+      OS << "candidate\t" << (Candidate.NeedsBiarchSuffix ? "1" : "0") << '\t'
+         << Candidate.Triple << '\t' << Candidate.VersionText << '\t'
+         << Candidate.Path << '\t' << Candidate.InstallPath << '\t'
+         << Candidate.ParentLibPath << '\n';
+    OS.close();
+    if (OS.has_error()) {
+      OS.clear_error();
+      llvm::sys::fs::remove(TempPath);
+      return;
     }
   }
+  if (llvm::sys::fs::rename(TempPath, CachePath))
+    llvm::sys::fs::remove(TempPath);
 }
 
 bool Generic_GCC::GCCInstallationDetector::ScanGentooGccConfig(
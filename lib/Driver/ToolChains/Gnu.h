@@ -13,6 +13,8 @@
 #include "Cuda.h"
 #include "clang/Driver/Tool.h"
 #include "clang/Driver/ToolChain.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Chrono.h"
 #include <set>
 
 namespace clang {
@@ -208,8 +210,29 @@ public:
     /// The set of multilibs that the detected installation supports.
     MultilibSet Multilibs;
 
+    /// While a scan is being recorded for the installation cache, the
+    /// directories it looked at, mapped to their modification times. Paths
+    /// that do not exist are represented by their closest existing ancestor.
+    llvm::StringMap<llvm::sys::TimePoint<>> ScannedDirs;
+    bool RecordScannedDirs;
+
   public:
-    explicit GCCInstallationDetector(const Driver &D) : IsValid(false), D(D) {}
+    /// \brief A versioned directory that a scan found under one of the
+    /// candidate lib directories, in the order the scan found it.
+    ///
+    /// Whether it is usable depends on the multilibs it provides for the
+    /// command line, so that is decided afterwards.
+    struct GCCInstallCandidate {
+      std::string Path;
+      std::string InstallPath;
+      std::string ParentLibPath;
+      std::string Triple;
+      std::string VersionText;
+      bool NeedsBiarchSuffix;
+    };
+
+    explicit GCCInstallationDetector(const Driver &D)
+        : IsValid(false), D(D), RecordScannedDirs(false) {}
     void init(const llvm::Triple &TargetTriple, const llvm::opt::ArgList &Args,
               ArrayRef<std::string> ExtraTripleAliases = None);
 
@@ -259,8 +282,21 @@ public:
                                 const llvm::opt::ArgList &Args,
                                 const std::string &LibDir,
                                 StringRef CandidateTriple,
+                                std::vector<GCCInstallCandidate> &Candidates,
                                 bool NeedsBiarchSuffix = false);
 
+    void SelectGCCInstallation(const llvm::Triple &TargetTriple,
+                               const llvm::opt::ArgList &Args,
+                               const GCCInstallCandidate &Candidate);
+
+    /// \brief Note that the scan looked at \p Path, if it is being recorded.
+    void watchScannedDir(StringRef Path);
+
+    bool readInstallCache(StringRef CachePath, StringRef Key,
+                          std::vector<GCCInstallCandidate> &Candidates);
+    void writeInstallCache(StringRef CachePath, StringRef Key,
+                           ArrayRef<GCCInstallCandidate> Candidates) const;
+
     void scanLibDirForGCCTripleSolaris(const llvm::Triple &TargetArch,
                                        const llvm::opt::ArgList &Args,
                                        const std::string &LibDir,
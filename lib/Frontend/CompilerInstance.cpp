@@ -28,6 +28,7 @@
 #include "clang/Frontend/Utils.h"
 #include "clang/Frontend/VerifyDiagnosticConsumer.h"
 #include "clang/Lex/HeaderSearch.h"
+#include "clang/Lex/IncludePrefetcher.h"
 #include "clang/Lex/PTHManager.h"
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Lex/PreprocessorOptions.h"
@@ -304,7 +305,15 @@ void CompilerInstance::createFileManager() {
     // TODO: choose the virtual file system based on the CompilerInvocation.
     setVirtualFileSystem(vfs::getRealFileSystem());
   }
-  FileMgr = new FileManager(getFileSystemOpts(), VirtualFileSystem);
+  IntrusiveRefCntPtr<vfs::FileSystem> FS = VirtualFileSystem;
+  // The prefetcher reads from the underlying file system on its own thread,
+  // which is only known to be safe when no VFS overlay is involved.
+  if (getPreprocessorOpts().PrefetchIncludes &&
+      getHeaderSearchOpts().VFSOverlayFiles.empty()) {
+    Prefetcher = new IncludePrefetcher(VirtualFileSystem, getLangOpts());
+    FS = Prefetcher;
+  }
+  FileMgr = new FileManager(getFileSystemOpts(), FS);
 }
 
 // Source Manager
@@ -413,6 +422,11 @@ void CompilerInstance::createPreprocessor(TranslationUnitKind TUKind) {
   ApplyHeaderSearchOptions(PP->getHeaderSearchInfo(), getHeaderSearchOpts(),
                            PP->getLangOpts(), *HeaderSearchTriple);
 
+  if (Prefetcher) {
+    Prefetcher->start(PP->getHeaderSearchInfo());
+    PP->addPPCallbacks(Prefetcher->createPPCallbacks(getSourceManager()));
+  }
+
   PP->setPreprocessedOutput(getPreprocessorOutputOpts().ShowCPP);
 
   if (PP->getLangOpts().Modules && PP->getLangOpts().ImplicitModules)
@@ -482,6 +496,8 @@ void CompilerInstance::createASTContext() {
   auto *Context = new ASTContext(getLangOpts(), PP.getSourceManager(),
                                  PP.getIdentifierTable(), PP.getSelectorTable(),
                                  PP.getBuiltinInfo());
+  if (!getFrontendOpts().ASTMemoryReportFile.empty())
+    Context->enableMemoryReport();
   Context->InitBuiltinTypes(getTarget(), getAuxTarget());
   setASTContext(Context);
 }
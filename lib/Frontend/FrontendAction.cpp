@@ -19,6 +19,7 @@
 #include "clang/Frontend/MultiplexConsumer.h"
 #include "clang/Frontend/Utils.h"
 #include "clang/Lex/HeaderSearch.h"
+#include "clang/Lex/IncludePrefetcher.h"
 #include "clang/Lex/LiteralSupport.h"
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Lex/PreprocessorOptions.h"
@@ -863,6 +864,20 @@ void FrontendAction::EndSourceFile() {
   // Finalize the action.
   EndSourceFileAction();
 
+  // Write the AST memory report while the AST is still alive.
+  StringRef ReportFile = CI.getFrontendOpts().ASTMemoryReportFile;
+  if (!ReportFile.empty() && CI.hasASTContext()) {
+    if (ASTMemoryReport *Report = CI.getASTContext().getMemoryReport()) {
+      std::error_code EC;
+      llvm::raw_fd_ostream OS(ReportFile, EC, llvm::sys::fs::F_Text);
+      if (EC)
+        CI.getDiagnostics().Report(diag::err_fe_unable_to_open_output)
+            << ReportFile << EC.message();
+      else
+        Report->print(OS, CI.getASTContext());
+    }
+  }
+
   // Sema references the ast consumer, so reset sema first.
   //
   // FIXME: There is more per-file stuff we could just drop here?
@@ -883,6 +898,8 @@ void FrontendAction::EndSourceFile() {
     CI.getPreprocessor().getIdentifierTable().PrintStats();
     CI.getPreprocessor().getHeaderSearchInfo().PrintStats();
     CI.getSourceManager().PrintStats();
+    if (IncludePrefetcher *Prefetcher = CI.getIncludePrefetcher())
+      Prefetcher->PrintStats();
     llvm::errs() << "\n";
   }
 
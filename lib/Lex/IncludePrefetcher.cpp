@@ -0,0 +1,347 @@
+//===--- IncludePrefetcher.cpp - Read headers ahead of the lexer ----------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements the IncludePrefetcher file system.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Lex/IncludePrefetcher.h"
+#include "clang/Basic/SourceManager.h"
+#include "clang/Lex/DirectoryLookup.h"
+#include "clang/Lex/HeaderSearch.h"
+#include "clang/Lex/Lexer.h"
+#include "clang/Lex/PPCallbacks.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace clang;
+
+namespace {
+
+/// \brief A file whose contents were read by the producer thread.
+class PrefetchedVFSFile : public vfs::File {
+  vfs::Status S;
+  std::unique_ptr<llvm::MemoryBuffer> Buffer;
+  IntrusiveRefCntPtr<vfs::FileSystem> FS;
+
+public:
+  PrefetchedVFSFile(vfs::Status S, std::unique_ptr<llvm::MemoryBuffer> Buffer,
+                    IntrusiveRefCntPtr<vfs::FileSystem> FS)
+      : S(std::move(S)), Buffer(std::move(Buffer)), FS(std::move(FS)) {}
+
+  llvm::ErrorOr<vfs::Status> status() override { return S; }
+
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
+  getBuffer(const Twine &Name, int64_t FileSize, bool RequiresNullTerminator,
+            bool IsVolatile) override {
+    // Prefetched buffers are always null terminated, but can only be handed
+    // out once.
+    if (Buffer)
+      return std::move(Buffer);
+    return FS->getBufferForFile(Name, FileSize, RequiresNullTerminator,
+                                IsVolatile);
+  }
+
+  std::error_code close() override { return std::error_code(); }
+};
+
+/// \brief Keeps the producer following the files the preprocessor enters,
+/// including those it could not predict.
+class PrefetchCallbacks : public PPCallbacks {
+  IncludePrefetcher &Prefetcher;
+  SourceManager &SM;
+
+public:
+  PrefetchCallbacks(IncludePrefetcher &Prefetcher, SourceManager &SM)
+      : Prefetcher(Prefetcher), SM(SM) {}
+
+  void FileChanged(SourceLocation Loc, FileChangeReason Reason,
+                   SrcMgr::CharacteristicKind FileType,
+                   FileID PrevFID) override {
+    if (Reason != EnterFile)
+      return;
+    // Everything else is predicted from the main file, so have it scanned
+    // before the preprocessor gets to its first #include.
+    FileID FID = SM.getFileID(Loc);
+    if (const FileEntry *FE = SM.getFileEntryForID(FID))
+      Prefetcher.enqueue(FE->getName(), FID == SM.getMainFileID());
+  }
+
+  void EndOfMainFile() override { Prefetcher.stop(); }
+};
+
+} // end anonymous namespace
+
+IncludePrefetcher::IncludePrefetcher(IntrusiveRefCntPtr<vfs::FileSystem> FS,
+                                     const LangOptions &LangOpts)
+    : Underlying(std::move(FS)), LangOpts(LangOpts), PrefetchedBytes(0),
+      Stopping(true), NumPrefetched(0), NumHits(0), NumStale(0) {}
+
+IncludePrefetcher::~IncludePrefetcher() { stop(); }
+
+void IncludePrefetcher::start(const HeaderSearch &HS) {
+#if LLVM_ENABLE_THREADS
+  if (Producer.joinable())
+    return;
+
+  // Nothing else runs while the producer is stopped.
+  Stopping = false;
+  Scanned.clear();
+  QuotedDirs.clear();
+  AngledDirs.clear();
+  for (auto I = HS.quoted_dir_begin(), E = HS.quoted_dir_end(); I != E; ++I)
+    if (const DirectoryEntry *Dir = I->getDir())
+      QuotedDirs.push_back(Dir->getName());
+  for (auto I = HS.angled_dir_begin(), E = HS.search_dir_end(); I != E; ++I)
+    if (const DirectoryEntry *Dir = I->getDir())
+      AngledDirs.push_back(Dir->getName());
+
+  Producer = std::thread([this] { run(); });
+#endif
+}
+
+void IncludePrefetcher::stop() {
+  {
+    std::lock_guard<std::mutex> Guard(Lock);
+    Stopping = true;
+    Queue.clear();
+  }
+  QueueChanged.notify_all();
+  ScanFinished.notify_all();
+#if LLVM_ENABLE_THREADS
+  if (Producer.joinable())
+    Producer.join();
+#endif
+
+  std::lock_guard<std::mutex> Guard(Lock);
+  Prefetched.clear();
+  PrefetchedBytes = 0;
+}
+
+void IncludePrefetcher::enqueue(StringRef Path, bool Wait) {
+  std::unique_lock<std::mutex> Guard(Lock);
+  if (Stopping)
+    return;
+  Queue.emplace_back(Path, /*Keep=*/false);
+  QueueChanged.notify_one();
+  if (Wait)
+    waitFor(Path, /*KeptOnly=*/false, Guard);
+}
+
+bool IncludePrefetcher::isPending(StringRef Path, bool KeptOnly) const {
+  auto Matches = [&](const std::pair<std::string, bool> &Entry) {
+    return Entry.first == Path && (Entry.second || !KeptOnly);
+  };
+  return Matches(Scanning) || llvm::any_of(Queue, Matches);
+}
+
+void IncludePrefetcher::waitFor(StringRef Path, bool KeptOnly,
+                                std::unique_lock<std::mutex> &Guard) {
+  auto Queued = llvm::find_if(
+      Queue, [&](const std::pair<std::string, bool> &Entry) {
+        return Entry.first == Path;
+      });
+  if (Queued != Queue.end() && Queued != Queue.begin()) {
+    auto Entry = std::move(*Queued);
+    Queue.erase(Queued);
+    Queue.push_front(std::move(Entry));
+  }
+  ScanFinished.wait(
+      Guard, [&] { return Stopping || !isPending(Path, KeptOnly); });
+}
+
+std::unique_ptr<PPCallbacks>
+IncludePrefetcher::createPPCallbacks(SourceManager &SM) {
+  return llvm::make_unique<PrefetchCallbacks>(*this, SM);
+}
+
+void IncludePrefetcher::run() {
+  while (true) {
+    std::pair<std::string, bool> Next;
+    {
+      std::unique_lock<std::mutex> Guard(Lock);
+      QueueChanged.wait(Guard, [this] { return Stopping || !Queue.empty(); });
+      if (Stopping)
+        return;
+      Next = std::move(Queue.front());
+      Queue.pop_front();
+      Scanning = Next;
+    }
+    if (Scanned.insert(Next.first).second)
+      scan(Next.first, Next.second);
+    {
+      std::lock_guard<std::mutex> Guard(Lock);
+      Scanning = std::pair<std::string, bool>();
+    }
+    ScanFinished.notify_all();
+  }
+}
+
+void IncludePrefetcher::scan(StringRef Path, bool Keep) {
+  auto Status = Underlying->status(Path);
+  if (!Status || !Status->isRegularFile())
+    return;
+  auto Buffer = Underlying->getBufferForFile(Path, Status->getSize());
+  if (!Buffer)
+    return;
+
+  // Find the #include directives the same way the preamble computation does;
+  // we have no identifier table, so look at the raw directive names.
+  const llvm::MemoryBuffer &Buf = **Buffer;
+  Lexer TheLexer(SourceLocation(), LangOpts, Buf.getBufferStart(),
+                 Buf.getBufferStart(), Buf.getBufferEnd());
+  Token TheTok;
+  do {
+    TheLexer.LexFromRawLexer(TheTok);
+    if (!TheTok.isAtStartOfLine() || TheTok.isNot(tok::hash))
+      continue;
+
+    TheLexer.LexFromRawLexer(TheTok);
+    if (TheTok.isNot(tok::raw_identifier) || TheTok.needsCleaning() ||
+        TheTok.isAtStartOfLine())
+      continue;
+    bool IsInclude = llvm::StringSwitch<bool>(TheTok.getRawIdentifier())
+                         .Cases("include", "include_next", "import", true)
+                         .Default(false);
+    if (!IsInclude)
+      continue;
+
+    // Header names are not tokens in raw mode, so read the characters.
+    const char *Ptr = TheLexer.getBufferLocation();
+    const char *End = Buf.getBufferEnd();
+    while (Ptr != End && (*Ptr == ' ' || *Ptr == '\t'))
+      ++Ptr;
+    if (Ptr == End || (*Ptr != '"' && *Ptr != '<'))
+      continue; // #include MACRO; left to the preprocessor.
+    bool IsAngled = *Ptr == '<';
+    char Terminator = IsAngled ? '>' : '"';
+    const char *NameStart = ++Ptr;
+    while (Ptr != End && *Ptr != Terminator && *Ptr != '\n')
+      ++Ptr;
+    if (Ptr == End || *Ptr != Terminator || Ptr == NameStart)
+      continue;
+    resolve(Path, StringRef(NameStart, Ptr - NameStart), IsAngled);
+  } while (TheTok.isNot(tok::eof));
+
+  if (!Keep)
+    return;
+
+  std::lock_guard<std::mutex> Guard(Lock);
+  if (Stopping || PrefetchedBytes + Buf.getBufferSize() > MaxPrefetchedBytes)
+    return;
+  PrefetchedBytes += Buf.getBufferSize();
+  ++NumPrefetched;
+  PrefetchedFile &Entry = Prefetched[Path];
+  Entry.Status = vfs::Status::copyWithNewName(*Status, Path);
+  Entry.Buffer = std::move(*Buffer);
+}
+
+void IncludePrefetcher::resolve(StringRef Includer, StringRef Filename,
+                                bool IsAngled) {
+  SmallString<256> Candidate;
+  auto TryDir = [&](StringRef Dir) {
+    Candidate = Dir;
+    llvm::sys::path::append(Candidate, Filename);
+    if (Scanned.count(Candidate))
+      return true;
+    auto Status = Underlying->status(Candidate);
+    if (!Status || !Status->isRegularFile())
+      return false;
+    std::lock_guard<std::mutex> Guard(Lock);
+    Queue.emplace_back(Candidate.str(), /*Keep=*/true);
+    return true;
+  };
+
+  if (llvm::sys::path::is_absolute(Filename)) {
+    TryDir("");
+    return;
+  }
+
+  if (!IsAngled) {
+    // Mirror the directory name the file manager gives files that are named
+    // without one.
+    StringRef IncluderDir = llvm::sys::path::parent_path(Includer);
+    if (TryDir(IncluderDir.empty() ? "." : IncluderDir))
+      return;
+    for (const std::string &Dir : QuotedDirs)
+      if (TryDir(Dir))
+        return;
+  }
+  for (const std::string &Dir : AngledDirs)
+    if (TryDir(Dir))
+      return;
+}
+
+void IncludePrefetcher::PrintStats() const {
+  llvm::errs() << "\n*** Include Prefetcher Stats:\n";
+  llvm::errs() << NumPrefetched << " files prefetched, " << NumHits
+               << " used by the preprocessor, " << NumStale
+               << " discarded as stale.\n";
+}
+
+llvm::ErrorOr<vfs::Status> IncludePrefetcher::status(const Twine &Path) {
+  return Underlying->status(Path);
+}
+
+llvm::ErrorOr<std::unique_ptr<vfs::File>>
+IncludePrefetcher::openFileForRead(const Twine &Path) {
+  SmallString<256> Storage;
+  StringRef Name = Path.toStringRef(Storage);
+
+  PrefetchedFile Entry;
+  {
+    std::unique_lock<std::mutex> Guard(Lock);
+    if (!Stopping && isPending(Name, /*KeptOnly=*/true))
+      waitFor(Name, /*KeptOnly=*/true, Guard);
+    auto Known = Prefetched.find(Name);
+    if (Known != Prefetched.end()) {
+      Entry = std::move(Known->second);
+      PrefetchedBytes -= Entry.Buffer->getBufferSize();
+      Prefetched.erase(Known);
+    }
+  }
+
+  if (Entry.Buffer) {
+    // The file may have changed since the producer read it.
+    auto Current = Underlying->status(Name);
+    if (Current && Current->getUniqueID() == Entry.Status.getUniqueID() &&
+        Current->getSize() == Entry.Status.getSize() &&
+        Current->getLastModificationTime() ==
+            Entry.Status.getLastModificationTime()) {
+      ++NumHits;
+      return std::unique_ptr<vfs::File>(new PrefetchedVFSFile(
+          std::move(Entry.Status), std::move(Entry.Buffer), Underlying));
+    }
+    ++NumStale;
+  }
+
+  return Underlying->openFileForRead(Path);
+}
+
+vfs::directory_iterator IncludePrefetcher::dir_begin(const Twine &Dir,
+                                                     std::error_code &EC) {
+  return Underlying->dir_begin(Dir, EC);
+}
+
+std::error_code
+IncludePrefetcher::setCurrentWorkingDirectory(const Twine &Path) {
+  // Relative paths read so far no longer name the same files.
+  std::lock_guard<std::mutex> Guard(Lock);
+  Prefetched.clear();
+  PrefetchedBytes = 0;
+  return Underlying->setCurrentWorkingDirectory(Path);
+}
+
+llvm::ErrorOr<std::string>
+IncludePrefetcher::getCurrentWorkingDirectory() const {
+  return Underlying->getCurrentWorkingDirectory();
+}
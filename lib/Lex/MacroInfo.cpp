@@ -29,7 +29,9 @@ MacroInfo::MacroInfo(SourceLocation DefLoc)
     IsUsed(false),
     IsAllowRedefinitionsWithoutWarning(false),
     IsWarnIfUnused(false),
-    UsedForHeaderGuard(false) {
+    UsedForHeaderGuard(false),
+    IsExpansionCacheable(true),
+    ExpansionCache(nullptr) {
 }
 
 unsigned MacroInfo::getDefinitionLengthSlow(const SourceManager &SM) const {
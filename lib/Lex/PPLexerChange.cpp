@@ -557,6 +557,11 @@ bool Preprocessor::HandleEndOfTokenLexer(Token &Result) {
       MacroExpandingLexersStack.back().first == CurTokenLexer.get())
     removeCachedMacroExpandedTokensOfLastLexer();
 
+  // If the arguments of a function-like macro are being read, the expansion
+  // being recorded ended in its name, and it consumed the tokens after it.
+  if (ExpansionRecording.Lexer == CurTokenLexer.get())
+    FinishMacroExpansionRecording(/*Complete=*/!InMacroArgs);
+
   // Delete or cache the now-dead macro expander.
   if (NumCachedTokenLexers == TokenLexerCacheSize)
     CurTokenLexer.reset();
@@ -574,6 +579,9 @@ void Preprocessor::RemoveTopOfLexerStack() {
   assert(!IncludeMacroStack.empty() && "Ran out of stack entries to load");
 
   if (CurTokenLexer) {
+    if (ExpansionRecording.Lexer == CurTokenLexer.get())
+      FinishMacroExpansionRecording(/*Complete=*/false);
+
     // Delete or cache the now-dead macro expander.
     if (NumCachedTokenLexers == TokenLexerCacheSize)
       CurTokenLexer.reset();
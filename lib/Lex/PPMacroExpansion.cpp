@@ -470,6 +470,9 @@ bool Preprocessor::HandleMacroExpandedIdentifier(Token &Identifier,
 
   // If this is a builtin macro, like __LINE__ or _Pragma, handle it specially.
   if (MI->isBuiltinMacro()) {
+    // Builtin macros expand differently each time, and so does any macro
+    // whose expansion uses one.
+    ExpansionRecording.Cacheable = false;
     if (Callbacks)
       Callbacks->MacroExpands(Identifier, M, Identifier.getLocation(),
                               /*Args=*/nullptr);
@@ -477,6 +480,12 @@ bool Preprocessor::HandleMacroExpandedIdentifier(Token &Identifier,
     return true;
   }
 
+  // An expansion that is being recorded is only valid for as long as the
+  // macros it expands keep their definitions.
+  if (ExpansionRecording.Macro)
+    ExpansionRecording.Dependencies.push_back(
+        std::make_pair(Identifier.getIdentifierInfo(), MI));
+
   /// Args - If this is a function-like macro expansion, this contains,
   /// for each macro argument, the list of tokens that were provided to the
   /// invocation.
@@ -608,11 +617,158 @@ bool Preprocessor::HandleMacroExpandedIdentifier(Token &Identifier,
     return true;
   }
 
+  // Reuse an earlier expansion of this macro if nothing it depends on has
+  // changed, or record this one so that later expansions can.
+  if (canCacheMacroExpansion(M, MI)) {
+    if (EnterCachedMacroExpansion(Identifier, ExpansionEnd, MI))
+      return false;
+    EnterMacro(Identifier, ExpansionEnd, MI, Args);
+    StartMacroExpansionRecording(MI);
+    return false;
+  }
+
   // Start expanding the macro.
   EnterMacro(Identifier, ExpansionEnd, MI, Args);
   return false;
 }
 
+bool Preprocessor::EnterCachedMacroExpansion(Token &Identifier,
+                                             SourceLocation ILEnd,
+                                             MacroInfo *MI) {
+  const CachedMacroExpansion *Cache = MI->getExpansionCache();
+  if (!Cache)
+    return false;
+
+  for (const auto &Dep : Cache->Dependencies) {
+    const MacroInfo *Current = getMacroInfo(Dep.first);
+    if (Current != Dep.second) {
+      // A macro the expansion depends on was defined, redefined or undefined
+      // since; expand and record it again.
+      MI->setExpansionCache(nullptr);
+      return false;
+    }
+    // We are inside an expansion of one of the macros it expands.
+    if (Current && !Current->isEnabled())
+      return false;
+  }
+
+  ++NumCachedMacroExpanded;
+  if (ExpansionRecording.Macro)
+    ExpansionRecording.Dependencies.append(Cache->Dependencies.begin(),
+                                           Cache->Dependencies.end());
+
+  if (Cache->Tokens.empty()) {
+    // Propagate whitespace info as if we had pushed, then popped,
+    // a macro context.
+    Identifier.setFlag(Token::LeadingEmptyMacro);
+    PropagateLineStartLeadingSpaceInfo(Identifier);
+    return true;
+  }
+
+  unsigned NumToks = Cache->Tokens.size();
+  auto Toks = llvm::make_unique<Token[]>(NumToks);
+  std::copy(Cache->Tokens.begin(), Cache->Tokens.end(), Toks.get());
+  Toks[0].setFlagValue(Token::StartOfLine, Identifier.isAtStartOfLine());
+  Toks[0].setFlagValue(Token::LeadingSpace, Identifier.hasLeadingSpace());
+
+  // The cached tokens are at their spelling locations. Make them expansions
+  // of this macro, giving tokens that are spelled close together (such as
+  // those from one macro definition) a single source location entry.
+  SourceLocation ExpandLoc = Identifier.getLocation();
+  for (unsigned I = 0; I != NumToks;) {
+    SourceLocation ChunkLoc = Toks[I].getLocation();
+    unsigned End = I + 1;
+    int LastOffset = 0;
+    for (; End != NumToks; ++End) {
+      int Offset;
+      if (!SourceMgr.isInSameSLocAddrSpace(ChunkLoc, Toks[End].getLocation(),
+                                           &Offset) ||
+          Offset < LastOffset || Offset - LastOffset > 50)
+        break;
+      LastOffset = Offset;
+    }
+
+    SourceLocation Chunk = SourceMgr.createExpansionLoc(
+        ChunkLoc, ExpandLoc, ILEnd, LastOffset + Toks[End - 1].getLength());
+    for (unsigned J = I; J != End; ++J) {
+      int Offset = 0;
+      SourceMgr.isInSameSLocAddrSpace(ChunkLoc, Toks[J].getLocation(),
+                                      &Offset);
+      Toks[J].setLocation(Chunk.getLocWithOffset(Offset));
+    }
+    I = End;
+  }
+
+  EnterTokenStream(std::move(Toks), NumToks, /*DisableMacroExpansion=*/false);
+  return true;
+}
+
+void Preprocessor::StartMacroExpansionRecording(MacroInfo *MI) {
+  // Record one expansion at a time, and only one whose tokens go to the
+  // parser or to a directive.
+  if (ExpansionRecording.Macro || InMacroArgPreExpansion ||
+      isCodeCompletionEnabled())
+    return;
+
+  ExpansionRecording.Macro = MI;
+  ExpansionRecording.Lexer = CurTokenLexer.get();
+  ExpansionRecording.NumWarnings = Diags->getNumWarnings();
+  ExpansionRecording.Cacheable = !Diags->hasErrorOccurred();
+  ExpansionRecording.Tokens.clear();
+  ExpansionRecording.Dependencies.clear();
+}
+
+void Preprocessor::FinishMacroExpansionRecording(bool Complete) {
+  MacroExpansionRecording &R = ExpansionRecording;
+  MacroInfo *MI = R.Macro;
+  R.Macro = nullptr;
+  R.Lexer = nullptr;
+
+  if (!Complete || !R.Cacheable) {
+    MI->setExpansionCacheable(false);
+    return;
+  }
+
+  // The diagnostics would not be issued again by the cached expansion.
+  if (Diags->getNumWarnings() != R.NumWarnings || Diags->hasErrorOccurred())
+    return;
+
+  for (Token &Tok : R.Tokens) {
+    if (Tok.isAnnotation() || Tok.is(tok::code_completion))
+      return;
+    if (IdentifierInfo *II = Tok.getIdentifierInfo()) {
+      if (const MacroInfo *NameMI = getMacroInfo(II)) {
+        // A function-like macro name may be invoked by the tokens following
+        // the expansion. Any other macro name was left unexpanded because of
+        // the expansions enclosing this one.
+        if (NameMI->isFunctionLike() && !Tok.isExpandDisabled())
+          MI->setExpansionCacheable(false);
+        return;
+      }
+      R.Dependencies.push_back(std::make_pair(II, nullptr));
+    }
+    if (Tok.isExpandDisabled())
+      return;
+    Tok.setLocation(SourceMgr.getSpellingLoc(Tok.getLocation()));
+  }
+
+  std::sort(R.Dependencies.begin(), R.Dependencies.end());
+  R.Dependencies.erase(std::unique(R.Dependencies.begin(),
+                                   R.Dependencies.end()),
+                       R.Dependencies.end());
+
+  auto *Cache = new (BP) CachedMacroExpansion;
+  Token *Toks = BP.Allocate<Token>(R.Tokens.size());
+  std::uninitialized_copy(R.Tokens.begin(), R.Tokens.end(), Toks);
+  Cache->Tokens = llvm::makeArrayRef(Toks, R.Tokens.size());
+  auto *Deps = BP.Allocate<std::pair<const IdentifierInfo *, const MacroInfo *>>(
+      R.Dependencies.size());
+  std::uninitialized_copy(R.Dependencies.begin(), R.Dependencies.end(), Deps);
+  Cache->Dependencies = llvm::makeArrayRef(Deps, R.Dependencies.size());
+  MI->setExpansionCache(Cache);
+  ++NumCachedMacroExpansions;
+}
+
 enum Bracket {
   Brace,
   Paren
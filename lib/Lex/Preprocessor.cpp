@@ -101,6 +101,7 @@ Preprocessor::Preprocessor(std::shared_ptr<PreprocessorOptions> PPOpts,
   NumFastMacroExpanded = NumTokenPaste = NumFastTokenPaste = 0;
   MaxIncludeStackDepth = 0;
   NumSkipped = 0;
+  NumCachedMacroExpansions = NumCachedMacroExpanded = 0;
   
   // Default to discarding comments.
   KeepComments = false;
@@ -112,6 +113,7 @@ Preprocessor::Preprocessor(std::shared_ptr<PreprocessorOptions> PPOpts,
   MacroExpansionInDirectivesOverride = false;
   InMacroArgs = false;
   InMacroArgPreExpansion = false;
+  CacheMacroExpansions = this->PPOpts->CacheMacroExpansions;
   NumCachedTokenLexers = 0;
   PragmasEnabled = true;
   ParsingIfOrElifDirective = false;
@@ -270,6 +272,8 @@ void Preprocessor::PrintStats() {
   llvm::errs() << NumMacroExpanded << "/" << NumFnMacroExpanded << "/"
              << NumBuiltinMacroExpanded << " obj/fn/builtin macros expanded, "
              << NumFastMacroExpanded << " on the fast path.\n";
+  llvm::errs() << NumCachedMacroExpansions << " macro expansions cached, "
+               << NumCachedMacroExpanded << " expanded from the cache.\n";
   llvm::errs() << (NumFastTokenPaste+NumTokenPaste)
              << " token paste (##) operations performed, "
              << NumFastTokenPaste << " on the fast path.\n";
@@ -734,6 +738,7 @@ bool Preprocessor::HandleIdentifier(Token &Identifier) {
 void Preprocessor::Lex(Token &Result) {
   // We loop here until a lex function returns a token; this avoids recursion.
   bool ReturnedToken;
+  bool Relexed = false;
   do {
     switch (CurLexerKind) {
     case CLK_Lexer:
@@ -748,14 +753,23 @@ void Preprocessor::Lex(Token &Result) {
     case CLK_CachingLexer:
       CachingLex(Result);
       ReturnedToken = true;
+      Relexed = true;
       break;
     case CLK_LexAfterModuleImport:
       LexAfterModuleImport(Result);
       ReturnedToken = true;
+      Relexed = true;
       break;
     }
   } while (!ReturnedToken);
 
+  // Tokens read by the preprocessor itself while it collects or pre-expands
+  // macro arguments are not part of the expansion being recorded, and tokens
+  // that were lexed again were recorded the first time.
+  if (ExpansionRecording.Macro && !Relexed && !InMacroArgs &&
+      !InMacroArgPreExpansion)
+    ExpansionRecording.Tokens.push_back(Result);
+
   if (Result.is(tok::code_completion))
     setCodeCompletionIdentifierInfo(Result.getIdentifierInfo());
 
@@ -364,12 +364,16 @@ void html::AddHeaderFooterInternalBuiltinCSS(Rewriter &R, FileID FID,
 /// table state from the end of the file, so it won't be perfectly perfect,
 /// but it will be reasonably close.
 void html::SyntaxHighlight(Rewriter &R, FileID FID, const Preprocessor &PP) {
-  RewriteBuffer &RB = R.getEditBuffer(FID);
+  std::vector<HighlightedRange> Ranges;
+  SyntaxHighlight(Ranges, FID, PP);
+  ApplyHighlights(R, FID, Ranges);
+}
 
+void html::SyntaxHighlight(std::vector<HighlightedRange> &Ranges, FileID FID,
+                           const Preprocessor &PP) {
   const SourceManager &SM = PP.getSourceManager();
   const llvm::MemoryBuffer *FromFile = SM.getBuffer(FID);
   Lexer L(FID, FromFile, SM, PP.getLangOpts());
-  const char *BufferStart = L.getBuffer().data();
 
   // Inform the preprocessor that we want to retain comments as tokens, so we
   // can highlight them.
@@ -396,13 +400,13 @@ void html::SyntaxHighlight(Rewriter &R, FileID FID, const Preprocessor &PP) {
 
       // If this is a pp-identifier, for a keyword, highlight it as such.
       if (Tok.isNot(tok::identifier))
-        HighlightRange(RB, TokOffs, TokOffs+TokLen, BufferStart,
-                       "<span class='keyword'>", "</span>");
+        Ranges.push_back({TokOffs, TokOffs+TokLen,
+                          "<span class='keyword'>", "</span>"});
       break;
     }
     case tok::comment:
-      HighlightRange(RB, TokOffs, TokOffs+TokLen, BufferStart,
-                     "<span class='comment'>", "</span>");
+      Ranges.push_back({TokOffs, TokOffs+TokLen,
+                        "<span class='comment'>", "</span>"});
       break;
     case tok::utf8_string_literal:
       // Chop off the u part of u8 prefix
@@ -418,8 +422,8 @@ void html::SyntaxHighlight(Rewriter &R, FileID FID, const Preprocessor &PP) {
       // FALL THROUGH.
     case tok::string_literal:
       // FIXME: Exclude the optional ud-suffix from the highlighted range.
-      HighlightRange(RB, TokOffs, TokOffs+TokLen, BufferStart,
-                     "<span class='string_literal'>", "</span>");
+      Ranges.push_back({TokOffs, TokOffs+TokLen,
+                        "<span class='string_literal'>", "</span>"});
       break;
     case tok::hash: {
       // If this is a preprocessor directive, all tokens to end of line are too.
@@ -436,8 +440,8 @@ void html::SyntaxHighlight(Rewriter &R, FileID FID, const Preprocessor &PP) {
       }
 
       // Find end of line.  This is a hack.
-      HighlightRange(RB, TokOffs, TokEnd, BufferStart,
-                     "<span class='directive'>", "</span>");
+      Ranges.push_back({TokOffs, TokEnd,
+                        "<span class='directive'>", "</span>"});
 
       // Don't skip the next token.
       continue;
@@ -453,6 +457,13 @@ void html::SyntaxHighlight(Rewriter &R, FileID FID, const Preprocessor &PP) {
 /// macro expansions.  This won't be perfectly perfect, but it will be
 /// reasonably close.
 void html::HighlightMacros(Rewriter &R, FileID FID, const Preprocessor& PP) {
+  std::vector<HighlightedRange> Ranges;
+  HighlightMacros(Ranges, FID, PP);
+  ApplyHighlights(R, FID, Ranges);
+}
+
+void html::HighlightMacros(std::vector<HighlightedRange> &Ranges, FileID FID,
+                           const Preprocessor &PP) {
   // Re-lex the raw token stream into a token buffer.
   const SourceManager &SM = PP.getSourceManager();
   std::vector<Token> TokenStream;
@@ -581,11 +592,29 @@ void html::HighlightMacros(Rewriter &R, FileID FID, const Preprocessor& PP) {
     // highlighted.
     Expansion = "<span class='expansion'>" + Expansion + "</span></span>";
 
-    HighlightRange(R, LLoc.first, LLoc.second,
-                   "<span class='macro'>", Expansion.c_str());
+    // Include the whole end token in the range.
+    unsigned BOffset = SM.getFileOffset(LLoc.first);
+    unsigned EOffset = SM.getFileOffset(LLoc.second) +
+      Lexer::MeasureTokenLength(LLoc.second, SM, PP.getLangOpts());
+    Ranges.push_back({BOffset, EOffset, "<span class='macro'>",
+                      std::move(Expansion)});
   }
 
   // Restore the preprocessor's old state.
   TmpPP.setDiagnostics(*OldDiags);
   TmpPP.setPragmasEnabled(PragmasPreviouslyEnabled);
 }
+
+void html::ApplyHighlights(Rewriter &R, FileID FID,
+                           ArrayRef<HighlightedRange> Ranges) {
+  bool Invalid = false;
+  const char *BufferStart =
+    R.getSourceMgr().getBufferData(FID, &Invalid).data();
+  if (Invalid)
+    return;
+
+  RewriteBuffer &RB = R.getEditBuffer(FID);
+  for (const HighlightedRange &Range : Ranges)
+    HighlightRange(RB, Range.Begin, Range.End, BufferStart,
+                   Range.StartTag.c_str(), Range.EndTag.c_str());
+}
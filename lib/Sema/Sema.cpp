@@ -85,7 +85,8 @@ Sema::Sema(Preprocessor &pp, ASTContext &ctxt, ASTConsumer &consumer,
       CodeSegStack(nullptr), CurInitSeg(nullptr), VisContext(nullptr),
       PragmaAttributeCurrentTargetDecl(nullptr),
       IsBuildingRecoveryCallExpr(false), Cleanup{}, LateTemplateParser(nullptr),
-      LateTemplateParserCleanup(nullptr), OpaqueParser(nullptr), IdResolver(pp),
+      LateTemplateParserCleanup(nullptr), OpaqueParser(nullptr),
+      NumCopiedDecls(0), NumAdoptedDecls(0), IdResolver(pp),
       StdExperimentalNamespaceCache(nullptr), StdInitializerList(nullptr),
       CXXTypeInfoDecl(nullptr), MSVCGuidDecl(nullptr), NSNumberDecl(nullptr),
       NSValueDecl(nullptr), NSStringDecl(nullptr),
@@ -93,10 +94,14 @@ Sema::Sema(Preprocessor &pp, ASTContext &ctxt, ASTConsumer &consumer,
       ValueWithBytesObjCTypeMethod(nullptr), NSArrayDecl(nullptr),
       ArrayWithObjectsMethod(nullptr), NSDictionaryDecl(nullptr),
       DictionaryWithObjectsMethod(nullptr), GlobalNewDeleteDeclared(false),
-      TUKind(TUKind), NumSFINAEErrors(0), AccessCheckingSFINAE(false),
+      NumOverloadCacheHits(0), NumOverloadCacheMisses(0),
+      NumOverloadCacheBypasses(0), NumSynthesizedIdentifiers(0),
+      NumSynthesizedIdentifierHits(0), NumFoldedReflectionQueries(0),
+      TUKind(TUKind), NumSFINAEErrors(0),
+      AccessCheckingSFINAE(false),
       InNonInstantiationSFINAEContext(false), NonInstantiationEntries(0),
       ArgumentPackSubstitutionIndex(-1), CurrentInstantiationScope(nullptr),
-      CurrentInjectionContext(nullptr),
+      CurrentInjectionContext(nullptr), CurrentMetaprogram(nullptr),
       DisableTypoCorrection(false), TyposCorrected(0), AnalysisWarnings(*this),
       ThreadSafetyDeclCache(nullptr), VarDataSharingAttributesStack(nullptr),
       CurScope(nullptr), Ident_super(nullptr), Ident___float128(nullptr) {
@@ -112,6 +117,8 @@ Sema::Sema(Preprocessor &pp, ASTContext &ctxt, ASTConsumer &consumer,
   if (getLangOpts().CPlusPlus)
     FieldCollector.reset(new CXXFieldCollector());
 
+  OverloadCandidateArenas.reset(new OverloadCandidateArenaPool());
+
   // Tell diagnostics how to render things from the AST library.
   Diags.SetArgToStringFn(&FormatASTNodeDiagnosticArgument, &Context);
 
@@ -366,6 +373,15 @@ void Sema::addExternalSource(ExternalSemaSource *E) {
 void Sema::PrintStats() const {
   llvm::errs() << "\n*** Semantic Analysis Stats:\n";
   llvm::errs() << NumSFINAEErrors << " SFINAE diagnostics trapped.\n";
+  llvm::errs() << NumCopiedDecls << " declarations copied by injection.\n";
+  llvm::errs() << NumAdoptedDecls << " prototype members adopted.\n";
+  llvm::errs() << NumOverloadCacheHits << " overload resolutions reused, "
+               << NumOverloadCacheMisses << " memoized, "
+               << NumOverloadCacheBypasses << " not memoizable.\n";
+  llvm::errs() << NumSynthesizedIdentifiers << " identifiers synthesized, "
+               << NumSynthesizedIdentifierHits << " reused.\n";
+  llvm::errs() << NumFoldedReflectionQueries
+               << " reflection queries folded at their call sites.\n";
 
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
@@ -752,6 +768,11 @@ void Sema::ActOnEndOfTranslationUnit() {
       LateTemplateParserCleanup(OpaqueParser);
 
     CheckDelayedMemberExceptionSpecs();
+  } else if (LangOpts.PCHInstantiateTemplates) {
+    // Perform the implicit instantiations required by the header now so that
+    // the instantiated definitions are serialized with the PCH. Translation
+    // units that include the PCH then only instantiate what is new to them.
+    PerformPendingInstantiations();
   }
 
   DiagnoseUnterminatedPragmaAttribute();
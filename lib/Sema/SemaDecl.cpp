@@ -14227,6 +14227,12 @@ void Sema::ActOnTagFinishDefinition(Scope *S, Decl *TagD,
 
         assert(Class->isCompleteDefinition() && "Generated class not complete");
 
+        // The metaclass has been applied, and every member it generated was
+        // either adopted or copied from the prototype. Don't carry what's
+        // left of the prototype any further.
+        if (!Class->isDependentContext())
+          Proto->setDiscarded(true);
+
         // Replace the closed tag with this class.
         Tag = Class;
       }
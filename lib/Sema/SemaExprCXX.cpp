@@ -2096,7 +2096,7 @@ resolveAllocationOverload(Sema &S, LookupResult &R, SourceRange Range,
                           FunctionDecl *&Operator,
                           OverloadCandidateSet *AlignedCandidates = nullptr,
                           Expr *AlignArg = nullptr) {
-  OverloadCandidateSet Candidates(R.getNameLoc(),
+  OverloadCandidateSet Candidates(S, R.getNameLoc(),
                                   OverloadCandidateSet::CSK_Normal);
   for (LookupResult::iterator Alloc = R.begin(), AllocEnd = R.end();
        Alloc != AllocEnd; ++Alloc) {
@@ -5273,7 +5273,7 @@ static bool TryClassUnification(Sema &Self, Expr *From, Expr *To,
 static bool FindConditionalOverload(Sema &Self, ExprResult &LHS, ExprResult &RHS,
                                     SourceLocation QuestionLoc) {
   Expr *Args[2] = { LHS.get(), RHS.get() };
-  OverloadCandidateSet CandidateSet(QuestionLoc,
+  OverloadCandidateSet CandidateSet(Self, QuestionLoc,
                                     OverloadCandidateSet::CSK_Operator);
   Self.AddBuiltinOperatorCandidates(OO_Conditional, QuestionLoc, Args,
                                     CandidateSet);
@@ -7596,13 +7596,11 @@ Sema::BuildConstantExpression(Expr *E)
   // FIXME: Generate an error if we can't build the constant expression? We
   // probably want more context when we do this so that we can generate 
   // appropriate diagnostics. Right now, we only build these when folding
-  // calls to immediate functions.
+  // calls to the reflection library.
   Expr::EvalResult Result;
-  if (E->isRValue() && !E->EvaluateAsRValue(Result, Context))
+  bool Evaluated = E->isRValue() ? E->EvaluateAsRValue(Result, Context)
+                                 : E->EvaluateAsLValue(Result, Context);
+  if (!Evaluated)
     return ExprError();
-  else if (E->isLValue() && !E->EvaluateAsLValue(Result, Context))
-    return ExprError();
-  else
-    llvm_unreachable("invalid value category");
   return new (Context) CXXConstantExpr(E, std::move(Result.Val));
 }
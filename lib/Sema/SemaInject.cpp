@@ -19,6 +19,7 @@
 #include "clang/AST/DeclCXX.h"
 #include "clang/AST/DeclVisitor.h"
 #include "clang/AST/ExprCXX.h"
+#include "clang/AST/RecursiveASTVisitor.h"
 #include "clang/Sema/Initialization.h"
 #include "clang/Sema/Template.h"
 #include "clang/Sema/SemaInternal.h"
@@ -120,6 +121,12 @@ struct DeclModifiers
     }
   }
 
+  // Returns true if any specifier is modified.
+  bool hasModifications() const {
+    return Access != NoAccess || Storage != NoStorage || Constexpr ||
+           Virtual || Pure;
+  }
+
   // If true, add the constexpr specifier.
   bool addConstexpr() { return Constexpr; }
   
@@ -150,7 +157,8 @@ public:
                    DeclContext *Injectee,
                    Decl *Injection)
       : Base(SemaRef), Prev(SemaRef.CurrentInjectionContext), 
-        Fragment(Frag), Injectee(Injectee), Injection(Injection), Modifiers() {
+        Fragment(Frag), Injectee(Injectee), Injection(Injection), Modifiers(),
+        TopLevelDecls() {
     getSema().CurrentInjectionContext = this;
   }
   
@@ -159,7 +167,8 @@ public:
                    DeclContext *Injectee, 
                    Decl *Injection)
     : Base(SemaRef), Prev(SemaRef.CurrentInjectionContext), Fragment(), 
-      Injectee(Injectee), Injection(Injection), Modifiers() {
+      Injectee(Injectee), Injection(Injection), Modifiers(), 
+      TopLevelDecls() {
    getSema().CurrentInjectionContext = this;
   }  
 
@@ -260,6 +269,9 @@ public:
   /// Returns true if D is within an injected fragment or cloned declaration.
   bool IsInInjection(Decl *D);
 
+  /// Remembers that New was injected from Old by this context.
+  void RecordInjectionOrigin(FunctionDecl *Old, FunctionDecl *New);
+
   /// Sets the declaration modifiers.
   void setModifiers(const APValue& Traits) { Modifiers = DeclModifiers(Traits); }
 
@@ -368,6 +380,10 @@ public:
   /// injected. These are processed when a class receiving injections is
   /// completed.
   llvm::SmallVector<InjectedDef, 8> InjectedDefinitions;
+
+  /// \brief If non-null, injected top-level declarations are collected here
+  /// instead of being passed to the AST consumer one at a time.
+  SmallVectorImpl<Decl *> *TopLevelDecls;
 };
 
 SmallVectorImpl<ParmVarDecl *> *
@@ -422,6 +438,35 @@ bool InjectionContext::IsInInjection(Decl *D) {
   return false;
 }
 
+/// Returns the metaclass whose definition contains D, if any.
+static MetaclassDecl *GetEnclosingMetaclass(Decl *D) {
+  for (DeclContext *DC = D->getDeclContext(); DC; DC = DC->getParent())
+    if (MetaclassDecl *MD = dyn_cast<MetaclassDecl>(DC))
+      return MD;
+  return nullptr;
+}
+
+void InjectionContext::RecordInjectionOrigin(FunctionDecl *Old,
+                                             FunctionDecl *New) {
+  InjectionOrigin O;
+  O.Source = Old;
+  O.Injectee = GetInjecteeDecl();
+  O.Generator = getSema().CurrentMetaprogram;
+
+  // The members of a metaclass are copied into the final class before its
+  // constexpr-declarations are evaluated, so the metaclass is found in an
+  // enclosing injection, not in the metaprogram being evaluated.
+  for (InjectionContext *Cxt = this; Cxt && Cxt != (InjectionContext *)0x1;
+       Cxt = Cxt->Prev) {
+    if (MetaclassDecl *MD = GetEnclosingMetaclass(Cxt->Injection)) {
+      O.Metaclass = MD;
+      break;
+    }
+  }
+
+  getContext().setInjectionOrigin(New, O);
+}
+
 Decl* InjectionContext::TransformDecl(SourceLocation Loc, Decl *D) {
   if (!D)
     return nullptr;
@@ -828,6 +873,7 @@ Decl *InjectionContext::InjectFunctionDecl(FunctionDecl *D) {
       getContext(), Owner, D->getLocation(), DNI, TSI->getType(), TSI,
       D->getStorageClass(), D->hasWrittenPrototype(), D->isConstexpr());
   AddDeclSubstitution(D, Fn);
+  RecordInjectionOrigin(D, Fn);
 
   UpdateFunctionParms(D, Fn);
 
@@ -1153,6 +1199,7 @@ Decl *InjectionContext::InjectCXXMethodDecl(CXXMethodDecl *D) {
                                    D->getLocEnd());
   }
   AddDeclSubstitution(D, Method);
+  RecordInjectionOrigin(D, Method);
 
   UpdateFunctionParms(D, Method);
 
@@ -1379,8 +1426,12 @@ Decl *InjectionContext::InjectDecl(Decl *D) {
 
   // If we injected a top-level declaration, notify the AST consumer,
   // so that it can be processed for code generation.
-  if (isa<TranslationUnitDecl>(R->getDeclContext()))
-    getSema().Consumer.HandleTopLevelDecl(DeclGroupRef(R));
+  if (isa<TranslationUnitDecl>(R->getDeclContext())) {
+    if (TopLevelDecls)
+      TopLevelDecls->push_back(R);
+    else
+      getSema().Consumer.HandleTopLevelDecl(DeclGroupRef(R));
+  }
 
   return R;
 }
@@ -2137,19 +2188,18 @@ static bool CheckInjectionKind(Sema &SemaRef, SourceLocation POI,
   return true;
 }
 
-/// Inject a fragment into the current context.
-bool Sema::InjectFragment(SourceLocation POI, 
-                          QualType ReflectionTy, 
-                          const APValue &ReflectionVal, 
-                          Decl *Injectee, 
-                          Decl *Injection) {
-  assert(isa<CXXRecordDecl>(Injection) || isa<NamespaceDecl>(Injection));
+/// Inject the members of a fragment into the injectee, which must already
+/// be the current context. If TopLevelDecls is non-null, injected top-level
+/// declarations are added to it instead of being passed to the consumer.
+static bool InjectFragmentMembers(Sema &SemaRef,
+                                  QualType ReflectionTy, 
+                                  const APValue &ReflectionVal, 
+                                  Decl *Injectee, 
+                                  Decl *Injection,
+                                  SmallVectorImpl<Decl *> *TopLevelDecls) {
   DeclContext *InjecteeDC = Decl::castToDeclContext(Injectee);
   DeclContext *InjectionDC = Decl::castToDeclContext(Injection);
 
-  if (!CheckInjectionContexts(*this, POI, InjectionDC, InjecteeDC))
-    return false;
-
   // Extract the captured values for replacement.
   unsigned NumCaptures = ReflectionVal.getStructNumFields();
   ArrayRef<APValue> Captures(None);
@@ -2161,12 +2211,12 @@ bool Sema::InjectFragment(SourceLocation POI,
   CXXRecordDecl *Class = ReflectionTy->getAsCXXRecordDecl();
   CXXFragmentDecl *Fragment = cast<CXXFragmentDecl>(Injection->getDeclContext());
 
-  ContextRAII Switch(*this, InjecteeDC, isa<CXXRecordDecl>(Injectee));
-
   // Establish the injection context and register the substitutions.
-  InjectionContext *Cxt = new InjectionContext(*this, Fragment, InjecteeDC, Injection);
+  InjectionContext *Cxt = new InjectionContext(SemaRef, Fragment, InjecteeDC, 
+                                               Injection);
   Cxt->AddDeclSubstitution(Injection, Injectee);
   Cxt->AddPlaceholderSubstitutions(Fragment, Class, Captures);
+  Cxt->TopLevelDecls = TopLevelDecls;
 
   // Inject each declaration in the fragment.
   for (Decl *D : InjectionDC->decls()) {
@@ -2191,12 +2241,13 @@ bool Sema::InjectFragment(SourceLocation POI,
     // llvm::outs() << "AFTER INJECT\n";
     // R->dump();
   }
+  Cxt->TopLevelDecls = nullptr;
 
   // If we're injecting into a class and have pending definitions, attach
   // those to the class for subsequent analysis. 
   if (CXXRecordDecl *ClassInjectee = dyn_cast<CXXRecordDecl>(Injectee)) {
     if (!Injectee->isInvalidDecl() && !Cxt->InjectedDefinitions.empty()) {
-      PendingClassMemberInjections.push_back(Cxt->Detach());
+      SemaRef.PendingClassMemberInjections.push_back(Cxt->Detach());
       return true;
     }
   }
@@ -2205,6 +2256,252 @@ bool Sema::InjectFragment(SourceLocation POI,
   return !Injectee->isInvalidDecl();
 }
 
+/// Inject a fragment into the current context.
+bool Sema::InjectFragment(SourceLocation POI, 
+                          QualType ReflectionTy, 
+                          const APValue &ReflectionVal, 
+                          Decl *Injectee, 
+                          Decl *Injection) {
+  assert(isa<CXXRecordDecl>(Injection) || isa<NamespaceDecl>(Injection));
+  DeclContext *InjecteeDC = Decl::castToDeclContext(Injectee);
+  DeclContext *InjectionDC = Decl::castToDeclContext(Injection);
+
+  if (!CheckInjectionContexts(*this, POI, InjectionDC, InjecteeDC))
+    return false;
+
+  ContextRAII Switch(*this, InjecteeDC, isa<CXXRecordDecl>(Injectee));
+
+  return InjectFragmentMembers(*this, ReflectionTy, ReflectionVal, Injectee, 
+                               Injection, /*TopLevelDecls=*/nullptr);
+}
+
+/// Inject a sequence of fragments into the current context. This is
+/// equivalent to injecting each fragment in turn, except that the injectee
+/// is established once for the entire batch, each distinct fragment is only
+/// resolved and checked once, and injected top-level declarations are passed
+/// to the AST consumer as a single group.
+bool Sema::ApplyInjectionBatch(SourceLocation POI, InjectionBatch &IB) {
+  Decl *Injectee = Decl::castFromDeclContext(CurContext);
+  DeclContext *InjecteeDC = CurContext;
+
+  ContextRAII Switch(*this, InjecteeDC, isa<CXXRecordDecl>(Injectee));
+
+  SmallVector<Decl *, 16> TopLevelDecls;
+  bool Ok = true;
+  QualType LastTy;
+  Decl *Injection = nullptr;
+  for (std::size_t I = 0; I < IB.size(); ++I) {
+    QualType Ty = IB.ReflectionTypes[I];
+    if (Ty != LastTy) {
+      LastTy = Ty;
+      Injection = GetDeclFromReflection(*this, Ty, POI);
+      if (Injection) {
+        assert(isa<CXXRecordDecl>(Injection) || isa<NamespaceDecl>(Injection));
+        DeclContext *InjectionDC = Decl::castToDeclContext(Injection);
+        if (!CheckInjectionContexts(*this, POI, InjectionDC, InjecteeDC))
+          Injection = nullptr;
+      }
+    }
+    if (!Injection) {
+      Ok = false;
+      continue;
+    }
+
+    Ok &= InjectFragmentMembers(*this, Ty, IB.ReflectionValues[I], Injectee, 
+                                Injection, &TopLevelDecls);
+  }
+
+  if (!TopLevelDecls.empty())
+    Consumer.HandleTopLevelDecl(DeclGroupRef::Create(
+        Context, TopLevelDecls.data(), TopLevelDecls.size()));
+
+  return Ok;
+}
+
+namespace {
+
+/// Searches a member of a prototype class for references to the prototype
+/// or to any of its other members. A member that contains no such references
+/// is not changed by copying it into the generated class, so it can be moved
+/// there instead.
+class PrototypeReferenceFinder
+    : public RecursiveASTVisitor<PrototypeReferenceFinder> {
+  CXXRecordDecl *Proto;
+  Decl *Member;
+  bool Found;
+
+public:
+  PrototypeReferenceFinder(CXXRecordDecl *Proto, Decl *Member)
+    : Proto(Proto), Member(Member), Found(false) { }
+
+  bool shouldVisitImplicitCode() const { return true; }
+
+  /// Returns true if D is the prototype or declared within it (but not
+  /// within the member being searched).
+  bool isInPrototype(const Decl *D) const {
+    if (D == Proto)
+      return true;
+    if (D == Member)
+      return false;
+    for (const DeclContext *DC = D->getDeclContext(); DC; 
+         DC = DC->getParent()) {
+      if (DC == Proto)
+        return true;
+      if (Decl::castFromDeclContext(DC) == Member)
+        return false;
+    }
+    return false;
+  }
+
+  /// Returns true if the type T refers to the prototype or its members.
+  bool refersToPrototype(QualType T) const {
+    if (T.isNull())
+      return false;
+    T = T.getCanonicalType();
+    if (const ReferenceType *Ref = T->getAs<ReferenceType>())
+      return refersToPrototype(Ref->getPointeeType());
+    if (const PointerType *Ptr = T->getAs<PointerType>())
+      return refersToPrototype(Ptr->getPointeeType());
+    if (const MemberPointerType *MPT = T->getAs<MemberPointerType>())
+      return refersToPrototype(QualType(MPT->getClass(), 0)) ||
+             refersToPrototype(MPT->getPointeeType());
+    if (const ArrayType *Arr = T->getAsArrayTypeUnsafe())
+      return refersToPrototype(Arr->getElementType());
+    if (const FunctionProtoType *FPT = T->getAs<FunctionProtoType>()) {
+      if (refersToPrototype(FPT->getReturnType()))
+        return true;
+      for (QualType P : FPT->param_types())
+        if (refersToPrototype(P))
+          return true;
+      return false;
+    }
+    if (const TagDecl *TD = T->getAsTagDecl()) {
+      if (isInPrototype(TD))
+        return true;
+      if (const auto *Spec = dyn_cast<ClassTemplateSpecializationDecl>(TD)) {
+        for (const TemplateArgument &Arg : Spec->getTemplateArgs().asArray())
+          if (Arg.getKind() == TemplateArgument::Type &&
+              refersToPrototype(Arg.getAsType()))
+            return true;
+      }
+    }
+    return false;
+  }
+
+  bool VisitDecl(Decl *D) {
+    if (ValueDecl *VD = dyn_cast<ValueDecl>(D))
+      Found |= refersToPrototype(VD->getType());
+    else if (TypedefNameDecl *TD = dyn_cast<TypedefNameDecl>(D))
+      Found |= refersToPrototype(TD->getUnderlyingType());
+    return !Found;
+  }
+
+  bool VisitStmt(Stmt *S) {
+    if (Expr *E = dyn_cast<Expr>(S))
+      Found |= refersToPrototype(E->getType());
+    return !Found;
+  }
+
+  bool VisitCXXThisExpr(CXXThisExpr *E) {
+    Found = true;
+    return false;
+  }
+
+  bool VisitDeclRefExpr(DeclRefExpr *E) {
+    Found |= isInPrototype(E->getDecl());
+    return !Found;
+  }
+
+  bool VisitMemberExpr(MemberExpr *E) {
+    Found |= isInPrototype(E->getMemberDecl());
+    return !Found;
+  }
+
+  bool search() {
+    TraverseDecl(Member);
+    return Found;
+  }
+};
+
+} // namespace
+
+/// Returns true if the declaration can be moved into the injectee instead of
+/// being copied. This is the case for members of a metaclass prototype that
+/// are copied into the generated class without modification and that do not
+/// refer to the prototype, its members, or the implicit object.
+static bool CanAdoptPrototypeMember(Sema &SemaRef, Decl *Injection, 
+                                    Decl *Injectee,
+                                    const DeclModifiers &Mods) {
+  if (Mods.hasModifications())
+    return false;
+
+  // Don't adopt while another injection is in progress; it may still refer
+  // to the member through its substitutions.
+  if (SemaRef.CurrentInjectionContext)
+    return false;
+
+  CXXRecordDecl *Proto = dyn_cast<CXXRecordDecl>(Injection->getDeclContext());
+  if (!Proto || !Proto->isPrototypeClass() || Proto->isDependentContext())
+    return false;
+  if (Proto->getDeclContext() != Decl::castToDeclContext(Injectee))
+    return false;
+  if (Injection->isInvalidDecl() || Injection->isImplicit() || 
+      Injection->getLexicalDeclContext() != Proto)
+    return false;
+
+  // Only adopt declarations that do not carry class-specific semantic
+  // information computed when they were added to the prototype.
+  switch (Injection->getKind()) {
+  case Decl::Field: {
+    FieldDecl *Field = cast<FieldDecl>(Injection);
+    if (!Field->getDeclName() || Field->isAnonymousStructOrUnion())
+      return false;
+    break;
+  }
+  case Decl::CXXMethod: {
+    CXXMethodDecl *Method = cast<CXXMethodDecl>(Injection);
+    if (Method->isVirtual() || Method->getDescribedFunctionTemplate() ||
+        Method->isDefaulted() || Method->isDeleted())
+      return false;
+    // Late-parsed bodies are attached to the original declaration context.
+    if (Method->willHaveBody() && !Method->hasBody())
+      return false;
+    break;
+  }
+  case Decl::Var:
+    if (!cast<VarDecl>(Injection)->isStaticDataMember())
+      return false;
+    break;
+  case Decl::Enum:
+    // The enumerators of an unscoped enum are visible in the prototype's
+    // lookup table, not the enum's; copy it so they are registered in the
+    // generated class.
+    if (!cast<EnumDecl>(Injection)->isScoped())
+      return false;
+    break;
+  case Decl::Typedef:
+  case Decl::TypeAlias:
+    break;
+  default:
+    return false;
+  }
+
+  return !PrototypeReferenceFinder(Proto, Injection).search();
+}
+
+/// Moves a member of a metaclass prototype into its generated class.
+static Decl *AdoptPrototypeMember(Sema &SemaRef, Decl *Injection, 
+                                  CXXRecordDecl *Class) {
+  CXXRecordDecl *Proto = cast<CXXRecordDecl>(Injection->getDeclContext());
+  Proto->removeDecl(Injection);
+  Injection->setDeclContext(Class);
+  if (FieldDecl *Field = dyn_cast<FieldDecl>(Injection))
+    Field->clearCachedFieldIndex();
+  Class->addDecl(Injection);
+  ++SemaRef.NumAdoptedDecls;
+  return Injection;
+}
+
 /// Clone a declaration into the current context.
 bool Sema::CopyDeclaration(SourceLocation POI, 
                            QualType ReflectionTy, 
@@ -2226,6 +2523,20 @@ bool Sema::CopyDeclaration(SourceLocation POI,
   if (!CheckInjectionKind(*this, POI, Injection, InjecteeDC))
     return false;
 
+  // Unpack the modification traits so we can apply them after generating
+  // the declaration.
+  DeclarationName Name(&Context.Idents.get("mods"));
+  const APValue &Traits = GetModifications(ReflectionVal, ReflectionTy, Name);
+
+  // Members of a metaclass prototype that are generated as-is don't need
+  // to be copied; just move them into the final class.
+  if (CanAdoptPrototypeMember(*this, Injection, Injectee,
+                              DeclModifiers(Traits))) {
+    AdoptPrototypeMember(*this, Injection, cast<CXXRecordDecl>(Injectee));
+    return true;
+  }
+  ++NumCopiedDecls;
+
   // Set up the injection context for the declaration. Note that we're
   // going to replace references to the inectee with the current owner.
   InjectionContext *Cxt = new InjectionContext(*this, InjecteeDC, Injection);
@@ -2233,11 +2544,6 @@ bool Sema::CopyDeclaration(SourceLocation POI,
 
   // Establish injectee as the current context.
   ContextRAII Switch(*this, InjecteeDC, isa<CXXRecordDecl>(Injectee));
-
-  // Unpack the modification traits so we can apply them after generating
-  // the declaration.
-  DeclarationName Name(&Context.Idents.get("mods"));
-  const APValue &Traits = GetModifications(ReflectionVal, ReflectionTy, Name);
   Cxt->setModifiers(Traits);
 
   // llvm::outs() << "BEFORE CLONE\n";
@@ -2336,12 +2642,20 @@ ApplyDiagnostic(Sema &SemaRef, SourceLocation Loc, const APValue &Arg) {
 /// \returns  true if no errors are encountered, false otherwise.
 bool Sema::ApplyEffects(SourceLocation POI, 
                         SmallVectorImpl<EvalEffect> &Effects) {
+  ASTNodeOriginRAII Origin(Context, ASTNodeOrigin::Injected);
   bool Ok = true;
   for (EvalEffect &Effect : Effects) {
-    if (Effect.Kind == EvalEffect::InjectionEffect)
+    switch (Effect.Kind) {
+    case EvalEffect::InjectionEffect:
       Ok &= ApplyInjection(POI, *Effect.Injection);
-    else
+      break;
+    case EvalEffect::InjectionBatchEffect:
+      Ok &= ApplyInjectionBatch(POI, *Effect.Batch);
+      break;
+    case EvalEffect::DiagnosticEffect:
       Ok &= ApplyDiagnostic(*this, POI, *Effect.DiagnosticArg);
+      break;
+    }
   }
   return Ok;
 }
@@ -2381,6 +2695,7 @@ void Sema::InjectPendingDefinitions() {
 }
 
 void Sema::InjectPendingDefinitions(InjectionContext *Cxt) {
+  ASTNodeOriginRAII Origin(Context, ASTNodeOrigin::Injected);
   Cxt->Attach();
   for (InjectedDef& Def : Cxt->InjectedDefinitions)
     InjectPendingDefinition(Cxt, Def.Fragment, Def.Injected);
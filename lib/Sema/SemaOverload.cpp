@@ -828,20 +828,47 @@ llvm::Optional<unsigned> DeductionFailureInfo::getCallArgIndex() {
   }
 }
 
+OverloadCandidateSet::OverloadCandidateSet(Sema &S, SourceLocation Loc,
+                                           CandidateSetKind CSK)
+    : Pool(*S.OverloadCandidateArenas), Arena(Pool.acquire()),
+      Candidates(nullptr), NumCandidates(0), CandidateCapacity(0), Loc(Loc),
+      Kind(CSK) {}
+
+OverloadCandidateSet::~OverloadCandidateSet() {
+  destroyCandidates();
+  Pool.release(std::move(Arena));
+}
+
 void OverloadCandidateSet::destroyCandidates() {
   for (iterator i = begin(), e = end(); i != e; ++i) {
     for (auto &C : i->Conversions)
       C.~ImplicitConversionSequence();
     if (!i->Viable && i->FailureKind == ovl_fail_bad_deduction)
       i->DeductionFailure.Destroy();
+    i->~OverloadCandidate();
+  }
+}
+
+void OverloadCandidateSet::growCandidates() {
+  unsigned NewCapacity = std::max(16u, CandidateCapacity * 2);
+  OverloadCandidate *NewCandidates =
+      Arena->Allocate<OverloadCandidate>(NewCapacity);
+  // The old array is abandoned in the arena; it is reclaimed with the rest
+  // of the set's storage.
+  for (unsigned I = 0; I != NumCandidates; ++I) {
+    new (&NewCandidates[I]) OverloadCandidate(std::move(Candidates[I]));
+    Candidates[I].~OverloadCandidate();
   }
+  Candidates = NewCandidates;
+  CandidateCapacity = NewCapacity;
 }
 
 void OverloadCandidateSet::clear() {
   destroyCandidates();
-  SlabAllocator.Reset();
-  NumInlineBytesUsed = 0;
-  Candidates.clear();
+  Arena->Reset();
+  Candidates = nullptr;
+  NumCandidates = 0;
+  CandidateCapacity = 0;
   Functions.clear();
 }
 
@@ -1221,7 +1248,7 @@ TryUserDefinedConversion(Sema &S, Expr *From, QualType ToType,
   }
 
   // Attempt user-defined conversion.
-  OverloadCandidateSet Conversions(From->getExprLoc(),
+  OverloadCandidateSet Conversions(S, From->getExprLoc(),
                                    OverloadCandidateSet::CSK_Normal);
   switch (IsUserDefinedConversion(S, From, ToType, ICS.UserDefined,
                                   Conversions, AllowExplicit,
@@ -3427,7 +3454,7 @@ IsUserDefinedConversion(Sema &S, Expr *From, QualType ToType,
 bool
 Sema::DiagnoseMultipleUserDefinedConversion(Expr *From, QualType ToType) {
   ImplicitConversionSequence ICS;
-  OverloadCandidateSet CandidateSet(From->getExprLoc(),
+  OverloadCandidateSet CandidateSet(*this, From->getExprLoc(),
                                     OverloadCandidateSet::CSK_Normal);
   OverloadingResult OvResult =
     IsUserDefinedConversion(*this, From, ToType, ICS.UserDefined,
@@ -4288,7 +4315,8 @@ FindConversionForRefInit(Sema &S, ImplicitConversionSequence &ICS,
   CXXRecordDecl *T2RecordDecl
     = dyn_cast<CXXRecordDecl>(T2->getAs<RecordType>()->getDecl());
 
-  OverloadCandidateSet CandidateSet(DeclLoc, OverloadCandidateSet::CSK_Normal);
+  OverloadCandidateSet CandidateSet(S, DeclLoc,
+                                    OverloadCandidateSet::CSK_Normal);
   const auto &Conversions = T2RecordDecl->getVisibleConversionFunctions();
   for (auto I = Conversions.begin(), E = Conversions.end(); I != E; ++I) {
     NamedDecl *D = *I;
@@ -5740,7 +5768,8 @@ ExprResult Sema::PerformContextualImplicitConversion(
     // If one unique T is found:
     // First, build a candidate set from the previously recorded
     // potentially viable conversions.
-    OverloadCandidateSet CandidateSet(Loc, OverloadCandidateSet::CSK_Normal);
+    OverloadCandidateSet CandidateSet(*this, Loc,
+                                      OverloadCandidateSet::CSK_Normal);
     collectViableConversionCandidates(*this, From, ToType, ViableConversions,
                                       CandidateSet);
 
@@ -11551,7 +11580,7 @@ DiagnoseTwoPhaseLookup(Sema &SemaRef, SourceLocation FnLoc,
         return false;
       }
 
-      OverloadCandidateSet Candidates(FnLoc, CSK);
+      OverloadCandidateSet Candidates(SemaRef, FnLoc, CSK);
       for (LookupResult::iterator I = R.begin(), E = R.end(); I != E; ++I)
         AddOverloadedCallCandidate(SemaRef, I.getPair(),
                                    ExplicitTemplateArgs, Args,
@@ -11906,6 +11935,121 @@ static void markUnaddressableCandidatesUnviable(Sema &S,
   }
 }
 
+/// \brief Profile everything that the outcome of overload resolution for a
+/// call of \p Name depends on into \p ID.
+///
+/// \param Kind Distinguishes the kinds of call that share a profile format.
+///
+/// \param Begin, End The functions found by name lookup for the call.
+///
+/// \returns false if the outcome could depend on something that is not
+/// captured, in which case it must not be memoized.
+static bool ProfileOverloadResolution(Sema &S, llvm::FoldingSetNodeID &ID,
+                                      DeclarationName Name, unsigned Kind,
+                                      UnresolvedSetIterator Begin,
+                                      UnresolvedSetIterator End,
+                                      ArrayRef<Expr *> Args) {
+  // Module visibility, CUDA target-based overloading, unbridged casts and
+  // Microsoft's delayed lookup in templates all depend on more than the call
+  // itself. Errors are only reported while building the candidate set, so
+  // never skip that once one has been emitted or might be trapped.
+  const LangOptions &LangOpts = S.getLangOpts();
+  if (!LangOpts.CPlusPlus || LangOpts.Modules || LangOpts.CUDA ||
+      LangOpts.ObjC1 || LangOpts.OpenCL || LangOpts.MSVCCompat ||
+      S.isSFINAEContext() || S.getDiagnostics().hasErrorOccurred()) {
+    ++S.NumOverloadCacheBypasses;
+    return false;
+  }
+
+  ID.AddInteger(Kind);
+  ID.AddPointer(Name.getAsOpaquePtr());
+  for (UnresolvedSetIterator I = Begin; I != End; ++I) {
+    ID.AddPointer(I.getDecl());
+    ID.AddInteger(I.getAccess());
+  }
+
+  // Access checks during template argument deduction are done from the
+  // current context; members of a class all have the same access.
+  DeclContext *AccessContext = S.CurContext;
+  if (isa<CXXMethodDecl>(AccessContext))
+    AccessContext = AccessContext->getParent();
+  ID.AddPointer(AccessContext);
+
+  for (Expr *Arg : Args) {
+    if (Arg->isTypeDependent() || Arg->getType()->isPlaceholderType() ||
+        isa<InitListExpr>(Arg)) {
+      ++S.NumOverloadCacheBypasses;
+      return false;
+    }
+    ID.AddPointer(S.Context.getCanonicalType(Arg->getType()).getAsOpaquePtr());
+    ID.AddInteger(Arg->getValueKind());
+    ID.AddInteger(Arg->getObjectKind());
+
+    // Null pointer constants and string literals have conversions that other
+    // values of their type do not.
+    ID.AddBoolean(Arg->getType()->isIntegerType() &&
+                  Arg->isNullPointerConstant(
+                      S.Context, Expr::NPC_ValueDependentIsNotNull));
+    ID.AddBoolean(isa<StringLiteral>(Arg->IgnoreParens()));
+  }
+  return true;
+}
+
+/// \brief Find the memoized result of an overload resolution profiled by
+/// ProfileOverloadResolution, if it is still valid.
+Sema::MemoizedOverloadResolution *
+Sema::findMemoizedOverloadResolution(const llvm::FoldingSetNodeID &ID) {
+  void *InsertPos;
+  MemoizedOverloadResolution *Memo =
+      OverloadResolutionCache.FindNodeOrInsertPos(ID, InsertPos);
+  if (!Memo || Memo->Generation != Context.getDeclarationGeneration())
+    return nullptr;
+  ++NumOverloadCacheHits;
+  return Memo;
+}
+
+/// \brief Remember that overload resolution over \p CandidateSet picked
+/// \p Best, if the result depends only on what \p ID describes.
+///
+/// \param Generation The declaration generation before the candidate set was
+/// built.
+void Sema::memoizeOverloadResolution(const llvm::FoldingSetNodeID &ID,
+                                     unsigned Generation,
+                                     OverloadCandidateSet &CandidateSet,
+                                     OverloadCandidate *Best) {
+  // If building the candidate set completed a type or declared something,
+  // candidates considered earlier might be treated differently next time.
+  if (Generation != Context.getDeclarationGeneration()) {
+    ++NumOverloadCacheBypasses;
+    return;
+  }
+
+  // enable_if and diagnose_if depend on the values of the arguments.
+  for (OverloadCandidate &Cand : CandidateSet) {
+    if (Cand.Function && (Cand.Function->hasAttr<EnableIfAttr>() ||
+                          Cand.Function->hasAttr<DiagnoseIfAttr>())) {
+      ++NumOverloadCacheBypasses;
+      return;
+    }
+  }
+
+  // Nested overload resolutions may have changed the set since it was last
+  // searched, so find the insertion point again.
+  void *InsertPos;
+  MemoizedOverloadResolution *Memo =
+      OverloadResolutionCache.FindNodeOrInsertPos(ID, InsertPos);
+  if (!Memo) {
+    Memo = BumpAlloc.Allocate<MemoizedOverloadResolution>();
+    Memo = new (Memo) MemoizedOverloadResolution(ID);
+    OverloadResolutionCache.InsertNode(Memo, InsertPos);
+  }
+  Memo->FoundDecl = Best->FoundDecl;
+  Memo->Function = Best->Function;
+  Memo->HadMultipleCandidates = CandidateSet.size() > 1;
+  Memo->Generation = Generation;
+  ++NumOverloadCacheMisses;
+}
+
 /// BuildOverloadedCallExpr - Given the call expression that calls Fn
 /// (which eventually refers to the declaration Func) and the call
 /// arguments Args/NumArgs, attempt to resolve the function call down
@@ -11920,7 +12064,27 @@ ExprResult Sema::BuildOverloadedCallExpr(Scope *S, Expr *Fn,
                                          Expr *ExecConfig,
                                          bool AllowTypoCorrection,
                                          bool CalleesAddressIsTaken) {
-  OverloadCandidateSet CandidateSet(Fn->getExprLoc(),
+  // Reuse the result of an identical overload resolution, if there was one.
+  llvm::FoldingSetNodeID ID;
+  unsigned Generation = Context.getDeclarationGeneration();
+  bool Memoizable =
+      !CalleesAddressIsTaken && !ExecConfig &&
+      !ULE->hasExplicitTemplateArgs() &&
+      ProfileOverloadResolution(*this, ID, ULE->getName(), ULE->requiresADL(),
+                                ULE->decls_begin(), ULE->decls_end(), Args);
+  if (Memoizable) {
+    if (MemoizedOverloadResolution *Memo = findMemoizedOverloadResolution(ID)) {
+      FunctionDecl *FDecl = Memo->Function;
+      CheckUnresolvedLookupAccess(ULE, Memo->FoundDecl);
+      if (DiagnoseUseOfDecl(FDecl, ULE->getNameLoc()))
+        return ExprError();
+      Fn = FixOverloadedFunctionReference(Fn, Memo->FoundDecl, FDecl);
+      return BuildResolvedCallExpr(Fn, FDecl, LParenLoc, Args, RParenLoc,
+                                   ExecConfig);
+    }
+  }
+
+  OverloadCandidateSet CandidateSet(*this, Fn->getExprLoc(),
                                     OverloadCandidateSet::CSK_Normal);
   ExprResult result;
 
@@ -11937,6 +12101,9 @@ ExprResult Sema::BuildOverloadedCallExpr(Scope *S, Expr *Fn,
   OverloadingResult OverloadResult =
       CandidateSet.BestViableFunction(*this, Fn->getLocStart(), Best);
 
+  if (Memoizable && OverloadResult == OR_Success)
+    memoizeOverloadResolution(ID, Generation, CandidateSet, Best);
+
   return FinishOverloadedCallExpr(*this, S, Fn, ULE, LParenLoc, Args,
                                   RParenLoc, ExecConfig, &CandidateSet,
                                   &Best, OverloadResult,
@@ -12008,7 +12175,8 @@ Sema::CreateOverloadedUnaryOp(SourceLocation OpLoc, UnaryOperatorKind Opc,
   }
 
   // Build an empty overload set.
-  OverloadCandidateSet CandidateSet(OpLoc, OverloadCandidateSet::CSK_Operator);
+  OverloadCandidateSet CandidateSet(*this, OpLoc,
+                                    OverloadCandidateSet::CSK_Operator);
 
   // Add the candidates from the given function set.
   AddFunctionCandidates(Fns, ArgsArray, CandidateSet);
@@ -12136,6 +12304,95 @@ Sema::CreateOverloadedUnaryOp(SourceLocation OpLoc, UnaryOperatorKind Opc,
   return CreateBuiltinUnaryOp(OpLoc, Opc, Input);
 }
 
+/// \brief Build a call to the overloaded binary operator \p FnDecl, which
+/// overload resolution picked for the arguments \p Args.
+ExprResult Sema::BuildResolvedOverloadedBinOp(SourceLocation OpLoc,
+                                              BinaryOperatorKind Opc,
+                                              MutableArrayRef<Expr *> Args,
+                                              FunctionDecl *FnDecl,
+                                              DeclAccessPair FoundDecl,
+                                              bool HadMultipleCandidates) {
+  OverloadedOperatorKind Op = BinaryOperator::getOverloadedOperator(Opc);
+
+  // Convert the arguments.
+  if (CXXMethodDecl *Method = dyn_cast<CXXMethodDecl>(FnDecl)) {
+    // The access of FoundDecl is only meaningful for class members.
+    CheckMemberOperatorAccess(OpLoc, Args[0], Args[1], FoundDecl);
+
+    ExprResult Arg1 =
+      PerformCopyInitialization(
+        InitializedEntity::InitializeParameter(Context,
+                                               FnDecl->getParamDecl(0)),
+        SourceLocation(), Args[1]);
+    if (Arg1.isInvalid())
+      return ExprError();
+
+    ExprResult Arg0 =
+      PerformObjectArgumentInitialization(Args[0], /*Qualifier=*/nullptr,
+                                          FoundDecl, Method);
+    if (Arg0.isInvalid())
+      return ExprError();
+    Args[0] = Arg0.getAs<Expr>();
+    Args[1] = Arg1.getAs<Expr>();
+  } else {
+    // Convert the arguments.
+    ExprResult Arg0 = PerformCopyInitialization(
+      InitializedEntity::InitializeParameter(Context,
+                                             FnDecl->getParamDecl(0)),
+      SourceLocation(), Args[0]);
+    if (Arg0.isInvalid())
+      return ExprError();
+
+    ExprResult Arg1 =
+      PerformCopyInitialization(
+        InitializedEntity::InitializeParameter(Context,
+                                               FnDecl->getParamDecl(1)),
+        SourceLocation(), Args[1]);
+    if (Arg1.isInvalid())
+      return ExprError();
+    Args[0] = Arg0.getAs<Expr>();
+    Args[1] = Arg1.getAs<Expr>();
+  }
+
+  // Build the actual expression node.
+  ExprResult FnExpr = CreateFunctionRefExpr(*this, FnDecl, FoundDecl,
+                                            HadMultipleCandidates, OpLoc);
+  if (FnExpr.isInvalid())
+    return ExprError();
+
+  // Determine the result type.
+  QualType ResultTy = FnDecl->getReturnType();
+  ExprValueKind VK = Expr::getValueKindForType(ResultTy);
+  ResultTy = ResultTy.getNonLValueExprType(Context);
+
+  CXXOperatorCallExpr *TheCall =
+    new (Context) CXXOperatorCallExpr(Context, Op, FnExpr.get(),
+                                      Args, ResultTy, VK, OpLoc,
+                                      FPFeatures);
+
+  if (CheckCallReturnType(FnDecl->getReturnType(), OpLoc, TheCall,
+                          FnDecl))
+    return ExprError();
+
+  ArrayRef<const Expr *> ArgsArray(Args.data(), 2);
+  const Expr *ImplicitThis = nullptr;
+  // Cut off the implicit 'this'.
+  if (isa<CXXMethodDecl>(FnDecl)) {
+    ImplicitThis = ArgsArray[0];
+    ArgsArray = ArgsArray.slice(1);
+  }
+
+  // Check for a self move.
+  if (Op == OO_Equal)
+    DiagnoseSelfMove(Args[0], Args[1], OpLoc);
+
+  checkCall(FnDecl, nullptr, ImplicitThis, ArgsArray,
+            isa<CXXMethodDecl>(FnDecl), OpLoc, TheCall->getSourceRange(),
+            VariadicDoesNotApply);
+
+  return MaybeBindToTemporary(TheCall);
+}
+
 /// \brief Create a binary operation that may resolve to an overloaded
 /// operator.
 ///
@@ -12218,8 +12475,20 @@ Sema::CreateOverloadedBinOp(SourceLocation OpLoc,
   if (Opc == BO_PtrMemD)
     return CreateBuiltinBinOp(OpLoc, Opc, Args[0], Args[1]);
 
+  // Reuse the result of an identical overload resolution, if there was one.
+  llvm::FoldingSetNodeID ID;
+  unsigned Generation = Context.getDeclarationGeneration();
+  bool Memoizable = ProfileOverloadResolution(*this, ID, OpName, 2 + Opc,
+                                              Fns.begin(), Fns.end(), Args);
+  if (Memoizable)
+    if (MemoizedOverloadResolution *Memo = findMemoizedOverloadResolution(ID))
+      return BuildResolvedOverloadedBinOp(OpLoc, Opc, Args, Memo->Function,
+                                          Memo->FoundDecl,
+                                          Memo->HadMultipleCandidates);
+
   // Build an empty overload set.
-  OverloadCandidateSet CandidateSet(OpLoc, OverloadCandidateSet::CSK_Operator);
+  OverloadCandidateSet CandidateSet(*this, OpLoc,
+                                    OverloadCandidateSet::CSK_Operator);
 
   // Add the candidates from the given function set.
   AddFunctionCandidates(Fns, Args, CandidateSet);
@@ -12250,85 +12519,11 @@ Sema::CreateOverloadedBinOp(SourceLocation OpLoc,
       if (FnDecl) {
         // We matched an overloaded operator. Build a call to that
         // operator.
-
-        // Convert the arguments.
-        if (CXXMethodDecl *Method = dyn_cast<CXXMethodDecl>(FnDecl)) {
-          // Best->Access is only meaningful for class members.
-          CheckMemberOperatorAccess(OpLoc, Args[0], Args[1], Best->FoundDecl);
-
-          ExprResult Arg1 =
-            PerformCopyInitialization(
-              InitializedEntity::InitializeParameter(Context,
-                                                     FnDecl->getParamDecl(0)),
-              SourceLocation(), Args[1]);
-          if (Arg1.isInvalid())
-            return ExprError();
-
-          ExprResult Arg0 =
-            PerformObjectArgumentInitialization(Args[0], /*Qualifier=*/nullptr,
-                                                Best->FoundDecl, Method);
-          if (Arg0.isInvalid())
-            return ExprError();
-          Args[0] = Arg0.getAs<Expr>();
-          Args[1] = RHS = Arg1.getAs<Expr>();
-        } else {
-          // Convert the arguments.
-          ExprResult Arg0 = PerformCopyInitialization(
-            InitializedEntity::InitializeParameter(Context,
-                                                   FnDecl->getParamDecl(0)),
-            SourceLocation(), Args[0]);
-          if (Arg0.isInvalid())
-            return ExprError();
-
-          ExprResult Arg1 =
-            PerformCopyInitialization(
-              InitializedEntity::InitializeParameter(Context,
-                                                     FnDecl->getParamDecl(1)),
-              SourceLocation(), Args[1]);
-          if (Arg1.isInvalid())
-            return ExprError();
-          Args[0] = LHS = Arg0.getAs<Expr>();
-          Args[1] = RHS = Arg1.getAs<Expr>();
-        }
-
-        // Build the actual expression node.
-        ExprResult FnExpr = CreateFunctionRefExpr(*this, FnDecl,
-                                                  Best->FoundDecl,
-                                                  HadMultipleCandidates, OpLoc);
-        if (FnExpr.isInvalid())
-          return ExprError();
-
-        // Determine the result type.
-        QualType ResultTy = FnDecl->getReturnType();
-        ExprValueKind VK = Expr::getValueKindForType(ResultTy);
-        ResultTy = ResultTy.getNonLValueExprType(Context);
-
-        CXXOperatorCallExpr *TheCall =
-          new (Context) CXXOperatorCallExpr(Context, Op, FnExpr.get(),
-                                            Args, ResultTy, VK, OpLoc,
-                                            FPFeatures);
-
-        if (CheckCallReturnType(FnDecl->getReturnType(), OpLoc, TheCall,
-                                FnDecl))
-          return ExprError();
-
-        ArrayRef<const Expr *> ArgsArray(Args, 2);
-        const Expr *ImplicitThis = nullptr;
-        // Cut off the implicit 'this'.
-        if (isa<CXXMethodDecl>(FnDecl)) {
-          ImplicitThis = ArgsArray[0];
-          ArgsArray = ArgsArray.slice(1);
-        }
-
-        // Check for a self move.
-        if (Op == OO_Equal)
-          DiagnoseSelfMove(Args[0], Args[1], OpLoc);
-
-        checkCall(FnDecl, nullptr, ImplicitThis, ArgsArray,
-                  isa<CXXMethodDecl>(FnDecl), OpLoc, TheCall->getSourceRange(),
-                  VariadicDoesNotApply);
-
-        return MaybeBindToTemporary(TheCall);
+        if (Memoizable)
+          memoizeOverloadResolution(ID, Generation, CandidateSet, Best);
+        return BuildResolvedOverloadedBinOp(OpLoc, Opc, Args, FnDecl,
+                                            Best->FoundDecl,
+                                            HadMultipleCandidates);
       } else {
         // We matched a built-in operator. Convert the arguments, then
         // break out so that we will build the appropriate built-in
@@ -12464,7 +12659,8 @@ Sema::CreateOverloadedArraySubscriptExpr(SourceLocation LLoc,
     return ExprError();
 
   // Build an empty overload set.
-  OverloadCandidateSet CandidateSet(LLoc, OverloadCandidateSet::CSK_Operator);
+  OverloadCandidateSet CandidateSet(*this, LLoc,
+                                    OverloadCandidateSet::CSK_Operator);
 
   // Subscript can only be overloaded as a member function.
 
@@ -12695,7 +12891,7 @@ Sema::BuildCallToMemberFunction(Scope *S, Expr *MemExprE,
                             : UnresExpr->getBase()->Classify(Context);
 
     // Add overload candidates
-    OverloadCandidateSet CandidateSet(UnresExpr->getMemberLoc(),
+    OverloadCandidateSet CandidateSet(*this, UnresExpr->getMemberLoc(),
                                       OverloadCandidateSet::CSK_Normal);
 
     // FIXME: avoid copy.
@@ -12880,6 +13076,9 @@ Sema::BuildCallToMemberFunction(Scope *S, Expr *MemExprE,
                          MemExpr->getMemberLoc());
   }
 
+  if (isReflectionQuery(Method))
+    return BuildReflectionQueryCall(TheCall);
+
   return MaybeBindToTemporary(TheCall);
 }
 
@@ -12911,7 +13110,7 @@ Sema::BuildCallToObjectOfClassType(Scope *S, Expr *Obj,
   //  operators of T. The function call operators of T are obtained by
   //  ordinary lookup of the name operator() in the context of
   //  (E).operator().
-  OverloadCandidateSet CandidateSet(LParenLoc,
+  OverloadCandidateSet CandidateSet(*this, LParenLoc,
                                     OverloadCandidateSet::CSK_Operator);
   DeclarationName OpName = Context.DeclarationNames.getCXXOperatorName(OO_Call);
 
@@ -13188,7 +13387,8 @@ Sema::BuildOverloadedArrowExpr(Scope *S, Expr *Base, SourceLocation OpLoc,
   //   overload resolution mechanism (13.3).
   DeclarationName OpName =
     Context.DeclarationNames.getCXXOperatorName(OO_Arrow);
-  OverloadCandidateSet CandidateSet(Loc, OverloadCandidateSet::CSK_Operator);
+  OverloadCandidateSet CandidateSet(*this, Loc,
+                                    OverloadCandidateSet::CSK_Operator);
   const RecordType *BaseRecord = Base->getType()->getAs<RecordType>();
 
   if (RequireCompleteType(Loc, Base->getType(),
@@ -13294,7 +13494,7 @@ ExprResult Sema::BuildLiteralOperatorCall(LookupResult &R,
                                        TemplateArgumentListInfo *TemplateArgs) {
   SourceLocation UDSuffixLoc = SuffixInfo.getCXXLiteralOperatorNameLoc();
 
-  OverloadCandidateSet CandidateSet(UDSuffixLoc,
+  OverloadCandidateSet CandidateSet(*this, UDSuffixLoc,
                                     OverloadCandidateSet::CSK_Normal);
   AddFunctionCandidates(R.asUnresolvedSet(), Args, CandidateSet, TemplateArgs,
                         /*SuppressUserConversions=*/true);
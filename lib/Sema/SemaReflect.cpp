@@ -17,6 +17,7 @@
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Sema/Initialization.h"
 #include "clang/Sema/SemaInternal.h"
+#include "llvm/Support/SaveAndRestore.h"
 
 using namespace clang;
 using namespace sema;
@@ -280,8 +281,50 @@ ExprResult Sema::ActOnCXXReflexprExpr(Expr *E,
   return E;
 }
 
-static bool AppendStringValue(Sema& S, llvm::raw_ostream& OS, 
-                              const APValue& Val) {
+/// Returns a string literal that has the given name.
+static ExprResult MakeString(ASTContext &C, StringRef Str,
+                             SourceLocation Loc = SourceLocation()) {
+  llvm::APSInt Size = C.MakeIntValue(Str.size() + 1, C.getSizeType());
+  QualType Elem = C.getConstType(C.CharTy);
+  QualType Type = C.getConstantArrayType(Elem, Size, ArrayType::Normal, 0);
+  return StringLiteral::Create(C, Str, StringLiteral::Ascii, false, Type, Loc);
+}
+
+namespace {
+/// The value of one operand of idexpr or declname.
+struct NamePart {
+  enum PartKind { String, Integer, Identifier };
+  PartKind Kind;
+
+  /// The string literal or identifier that provides the text of the part.
+  /// This is null for the name of an anonymous class.
+  const void *Source;
+  StringRef Text;
+
+  /// The value of an integer part.
+  llvm::APSInt Value;
+
+  NamePart() : Kind(String), Source(nullptr) {}
+
+  void Profile(llvm::FoldingSetNodeID &ID) const {
+    ID.AddInteger(Kind);
+    if (Kind == Integer)
+      Value.Profile(ID);
+    else
+      ID.AddPointer(Source);
+  }
+
+  /// Append the text of the part to Buf.
+  void append(SmallVectorImpl<char> &Buf) const {
+    if (Kind == Integer)
+      Value.toString(Buf);
+    else
+      Buf.append(Text.begin(), Text.end());
+  }
+};
+} // end anonymous namespace
+
+static bool GetStringValue(Sema& S, const APValue& Val, NamePart &Part) {
   // Extracting the string valkue from the LValue.
   //
   // FIXME: We probably want something like EvaluateAsString in the Expr class.
@@ -290,7 +333,9 @@ static bool AppendStringValue(Sema& S, llvm::raw_ostream& OS,
     const Expr *BaseExpr = Base.get<const Expr *>();
     assert(isa<StringLiteral>(BaseExpr) && "Not a string literal");
     const StringLiteral *Str = cast<StringLiteral>(BaseExpr);
-    OS << Str->getString();
+    Part.Kind = NamePart::String;
+    Part.Source = Str;
+    Part.Text = Str->getString();
   } else {
     llvm_unreachable("Use of string variable not implemented");
     // const ValueDecl *D = Base.get<const ValueDecl *>();
@@ -300,8 +345,8 @@ static bool AppendStringValue(Sema& S, llvm::raw_ostream& OS,
 }
 
 
-static bool AppendCharacterArray(Sema& S, llvm::raw_ostream &OS, Expr *E, 
-                                 QualType T) {
+static bool EvaluateCharacterArray(Sema& S, Expr *E, QualType T,
+                                   NamePart &Part) {
   assert(T->isArrayType() && "Not an array type");
   const ArrayType *ArrayTy = cast<ArrayType>(T.getTypePtr());
 
@@ -312,6 +357,14 @@ static bool AppendCharacterArray(Sema& S, llvm::raw_ostream &OS, Expr *E,
     return false;
   }
 
+  // String literals are their own value.
+  if (auto *Str = dyn_cast<StringLiteral>(E->IgnoreParens())) {
+    Part.Kind = NamePart::String;
+    Part.Source = Str;
+    Part.Text = Str->getString();
+    return true;
+  }
+
   // Evaluate the expression.
   Expr::EvalResult Result;
   if (!E->EvaluateAsLValue(Result, S.Context)) {
@@ -320,11 +373,11 @@ static bool AppendCharacterArray(Sema& S, llvm::raw_ostream &OS, Expr *E,
     return false;
   }
 
-  return AppendStringValue(S, OS, Result.Val);
+  return GetStringValue(S, Result.Val, Part);
 }
 
-static bool AppendCharacterPointer(Sema& S, llvm::raw_ostream &OS, Expr *E, 
-                                   QualType T) {
+static bool EvaluateCharacterPointer(Sema& S, Expr *E, QualType T,
+                                     NamePart &Part) {
   assert(T->isPointerType() && "Not a pointer type");
   const PointerType* PtrTy = cast<PointerType>(T.getTypePtr());
 
@@ -343,21 +396,20 @@ static bool AppendCharacterPointer(Sema& S, llvm::raw_ostream &OS, Expr *E,
     return false;
   }
 
-  return AppendStringValue(S, OS, Result.Val);
+  return GetStringValue(S, Result.Val, Part);
 }
 
-static bool AppendInteger(Sema& S, llvm::raw_ostream &OS, Expr *E, QualType T) {
-  llvm::APSInt N;
-  if (!E->EvaluateAsInt(N, S.Context)) {
+static bool EvaluateInteger(Sema& S, Expr *E, QualType T, NamePart &Part) {
+  if (!E->EvaluateAsInt(Part.Value, S.Context)) {
     S.Diag(E->getLocStart(), diag::err_expr_not_ice) << 1;
     return false;
   }
-  OS << N;
+  Part.Kind = NamePart::Integer;
   return true;
 }
 
 static bool
-AppendReflection(Sema& S, llvm::raw_ostream &OS, Expr *E, QualType T) {
+EvaluateReflectedName(Sema& S, Expr *E, QualType T, NamePart &Part) {
   ReflectedConstruct RC = S.EvaluateReflection(E);
   if (Decl *D = RC.getAsDeclaration()) {
     // If this is a named declaration, append its identifier.
@@ -375,13 +427,17 @@ AppendReflection(Sema& S, llvm::raw_ostream &OS, Expr *E, QualType T) {
       S.Diag(E->getLocStart(), diag::err_idexpr_not_an_identifer) << Name;
       return false;
     }
-    
-    OS << ND->getName();
+
+    Part.Kind = NamePart::Identifier;
+    Part.Source = ND->getIdentifier();
+    Part.Text = ND->getName();
   } else if (Type *T = RC.getAsType()) {
     // If this is a class type, append its identifier.
-    if (auto *RC = T->getAsCXXRecordDecl())
-      OS << RC->getName();
-    else {
+    if (auto *RC = T->getAsCXXRecordDecl()) {
+      Part.Kind = NamePart::Identifier;
+      Part.Source = RC->getIdentifier();
+      Part.Text = RC->getName();
+    } else {
       S.Diag(E->getLocStart(), diag::err_idexpr_not_an_identifer) 
         << QualType(T, 0);
       return false;
@@ -393,10 +449,86 @@ AppendReflection(Sema& S, llvm::raw_ostream &OS, Expr *E, QualType T) {
   return true;
 }
 
+/// Evaluates the operand E of idexpr or declname into Part. IsFirst is true
+/// when E is the first operand. Returns false on error.
+static bool EvaluateNamePart(Sema &S, Expr *E, bool IsFirst, NamePart &Part) {
+  assert(!E->isTypeDependent() && !E->isValueDependent()
+      && "Dependent name component");
+
+  // Get the type of the reflection.
+  QualType T = E->getType();
+  if (AutoType *D = T->getContainedAutoType()) {
+    T = D->getDeducedType();
+    if (!T.getTypePtr())
+      llvm_unreachable("Undeduced value reflection");
+  }
+  T = S.Context.getCanonicalType(T);
+
+  SourceLocation ExprLoc = E->getLocStart();
+
+  // Evaluate the sub-expression (depending on type) in order to compute
+  // a string part that will constitute a declaration name.
+  if (T->isConstantArrayType())
+    return EvaluateCharacterArray(S, E, T, Part);
+  if (T->isPointerType())
+    return EvaluateCharacterPointer(S, E, T, Part);
+  if (T->isIntegerType()) {
+    if (IsFirst) {
+      // An identifier cannot start with an integer value.
+      S.Diag(ExprLoc, diag::err_idexpr_with_integer_prefix);
+      return false;
+    }
+    return EvaluateInteger(S, E, T, Part);
+  }
+  if (T->isRecordType())
+    return EvaluateReflectedName(S, E, T, Part);
+
+  S.Diag(ExprLoc, diag::err_idexpr_invalid_operand_type) << T;
+  return false;
+}
+
+static bool IsDependentPart(const Expr *E) {
+  return E->isTypeDependent() || E->isValueDependent();
+}
+
 static bool HasDependentParts(SmallVectorImpl<Expr *>& Parts) {
- return std::any_of(Parts.begin(), Parts.end(), [](const Expr *E) {
-    return E->isTypeDependent();
-  }); 
+  return std::any_of(Parts.begin(), Parts.end(), IsDependentPart);
+}
+
+/// Replaces each run of non-dependent operands in Parts with a string literal
+/// holding their text, so that instantiating the name only evaluates the
+/// dependent operands. Returns false on error.
+static bool FoldNonDependentParts(Sema &S, SmallVectorImpl<Expr *> &Parts) {
+  SmallVector<Expr *, 4> Folded;
+  for (std::size_t I = 0, N = Parts.size(); I != N;) {
+    if (IsDependentPart(Parts[I])) {
+      Folded.push_back(Parts[I++]);
+      continue;
+    }
+
+    std::size_t RunEnd = I + 1;
+    while (RunEnd != N && !IsDependentPart(Parts[RunEnd]))
+      ++RunEnd;
+
+    // A lone string literal is already as simple as it gets.
+    if (RunEnd == I + 1 && isa<StringLiteral>(Parts[I]->IgnoreParens())) {
+      Folded.push_back(Parts[I++]);
+      continue;
+    }
+
+    SmallString<64> Buf;
+    for (std::size_t J = I; J != RunEnd; ++J) {
+      NamePart Part;
+      if (!EvaluateNamePart(S, Parts[J], J == 0, Part))
+        return false;
+      Part.append(Buf);
+    }
+    ExprResult Str = MakeString(S.Context, Buf, Parts[I]->getLocStart());
+    Folded.push_back(Str.get());
+    I = RunEnd;
+  }
+  Parts.swap(Folded);
+  return true;
 }
 
 /// Constructs a new identifier from the expressions in Parts. Returns nullptr
@@ -405,8 +537,11 @@ DeclarationNameInfo Sema::BuildIdExprName(SourceLocation OpLoc,
                                           SmallVectorImpl<Expr *>& Parts,
                                           SourceLocation EndLoc) {
 
-  // If any components are dependent, we can't compute the name.
+  // If any components are dependent, we can't compute the name. Fold the
+  // ones that are not now, rather than in every instantiation.
   if (HasDependentParts(Parts)) {
+    if (!FoldNonDependentParts(*this, Parts))
+      return DeclarationNameInfo();
     DeclarationName Name
       = Context.DeclarationNames.getCXXIdExprName(Parts.size(), &Parts[0]);
     DeclarationNameInfo NameInfo(Name, OpLoc);
@@ -414,56 +549,35 @@ DeclarationNameInfo Sema::BuildIdExprName(SourceLocation OpLoc,
     return NameInfo;
   }
 
-  SmallString<256> Buf;
-  llvm::raw_svector_ostream OS(Buf);
+  SmallVector<NamePart, 4> Values(Parts.size());
+  llvm::FoldingSetNodeID ID;
   for (std::size_t I = 0; I < Parts.size(); ++I) {
-    Expr *E = Parts[I];
-
-    assert(!E->isTypeDependent() && !E->isValueDependent() 
-        && "Dependent name component");
-
-    // Get the type of the reflection.
-    QualType T = E->getType();
-    if (AutoType *D = T->getContainedAutoType()) {
-      T = D->getDeducedType();
-      if (!T.getTypePtr())
-        llvm_unreachable("Undeduced value reflection");
-    }
-    T = Context.getCanonicalType(T);
+    if (!EvaluateNamePart(*this, Parts[I], I == 0, Values[I]))
+      return DeclarationNameInfo();
+    Values[I].Profile(ID);
+  }
 
-    SourceLocation ExprLoc = E->getLocStart();
+  // Generators tend to synthesize the same names over and over; reuse the
+  // identifier if we have seen these values before.
+  IdentifierInfo *Id;
+  void *InsertPoint;
+  if (SynthesizedIdentifier *Known =
+          SynthesizedIdentifierCache.FindNodeOrInsertPos(ID, InsertPoint)) {
+    ++NumSynthesizedIdentifierHits;
+    Id = Known->Id;
+  } else {
+    SmallString<256> Buf;
+    for (const NamePart &Part : Values)
+      Part.append(Buf);
 
-    // Evaluate the sub-expression (depending on type) in order to compute
-    // a string part that will constitute a declaration name.
-    if (T->isConstantArrayType()) {
-      if (!AppendCharacterArray(*this, OS, E, T))
-        return DeclarationNameInfo();
-    }
-    else if (T->isPointerType()) {
-      if (!AppendCharacterPointer(*this, OS, E, T))
-        return DeclarationNameInfo();
-    }
-    else if (T->isIntegerType()) {
-      if (I == 0) {
-        // An identifier cannot start with an integer value.
-        Diag(ExprLoc, diag::err_idexpr_with_integer_prefix);
-        return DeclarationNameInfo();
-      }
-      if (!AppendInteger(*this, OS, E, T))
-        return DeclarationNameInfo();
-    }
-    else if (T->isRecordType()) {
-      if (!AppendReflection(*this, OS, E, T))
-        return DeclarationNameInfo();
-    }
-    else {
-      Diag(ExprLoc, diag::err_idexpr_invalid_operand_type) << T;
-      return DeclarationNameInfo();
-    }
+    // FIXME: Should we always return a declaration name?
+    Id = &PP.getIdentifierTable().get(Buf);
+    ++NumSynthesizedIdentifiers;
+    auto *Entry = BumpAlloc.Allocate<SynthesizedIdentifier>();
+    SynthesizedIdentifierCache.InsertNode(
+        new (Entry) SynthesizedIdentifier(ID, Id), InsertPoint);
   }
 
-  // FIXME: Should we always return a declaration name?
-  IdentifierInfo *Id = &PP.getIdentifierTable().get(Buf);
   DeclarationName Name = Context.DeclarationNames.getIdentifier(Id);
   return DeclarationNameInfo(Name, OpLoc);
 }
@@ -570,6 +684,7 @@ static char const *GetReflectionClass(Decl *D) {
 /// \brief Return an expression whose type reflects the given node.
 ExprResult Sema::BuildDeclReflection(SourceLocation Loc, Decl *D) {
   assert(!isa<MetaclassDecl>(D) && "Reflection of a metaclass");
+  ASTNodeOriginRAII Origin(Context, ASTNodeOrigin::ReflectionSpecialization);
 
   // References to a metaclass should refer to the underlying class.
   // FIXME: Handle this above.
@@ -667,6 +782,8 @@ static char const *GetReflectionClass(QualType T) {
 // TODO: There's a lot of duplication between this and the BuildDeclReflection
 // function above. Surely we can simplify.
 ExprResult Sema::BuildTypeReflection(SourceLocation Loc, QualType QT) {
+  ASTNodeOriginRAII Origin(Context, ASTNodeOrigin::ReflectionSpecialization);
+
   // Only operate on the canonical type. See through sugar and aliases.
   QT = Context.getCanonicalType(QT);
 
@@ -766,6 +883,44 @@ ClassTemplateDecl *Sema::RequireReflectionType(SourceLocation Loc,
   return Decl;
 }
 
+/// Returns true if \p FD is a constexpr function declared in cppx::meta,
+/// either directly or as a member of one of its classes.
+bool Sema::isReflectionQuery(const FunctionDecl *FD) {
+  if (!getLangOpts().Reflection || !FD->isConstexpr() ||
+      isa<CXXConstructorDecl>(FD) || FD->getReturnType()->isVoidType())
+    return false;
+
+  return FD->getDeclContext()->getEnclosingNamespaceContext()
+      ->isCppxMetaNamespace();
+}
+
+/// Replaces a call to the reflection library with its value, as if the
+/// callee were an immediate function, so that CodeGen emits the value (most
+/// often a pooled string) instead of a call to a tiny out-of-line function.
+///
+/// Calls that cannot be evaluated, because they take runtime arguments, are
+/// left alone.
+ExprResult Sema::BuildReflectionQueryCall(CallExpr *Call) {
+  // Calls in constant expressions are evaluated anyway, and those in
+  // unevaluated operands never are.
+  if (Call->isInstantiationDependent() || !Call->isRValue() ||
+      isUnevaluatedContext() || ExprEvalContexts.back().isConstantEvaluated())
+    return MaybeBindToTemporary(Call);
+  QualType T = Call->getType();
+  if (!T->isScalarType() && !T->isRecordType())
+    return MaybeBindToTemporary(Call);
+  if (const CXXRecordDecl *RD = T->getAsCXXRecordDecl())
+    if (!RD->hasTrivialDestructor())
+      return MaybeBindToTemporary(Call);
+
+  Expr::EvalResult Result;
+  if (!Call->EvaluateAsRValue(Result, Context) || Result.HasSideEffects)
+    return MaybeBindToTemporary(Call);
+
+  ++NumFoldedReflectionQueries;
+  return new (Context) CXXConstantExpr(Call, std::move(Result.Val));
+}
+
 /// Information supporting reflection operations.
 ///
 // TODO: Move all of the functions below into this class since it provides
@@ -895,15 +1050,6 @@ ExprResult Sema::ActOnReflectionTrait(SourceLocation KWLoc,
   llvm_unreachable("Unhandled reflection kind");
 }
 
-/// Returns a string literal that has the given name.
-static ExprResult MakeString(ASTContext &C, const std::string &Str) {
-  llvm::APSInt Size = C.MakeIntValue(Str.size() + 1, C.getSizeType());
-  QualType Elem = C.getConstType(C.CharTy);
-  QualType Type = C.getConstantArrayType(Elem, Size, ArrayType::Normal, 0);
-  return StringLiteral::Create(C, Str, StringLiteral::Ascii, false, Type,
-                               SourceLocation());
-}
-
 ExprResult Reflector::Reflect(ReflectionTrait RT, Decl *D) {
   switch (RT) {
   default:
@@ -2599,7 +2745,11 @@ bool Sema::EvaluateConstexprDeclCall(ConstexprDecl *CD, CallExpr *Call) {
   // Apply any modifications, and if successful, remove the declaration from
   // the class; it shouldn't be visible in the output code.
   SourceLocation POI = CD->getSourceRange().getEnd();
-  ApplyEffects(POI, Effects);
+  {
+    llvm::SaveAndRestore<ConstexprDecl *> SavedMetaprogram(CurrentMetaprogram,
+                                                           CD);
+    ApplyEffects(POI, Effects);
+  }
 
   // FIXME: Do we really want to remove the metaprogram after evaluation? Or
   // should we just mark it completed.
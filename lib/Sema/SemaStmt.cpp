@@ -2451,7 +2451,7 @@ Sema::BuildCXXForRangeStmt(SourceLocation ForLoc, SourceLocation CoawaitLoc,
         return StmtError();
       }
     } else {
-      OverloadCandidateSet CandidateSet(RangeLoc,
+      OverloadCandidateSet CandidateSet(*this, RangeLoc,
                                         OverloadCandidateSet::CSK_Normal);
       BeginEndFunction BEFFailure;
       ForRangeStatus RangeStatus =
@@ -3087,6 +3087,718 @@ StmtResult Sema::FinishCXXForRangeStmt(Stmt *S, Stmt *B) {
   return S;
 }
 
+namespace {
+/// \brief Compares the statements instantiated by a tuple expansion to find
+/// out whether they differ only in constant values.
+///
+/// The statement instantiated for the first element is the reference. Its
+/// leaves are its maximal scalar prvalue subexpressions that are constant
+/// expressions. The corresponding subexpressions of the other statements must
+/// be constant expressions of the same type, and their values are collected.
+/// Elsewhere, the statements must have the same shape and refer to the same
+/// declarations, up to the variables they declare themselves.
+class TupleExpansionRoller {
+public:
+  /// \brief A leaf of the reference statement and its value for each element.
+  struct Leaf {
+    QualType Type;
+    SmallVector<APValue, 8> Values;
+  };
+
+  /// \brief Where a leaf is found in a copy of the reference statement.
+  struct LeafSlot {
+    /// \brief The pointer to the leaf, or null if the leaf is the whole
+    /// initializer of \c Owner.
+    Stmt **Slot = nullptr;
+
+    /// \brief The variable whose initializer contains the leaf, if any.
+    VarDecl *Owner = nullptr;
+  };
+
+  TupleExpansionRoller(Sema &S, bool DropLoopVar)
+      : S(S), DropLoopVar(DropLoopVar), Element(0), InCopy(false) {}
+
+  /// \brief Compare the statement instantiated for element \p I to the
+  /// reference statement \p Ref, collecting the values of the leaves.
+  bool compareElement(Stmt *Ref, Stmt *Other, unsigned I);
+
+  /// \brief Compare a new instantiation of the reference statement to
+  /// \p Ref, collecting the slots of the leaves.
+  bool compareCopy(Stmt *Ref, Stmt *Copy);
+
+  ArrayRef<Leaf> leaves() const { return Leaves; }
+  ArrayRef<LeafSlot> slots() const { return Slots; }
+
+private:
+  bool compareBlocks(Stmt *Ref, Stmt *Other);
+  bool compare(Stmt *Ref, Stmt *Other, Stmt **Slot, VarDecl *Owner);
+  bool compareProfiles(const Stmt *Ref, const Stmt *Other);
+  bool compareDecls(DeclStmt *Ref, DeclStmt *Other);
+  bool isSameDecl(const Decl *Ref, const Decl *Other) const;
+  int getLeaf(const Expr *E);
+  bool addLeaf(int Index, const Expr *Other, Stmt **Slot, VarDecl *Owner);
+
+  Sema &S;
+
+  /// \brief Whether the loop variables are left out of the comparison.
+  bool DropLoopVar;
+
+  /// \brief The element being compared to the reference.
+  unsigned Element;
+
+  /// \brief Whether the statement being compared is the copy.
+  bool InCopy;
+
+  SmallVector<Leaf, 4> Leaves;
+  SmallVector<LeafSlot, 4> Slots;
+
+  /// \brief The index in \c Leaves of each leaf of the reference statement,
+  /// or -1 for the other scalar prvalues evaluated so far.
+  llvm::DenseMap<const Expr *, int> RefLeaves;
+
+  /// \brief The variables declared by the statement being compared, mapped
+  /// to the corresponding variables of the reference statement.
+  llvm::DenseMap<const Decl *, const Decl *> DeclMap;
+};
+} // end anonymous namespace
+
+bool TupleExpansionRoller::compareElement(Stmt *Ref, Stmt *Other,
+                                          unsigned I) {
+  Element = I;
+  DeclMap.clear();
+  if (!compareBlocks(Ref, Other))
+    return false;
+  for (const Leaf &L : Leaves)
+    if (L.Values.size() != I + 1)
+      return false;
+  return true;
+}
+
+bool TupleExpansionRoller::compareCopy(Stmt *Ref, Stmt *Copy) {
+  Element = 0;
+  InCopy = true;
+  DeclMap.clear();
+  Slots.assign(Leaves.size(), LeafSlot());
+  if (!compareBlocks(Ref, Copy))
+    return false;
+  for (const LeafSlot &L : Slots)
+    if (!L.Slot && !L.Owner)
+      return false;
+  return true;
+}
+
+/// Compare two instantiations of the block that declares the loop variable
+/// and contains the loop body.
+bool TupleExpansionRoller::compareBlocks(Stmt *Ref, Stmt *Other) {
+  auto *RefBlock = dyn_cast<CompoundStmt>(Ref);
+  auto *OtherBlock = dyn_cast<CompoundStmt>(Other);
+  if (!RefBlock || !OtherBlock || RefBlock->size() != 2 ||
+      OtherBlock->size() != 2)
+    return false;
+
+  // A dropped loop variable is not mapped, so any reference to it outside
+  // of a leaf makes the bodies differ.
+  Stmt **OtherBody = OtherBlock->body_begin();
+  if (!DropLoopVar &&
+      !compare(RefBlock->body_front(), OtherBody[0], &OtherBody[0], nullptr))
+    return false;
+  return compare(RefBlock->body_back(), OtherBody[1], &OtherBody[1], nullptr);
+}
+
+bool TupleExpansionRoller::compare(Stmt *Ref, Stmt *Other, Stmt **Slot,
+                                   VarDecl *Owner) {
+  if (!Ref || !Other)
+    return !Ref && !Other;
+
+  if (auto *RefE = dyn_cast<Expr>(Ref)) {
+    auto *OtherE = dyn_cast<Expr>(Other);
+    if (!OtherE || !S.Context.hasSameType(RefE->getType(), OtherE->getType()) ||
+        RefE->getValueKind() != OtherE->getValueKind() ||
+        RefE->getObjectKind() != OtherE->getObjectKind())
+      return false;
+    int Index = getLeaf(RefE);
+    if (Index >= 0)
+      return addLeaf(Index, OtherE, Slot, Owner);
+  }
+
+  if (Ref->getStmtClass() != Other->getStmtClass())
+    return false;
+
+  switch (Ref->getStmtClass()) {
+  default:
+    return compareProfiles(Ref, Other);
+
+  // Case values and labels cannot be read from a table, and nested
+  // expansions and closures would have to be built again.
+  case Stmt::SwitchStmtClass:
+  case Stmt::CaseStmtClass:
+  case Stmt::DefaultStmtClass:
+  case Stmt::LabelStmtClass:
+  case Stmt::GotoStmtClass:
+  case Stmt::IndirectGotoStmtClass:
+  case Stmt::CXXTupleExpansionStmtClass:
+  case Stmt::CXXPackExpansionStmtClass:
+  case Stmt::LambdaExprClass:
+  case Stmt::BlockExprClass:
+    return false;
+
+  case Stmt::DeclStmtClass:
+    return compareDecls(cast<DeclStmt>(Ref), cast<DeclStmt>(Other));
+
+  case Stmt::CompoundStmtClass:
+  case Stmt::NullStmtClass:
+  case Stmt::WhileStmtClass:
+  case Stmt::DoStmtClass:
+  case Stmt::ForStmtClass:
+  case Stmt::CXXForRangeStmtClass:
+  case Stmt::BreakStmtClass:
+  case Stmt::ContinueStmtClass:
+  case Stmt::ParenExprClass:
+  case Stmt::ArraySubscriptExprClass:
+  case Stmt::ConditionalOperatorClass:
+  case Stmt::CXXBindTemporaryExprClass:
+  case Stmt::CXXThisExprClass:
+    break;
+
+  case Stmt::IfStmtClass:
+    if (cast<IfStmt>(Ref)->isConstexpr() != cast<IfStmt>(Other)->isConstexpr())
+      return false;
+    break;
+
+  case Stmt::ReturnStmtClass:
+    if (!isSameDecl(cast<ReturnStmt>(Ref)->getNRVOCandidate(),
+                    cast<ReturnStmt>(Other)->getNRVOCandidate()))
+      return false;
+    break;
+
+  case Stmt::DeclRefExprClass: {
+    auto *RefDRE = cast<DeclRefExpr>(Ref);
+    auto *OtherDRE = cast<DeclRefExpr>(Other);
+    if (!isSameDecl(RefDRE->getDecl(), OtherDRE->getDecl()) ||
+        RefDRE->refersToEnclosingVariableOrCapture() !=
+            OtherDRE->refersToEnclosingVariableOrCapture())
+      return false;
+    break;
+  }
+
+  case Stmt::MemberExprClass: {
+    auto *RefME = cast<MemberExpr>(Ref);
+    auto *OtherME = cast<MemberExpr>(Other);
+    if (RefME->getMemberDecl() != OtherME->getMemberDecl() ||
+        RefME->isArrow() != OtherME->isArrow())
+      return false;
+    break;
+  }
+
+  case Stmt::CallExprClass:
+  case Stmt::CXXMemberCallExprClass:
+  case Stmt::CXXOperatorCallExprClass:
+    // Builtins may require some of their arguments to be constants.
+    if (cast<CallExpr>(Ref)->getBuiltinCallee())
+      return compareProfiles(Ref, Other);
+    break;
+
+  case Stmt::ImplicitCastExprClass:
+  case Stmt::CStyleCastExprClass:
+  case Stmt::CXXFunctionalCastExprClass:
+  case Stmt::CXXStaticCastExprClass:
+  case Stmt::CXXConstCastExprClass: {
+    auto *RefCE = cast<CastExpr>(Ref);
+    auto *OtherCE = cast<CastExpr>(Other);
+    if (RefCE->getCastKind() != OtherCE->getCastKind() ||
+        RefCE->path_size() != OtherCE->path_size())
+      return false;
+    break;
+  }
+
+  case Stmt::UnaryOperatorClass:
+    if (cast<UnaryOperator>(Ref)->getOpcode() !=
+        cast<UnaryOperator>(Other)->getOpcode())
+      return false;
+    break;
+
+  case Stmt::BinaryOperatorClass:
+  case Stmt::CompoundAssignOperatorClass:
+    if (cast<BinaryOperator>(Ref)->getOpcode() !=
+        cast<BinaryOperator>(Other)->getOpcode())
+      return false;
+    if (auto *RefCAO = dyn_cast<CompoundAssignOperator>(Ref)) {
+      auto *OtherCAO = cast<CompoundAssignOperator>(Other);
+      if (!S.Context.hasSameType(RefCAO->getComputationLHSType(),
+                                 OtherCAO->getComputationLHSType()) ||
+          !S.Context.hasSameType(RefCAO->getComputationResultType(),
+                                 OtherCAO->getComputationResultType()))
+        return false;
+    }
+    break;
+
+  case Stmt::CXXConstructExprClass:
+  case Stmt::CXXTemporaryObjectExprClass: {
+    auto *RefCE = cast<CXXConstructExpr>(Ref);
+    auto *OtherCE = cast<CXXConstructExpr>(Other);
+    if (RefCE->getConstructor() != OtherCE->getConstructor() ||
+        RefCE->isElidable() != OtherCE->isElidable() ||
+        RefCE->getConstructionKind() != OtherCE->getConstructionKind() ||
+        RefCE->requiresZeroInitialization() !=
+            OtherCE->requiresZeroInitialization() ||
+        RefCE->isListInitialization() != OtherCE->isListInitialization() ||
+        RefCE->isStdInitListInitialization() !=
+            OtherCE->isStdInitListInitialization())
+      return false;
+    break;
+  }
+
+  case Stmt::MaterializeTemporaryExprClass: {
+    auto *RefMTE = cast<MaterializeTemporaryExpr>(Ref);
+    auto *OtherMTE = cast<MaterializeTemporaryExpr>(Other);
+    if (RefMTE->getStorageDuration() != OtherMTE->getStorageDuration() ||
+        !isSameDecl(RefMTE->getExtendingDecl(), OtherMTE->getExtendingDecl()))
+      return false;
+    break;
+  }
+
+  case Stmt::ExprWithCleanupsClass: {
+    auto *RefEWC = cast<ExprWithCleanups>(Ref);
+    auto *OtherEWC = cast<ExprWithCleanups>(Other);
+    if (RefEWC->getNumObjects() || OtherEWC->getNumObjects() ||
+        RefEWC->cleanupsHaveSideEffects() !=
+            OtherEWC->cleanupsHaveSideEffects())
+      return false;
+    break;
+  }
+
+  case Stmt::CXXDefaultArgExprClass:
+    if (cast<CXXDefaultArgExpr>(Ref)->getParam() !=
+        cast<CXXDefaultArgExpr>(Other)->getParam())
+      return false;
+    break;
+  }
+
+  Stmt::child_range RefChildren = Ref->children();
+  Stmt::child_range OtherChildren = Other->children();
+  Stmt::child_iterator RefChild = RefChildren.begin();
+  Stmt::child_iterator OtherChild = OtherChildren.begin();
+  for (; RefChild != RefChildren.end() && OtherChild != OtherChildren.end();
+       ++RefChild, ++OtherChild)
+    if (!compare(*RefChild, *OtherChild, &*OtherChild, Owner))
+      return false;
+  return RefChild == RefChildren.end() && OtherChild == OtherChildren.end();
+}
+
+/// Compare nodes that are not looked into as a whole. Since declarations are
+/// profiled by address, nodes that refer to the variables declared by the
+/// statements never compare equal.
+bool TupleExpansionRoller::compareProfiles(const Stmt *Ref,
+                                           const Stmt *Other) {
+  llvm::FoldingSetNodeID RefID, OtherID;
+  Ref->Profile(RefID, S.Context, /*Canonical=*/true);
+  Other->Profile(OtherID, S.Context, /*Canonical=*/true);
+  return RefID == OtherID;
+}
+
+bool TupleExpansionRoller::compareDecls(DeclStmt *Ref, DeclStmt *Other) {
+  DeclStmt::decl_iterator RefDecl = Ref->decl_begin();
+  DeclStmt::decl_iterator OtherDecl = Other->decl_begin();
+  for (; RefDecl != Ref->decl_end() && OtherDecl != Other->decl_end();
+       ++RefDecl, ++OtherDecl) {
+    // Only automatic variables are declared anew on every iteration of a
+    // loop.
+    auto *RefVar = dyn_cast<VarDecl>(*RefDecl);
+    auto *OtherVar = dyn_cast<VarDecl>(*OtherDecl);
+    if (!RefVar || !OtherVar || !RefVar->isLocalVarDecl() ||
+        !RefVar->hasLocalStorage() || RefVar->hasAttrs() ||
+        !OtherVar->isLocalVarDecl() || !OtherVar->hasLocalStorage() ||
+        OtherVar->hasAttrs())
+      return false;
+    if (!S.Context.hasSameType(RefVar->getType(), OtherVar->getType()) ||
+        RefVar->getInitStyle() != OtherVar->getInitStyle() ||
+        RefVar->isConstexpr() != OtherVar->isConstexpr() ||
+        RefVar->isNRVOVariable() != OtherVar->isNRVOVariable())
+      return false;
+    DeclMap[OtherVar] = RefVar;
+    if (!compare(RefVar->getInit(), OtherVar->getInit(), nullptr, OtherVar))
+      return false;
+  }
+  return RefDecl == Ref->decl_end() && OtherDecl == Other->decl_end();
+}
+
+bool TupleExpansionRoller::isSameDecl(const Decl *Ref,
+                                      const Decl *Other) const {
+  if (const Decl *Mapped = DeclMap.lookup(Other))
+    return Mapped == Ref;
+  return Ref == Other;
+}
+
+/// Returns the index of the leaf \p E of the reference statement, or -1 if
+/// \p E is not a leaf.
+int TupleExpansionRoller::getLeaf(const Expr *E) {
+  QualType T = E->getType();
+  if (!E->isRValue() || E->isValueDependent() ||
+      !(T->isIntegralOrEnumerationType() || T->isRealFloatingType() ||
+        T->isPointerType()))
+    return -1;
+
+  auto Known = RefLeaves.find(E);
+  if (Known != RefLeaves.end())
+    return Known->second;
+
+  APValue Value;
+  int Index = -1;
+  if (E->isCXX11ConstantExpr(S.Context, &Value)) {
+    Index = Leaves.size();
+    Leaves.emplace_back();
+    Leaves.back().Type = T.getUnqualifiedType();
+    Leaves.back().Values.push_back(std::move(Value));
+  }
+  RefLeaves[E] = Index;
+  return Index;
+}
+
+bool TupleExpansionRoller::addLeaf(int Index, const Expr *Other, Stmt **Slot,
+                                   VarDecl *Owner) {
+  if (InCopy) {
+    Slots[Index].Slot = Slot;
+    Slots[Index].Owner = Owner;
+    return true;
+  }
+
+  Leaf &L = Leaves[Index];
+  APValue Value;
+  if (L.Values.size() != Element || Other->isValueDependent() ||
+      !Other->isCXX11ConstantExpr(S.Context, &Value))
+    return false;
+  L.Values.push_back(std::move(Value));
+  return true;
+}
+
+/// Returns true if the values \p A and \p B of a leaf are the same.
+static bool isSameLeafValue(const APValue &A, const APValue &B) {
+  if (A.getKind() != B.getKind())
+    return false;
+  switch (A.getKind()) {
+  case APValue::Int:
+    return llvm::APSInt::isSameValue(A.getInt(), B.getInt());
+  case APValue::Float:
+    return A.getFloat().bitwiseIsEqual(B.getFloat());
+  case APValue::LValue:
+    return A.getLValueBase() == B.getLValueBase() &&
+           A.getLValueOffset() == B.getLValueOffset() &&
+           A.getLValueCallIndex() == B.getLValueCallIndex() &&
+           A.isNullPointer() == B.isNullPointer();
+  default:
+    return false;
+  }
+}
+
+/// Returns true if the loop variable \p Var of an expansion holds no state
+/// and is initialized without side effects, so that it can be left out of a
+/// loop that does not use it.
+///
+/// Calls to constexpr functions whose operands have no side effects are
+/// assumed to have none. This covers the \c get functions of the reflection
+/// library, which return an empty object whose type names the element.
+static bool isStatelessLoopVariable(ASTContext &Context, const VarDecl *Var) {
+  const CXXRecordDecl *Class = Var->getType()->getAsCXXRecordDecl();
+  const Expr *Init = Var->getInit();
+  if (!Class || !Class->hasDefinition() || !Class->isEmpty() ||
+      !Class->hasTrivialDestructor() || !Init ||
+      Init->HasSideEffects(Context, /*IncludePossibleEffects=*/false))
+    return false;
+
+  SmallVector<const Stmt *, 8> Worklist(1, Init);
+  while (!Worklist.empty()) {
+    const Stmt *S = Worklist.pop_back_val();
+    if (const auto *Call = dyn_cast<CallExpr>(S)) {
+      const FunctionDecl *Callee = Call->getDirectCallee();
+      if (!Callee || !Callee->isConstexpr())
+        return false;
+    } else if (const auto *Construct = dyn_cast<CXXConstructExpr>(S)) {
+      const CXXConstructorDecl *Ctor = Construct->getConstructor();
+      if (!Ctor->isConstexpr() && !Ctor->isTrivial())
+        return false;
+    }
+    for (const Stmt *Child : S->children())
+      if (Child)
+        Worklist.push_back(Child);
+  }
+  return true;
+}
+
+/// Returns true if \p S refers to the declaration \p D.
+static bool refersToDecl(const Stmt *S, const Decl *D) {
+  if (const auto *DRE = dyn_cast<DeclRefExpr>(S))
+    if (DRE->getDecl() == D)
+      return true;
+  for (const Stmt *Child : S->children())
+    if (Child && refersToDecl(Child, D))
+      return true;
+  return false;
+}
+
+/// Build a constant of type \p T with value \p Value, to initialize an
+/// element of the table of a leaf. Return null if the value cannot be
+/// spelled.
+static Expr *BuildExpansionTableElement(Sema &S, QualType T,
+                                        const APValue &Value,
+                                        SourceLocation Loc) {
+  ASTContext &Context = S.Context;
+  if (Value.isInt()) {
+    if (T->isBooleanType())
+      return new (Context)
+          CXXBoolLiteralExpr(Value.getInt().getBoolValue(), T, Loc);
+    QualType IntTy = T;
+    if (const EnumType *ET = T->getAs<EnumType>())
+      IntTy = ET->getDecl()->getIntegerType();
+    if (IntTy.isNull() || IntTy->isBooleanType())
+      return nullptr;
+    Expr *E = IntegerLiteral::Create(Context, Value.getInt(), IntTy, Loc);
+    if (IntTy != T)
+      E = ImplicitCastExpr::Create(Context, T, CK_IntegralCast, E, nullptr,
+                                   VK_RValue);
+    return E;
+  }
+
+  if (Value.isFloat())
+    return FloatingLiteral::Create(Context, Value.getFloat(), /*isexact=*/true,
+                                   T, Loc);
+
+  // Pointers are spelled only if they are null or point to the start of a
+  // string literal, as names returned by the reflection library do.
+  if (Value.isLValue() && T->isPointerType()) {
+    if (Value.isNullPointer() && !Value.getLValueBase())
+      return ImplicitCastExpr::Create(
+          Context, T, CK_NullToPointer,
+          new (Context) CXXNullPtrLiteralExpr(Context.NullPtrTy, Loc), nullptr,
+          VK_RValue);
+    const auto *String = dyn_cast_or_null<StringLiteral>(
+        Value.getLValueBase().dyn_cast<const Expr *>());
+    if (!String || !Value.getLValueOffset().isZero() ||
+        !Context.hasSameType(Context.getArrayDecayedType(String->getType()),
+                             T))
+      return nullptr;
+    return ImplicitCastExpr::Create(Context, T, CK_ArrayToPointerDecay,
+                                    const_cast<StringLiteral *>(String),
+                                    nullptr, VK_RValue);
+  }
+
+  return nullptr;
+}
+
+/// Build the static table of the values of a leaf, indexed by element.
+static VarDecl *BuildExpansionTable(Sema &S, QualType ElementType,
+                                    MutableArrayRef<Expr *> Elements,
+                                    SourceLocation Loc) {
+  ASTContext &Context = S.Context;
+  llvm::APInt Size(Context.getTypeSize(Context.getSizeType()),
+                   Elements.size());
+  QualType Type = Context.getConstantArrayType(
+      Context.getConstType(ElementType), Size, ArrayType::Normal, 0);
+  VarDecl *Table = VarDecl::Create(
+      Context, S.CurContext, Loc, Loc, &Context.Idents.get("__expansion_table"),
+      Type, Context.getTrivialTypeSourceInfo(Type, Loc), SC_Static);
+  Table->setImplicit();
+  Table->setConstexpr(true);
+
+  // Number the table like any other static local so that the tables of a
+  // function get distinct mangled names.
+  Decl *ManglingContextDecl;
+  if (MangleNumberingContext *MCtx = S.getCurrentMangleNumberContext(
+          Table->getDeclContext(), ManglingContextDecl)) {
+    Context.setManglingNumber(
+        Table, MCtx->getManglingNumber(Table, /*MSLocalManglingNumber=*/0));
+    Context.setStaticLocalNumber(Table, MCtx->getStaticLocalNumber(Table));
+  }
+
+  ExprResult Init = S.ActOnInitList(Loc, Elements, Loc);
+  if (Init.isInvalid())
+    return nullptr;
+  S.AddInitializerToDecl(Table, Init.get(), /*DirectInit=*/false);
+  if (Table->isInvalidDecl())
+    return nullptr;
+  S.FinalizeDeclaration(Table);
+  return Table;
+}
+
+static DeclRefExpr *BuildExpansionVarRef(Sema &S, VarDecl *Var,
+                                         SourceLocation Loc) {
+  Var->setReferenced();
+  Var->markUsed(S.Context);
+  return DeclRefExpr::Create(S.Context, NestedNameSpecifierLoc(),
+                             SourceLocation(), Var,
+                             /*RefersToEnclosingVariableOrCapture=*/false, Loc,
+                             Var->getType(), VK_LValue);
+}
+
+/// If the statements instantiated by \p Expansion differ only in constant
+/// values, build a loop that runs a new instantiation of the first of them
+/// once per element, reading those values from static tables:
+///
+/// \code
+///   {
+///     static constexpr T __expansion_table[N] = { ... };
+///     for (std::size_t __i = 0; __i != N; ++__i)
+///       statement-with-leaves-replaced-by-__expansion_table[__i]
+///   }
+/// \endcode
+///
+/// Return null if the statements must be emitted one by one.
+static Stmt *
+BuildRolledTupleExpansion(Sema &S, CXXTupleExpansionStmt *Expansion,
+                          llvm::function_ref<StmtResult()> InstantiateFirst) {
+  ASTContext &Context = S.Context;
+  ArrayRef<Stmt *> Stmts = Expansion->getInstantiatedStatements();
+  if (!S.getLangOpts().RollExpansionStatements || Stmts.size() < 2 ||
+      S.CurContext->isDependentContext())
+    return nullptr;
+
+  // Constant evaluation reads the instantiated statements, so functions that
+  // can be evaluated, including metaprograms, gain nothing.
+  FunctionDecl *Fn = S.getCurFunctionDecl();
+  if (!Fn || Fn->isConstexpr())
+    return nullptr;
+
+  // Leave the loop variable out if it holds no state for any element. It may
+  // then be used in leaves only.
+  bool DropLoopVar = true;
+  for (Stmt *Instantiation : Stmts) {
+    auto *Block = dyn_cast<CompoundStmt>(Instantiation);
+    auto *LoopVarStmt =
+        Block ? dyn_cast_or_null<DeclStmt>(Block->body_front()) : nullptr;
+    if (!LoopVarStmt || !LoopVarStmt->isSingleDecl() ||
+        !isa<VarDecl>(LoopVarStmt->getSingleDecl()))
+      return nullptr;
+    DropLoopVar &= isStatelessLoopVariable(
+        Context, cast<VarDecl>(LoopVarStmt->getSingleDecl()));
+  }
+
+  TupleExpansionRoller Roller(S, DropLoopVar);
+  for (unsigned I = 1; I != Stmts.size(); ++I)
+    if (!Roller.compareElement(Stmts[0], Stmts[I], I))
+      return nullptr;
+
+  // Spell the values of the leaves that differ between elements.
+  SourceLocation Loc = Expansion->getColonLoc();
+  ArrayRef<TupleExpansionRoller::Leaf> Leaves = Roller.leaves();
+  SmallVector<SmallVector<Expr *, 8>, 4> Elements(Leaves.size());
+  for (unsigned L = 0; L != Leaves.size(); ++L) {
+    ArrayRef<APValue> Values = Leaves[L].Values;
+    if (std::all_of(Values.begin(), Values.end(), [&](const APValue &V) {
+          return isSameLeafValue(V, Values.front());
+        }))
+      continue;
+    for (const APValue &V : Values) {
+      Expr *E = BuildExpansionTableElement(S, Leaves[L].Type, V, Loc);
+      if (!E)
+        return nullptr;
+      Elements[L].push_back(E);
+    }
+  }
+
+  // Instantiate the statement once more; the copy becomes the loop body.
+  // Its diagnostics were issued for the first element already.
+  StmtResult Copy;
+  {
+    DiagnosticsEngine &Diags = S.getDiagnostics();
+    bool Suppress = Diags.getSuppressAllDiagnostics();
+    Diags.setSuppressAllDiagnostics(true);
+    Copy = InstantiateFirst();
+    Diags.setSuppressAllDiagnostics(Suppress);
+  }
+  if (Copy.isInvalid() || !Roller.compareCopy(Stmts[0], Copy.get()))
+    return nullptr;
+
+  QualType SizeType = Context.getSizeType();
+  VarDecl *IndexVar = VarDecl::Create(
+      Context, S.CurContext, Loc, Loc, &Context.Idents.get("__i"), SizeType,
+      Context.getTrivialTypeSourceInfo(SizeType, Loc), SC_None);
+  IndexVar->setImplicit();
+  llvm::APInt Zero(Context.getTypeSize(SizeType), 0);
+  IndexVar->setInit(IntegerLiteral::Create(Context, Zero, SizeType, Loc));
+
+  // Replace the leaves of the copy that differ between elements by loads
+  // from tables, which are shared between leaves with the same values. Such
+  // a leaf depends on the element, so the copy rebuilt it and the nodes that
+  // contain it. A leaf with the same value for every element may be part of
+  // a subtree that the copy shares with the other instantiations and with
+  // the pattern, so it stays as it is; code generation folds it. It may not
+  // use the loop variable left out.
+  const VarDecl *CopyLoopVar = nullptr;
+  if (DropLoopVar)
+    CopyLoopVar = cast<VarDecl>(
+        cast<DeclStmt>(cast<CompoundStmt>(Copy.get())->body_front())
+            ->getSingleDecl());
+  SmallVector<Stmt *, 4> Block;
+  SmallVector<VarDecl *, 4> Tables(Leaves.size(), nullptr);
+  for (unsigned L = 0; L != Leaves.size(); ++L) {
+    const TupleExpansionRoller::LeafSlot &Slot = Roller.slots()[L];
+    if (Elements[L].empty()) {
+      Expr *Leaf = Slot.Slot ? cast<Expr>(*Slot.Slot) : Slot.Owner->getInit();
+      if (CopyLoopVar && refersToDecl(Leaf, CopyLoopVar))
+        return nullptr;
+      continue;
+    }
+
+    for (unsigned Prev = 0; Prev != L && !Tables[L]; ++Prev) {
+      if (Tables[Prev] &&
+          Context.hasSameType(Leaves[Prev].Type, Leaves[L].Type) &&
+          std::equal(Leaves[L].Values.begin(), Leaves[L].Values.end(),
+                     Leaves[Prev].Values.begin(), isSameLeafValue))
+        Tables[L] = Tables[Prev];
+    }
+    if (!Tables[L]) {
+      Tables[L] = BuildExpansionTable(S, Leaves[L].Type, Elements[L], Loc);
+      if (!Tables[L])
+        return nullptr;
+      Block.push_back(new (Context)
+                          DeclStmt(DeclGroupRef(Tables[L]), Loc, Loc));
+    }
+
+    ExprResult Index =
+        S.DefaultLvalueConversion(BuildExpansionVarRef(S, IndexVar, Loc));
+    if (Index.isInvalid())
+      return nullptr;
+    ExprResult Load = S.CreateBuiltinArraySubscriptExpr(
+        BuildExpansionVarRef(S, Tables[L], Loc), Loc, Index.get(), Loc);
+    if (!Load.isInvalid())
+      Load = S.DefaultLvalueConversion(Load.get());
+    if (Load.isInvalid())
+      return nullptr;
+
+    // Replacing part of an initializer also discards any value evaluated for
+    // the variable. A variable initialized from a table is no longer a
+    // constant.
+    if (Slot.Slot)
+      *Slot.Slot = Load.get();
+    if (VarDecl *Owner = Slot.Owner) {
+      Owner->setInit(Slot.Slot ? Owner->getInit() : Load.get());
+      Owner->setConstexpr(false);
+    }
+  }
+
+  Stmt *Body = Copy.get();
+  if (DropLoopVar)
+    Body = cast<CompoundStmt>(Body)->body_back();
+
+  // Build 'for (std::size_t __i = 0; __i != N; ++__i) body'.
+  llvm::APInt Size(Context.getTypeSize(SizeType), Stmts.size());
+  Expr *Comparison = new (Context) BinaryOperator(
+      S.DefaultLvalueConversion(BuildExpansionVarRef(S, IndexVar, Loc)).get(),
+      IntegerLiteral::Create(Context, Size, SizeType, Loc), BO_NE,
+      Context.BoolTy, VK_RValue, OK_Ordinary, Loc, FPOptions());
+  Expr *Increment =
+      new (Context) UnaryOperator(BuildExpansionVarRef(S, IndexVar, Loc),
+                                  UO_PreInc, SizeType, VK_LValue, OK_Ordinary,
+                                  Loc);
+  StmtResult Loop = S.ActOnForStmt(
+      Loc, Loc, new (Context) DeclStmt(DeclGroupRef(IndexVar), Loc, Loc),
+      S.ActOnCondition(nullptr, Loc, Comparison, Sema::ConditionKind::Boolean),
+      S.MakeFullDiscardedValueExpr(Increment), Loc, Body);
+  if (Loop.isInvalid())
+    return nullptr;
+  Block.push_back(Loop.get());
+  return new (Context) CompoundStmt(Context, Block, Loc, Loc);
+}
+
 /// Finish a tuple expansion by instantiating the loop body for each element
 /// of the tuple.
 StmtResult Sema::FinishCXXTupleExpansionStmt(CXXTupleExpansionStmt *S,
@@ -3116,9 +3828,8 @@ StmtResult Sema::FinishCXXTupleExpansionStmt(CXXTupleExpansionStmt *S,
   Stmt *Body = new (Context)
       CompoundStmt(Context, VarAndBody, SourceLocation(), SourceLocation());
 
-  // Instantiate the loop body for each element of the tuple.
-  llvm::SmallVector<Stmt *, 8> Stmts;
-  for (std::size_t I = 0; I < S->getSize(); ++I) {
+  // Instantiate the loop body for element I of the tuple.
+  auto InstantiateElement = [&](std::size_t I) -> StmtResult {
     IntegerLiteral *E = IntegerLiteral::Create(
         Context, llvm::APSInt::getUnsigned(I), Context.getSizeType(), Loc);
     TemplateArgument Args[] = {TemplateArgument(
@@ -3153,7 +3864,12 @@ StmtResult Sema::FinishCXXTupleExpansionStmt(CXXTupleExpansionStmt *S,
 
     InstantiatingTemplate Inst(*this, B->getLocStart(), S, Args,
                                B->getSourceRange());
-    StmtResult Instantiation = SubstForTupleBody(Body, MultiArgs);
+    return SubstForTupleBody(Body, MultiArgs);
+  };
+
+  llvm::SmallVector<Stmt *, 8> Stmts;
+  for (std::size_t I = 0; I < S->getSize(); ++I) {
+    StmtResult Instantiation = InstantiateElement(I);
     if (Instantiation.isInvalid())
       return StmtError();
     Stmts.push_back(Instantiation.get());
@@ -3163,6 +3879,11 @@ StmtResult Sema::FinishCXXTupleExpansionStmt(CXXTupleExpansionStmt *S,
   std::copy(Stmts.begin(), Stmts.end(), Results);
   S->setInstantiatedStatements(Results);
 
+  // Let code generation emit a single loop when the instantiations differ
+  // only in constants.
+  S->setRolledStatement(BuildRolledTupleExpansion(
+      *this, S, [&] { return InstantiateElement(0); }));
+
   return S;
 }
 
@@ -371,8 +371,14 @@ void Sema::pushCodeSynthesisContext(CodeSynthesisContext Ctx) {
 
   CodeSynthesisContexts.push_back(Ctx);
 
-  if (!Ctx.isInstantiationRecord())
+  if (!Ctx.isInstantiationRecord()) {
     ++NonInstantiationEntries;
+  } else if (ASTMemoryReport *Report = Context.getMemoryReport()) {
+    // Attribute the nodes built while instantiating to instantiation. Other
+    // contexts, such as declaring special members or injecting source code,
+    // keep the origin of the code that triggered them.
+    Report->pushOrigin(ASTNodeOrigin::Instantiated);
+  }
 }
 
 void Sema::popCodeSynthesisContext() {
@@ -380,6 +386,8 @@ void Sema::popCodeSynthesisContext() {
   if (!Active.isInstantiationRecord()) {
     assert(NonInstantiationEntries > 0);
     --NonInstantiationEntries;
+  } else if (ASTMemoryReport *Report = Context.getMemoryReport()) {
+    Report->popOrigin();
   }
 
   InNonInstantiationSFINAEContext = Active.SavedInNonInstantiationSFINAEContext;
@@ -7487,8 +7487,13 @@ TreeTransform<Derived>::TransformCXXConstantExpr(CXXConstantExpr *E) {
   ExprResult Result = getDerived().TransformExpr(E->getExpression());
   if (Result.isInvalid())
     return ExprError();
-  // Always rebuild. We need to re-evaluate the expression to get the value.
-  return getDerived().RebuildCXXConstantExpr(E);
+  // Rebuilding a call to the reflection library may already have folded it.
+  if (isa<CXXConstantExpr>(Result.get()) ||
+      Result.get()->isInstantiationDependent())
+    return Result;
+  // Otherwise, always rebuild. We need to re-evaluate the expression to get
+  // the value.
+  return getDerived().RebuildCXXConstantExpr(Result.get());
 }
 
 template<typename Derived>
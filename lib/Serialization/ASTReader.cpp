@@ -1109,7 +1109,8 @@ bool ASTReader::ReadVisibleDeclContextStorage(ModuleFile &M,
   StringRef Blob;
   unsigned Code = Cursor.ReadCode();
   unsigned RecCode = Cursor.readRecord(Code, Record, &Blob);
-  if (RecCode != DECL_CONTEXT_VISIBLE) {
+  if (RecCode != DECL_CONTEXT_VISIBLE &&
+      RecCode != DECL_CONTEXT_VISIBLE_COMPRESSED) {
     Error("Expected visible lookup table block");
     return true;
   }
@@ -1117,10 +1118,42 @@ bool ASTReader::ReadVisibleDeclContextStorage(ModuleFile &M,
   // We can't safely determine the primary context yet, so delay attaching the
   // lookup table until we're done with recursive deserialization.
   auto *Data = (const unsigned char*)Blob.data();
+  if (RecCode == DECL_CONTEXT_VISIBLE_COMPRESSED) {
+    Data = readCompressedTable(M, Blob, Record[0]);
+    if (!Data)
+      return true;
+  }
   PendingVisibleUpdates[ID].push_back(PendingVisibleUpdate{&M, Data});
   return false;
 }
 
+const unsigned char *ASTReader::readCompressedTable(ModuleFile &M,
+                                                    StringRef Blob,
+                                                    uint64_t Size) {
+  if (!llvm::zlib::isAvailable()) {
+    Error("zlib is not available");
+    return nullptr;
+  }
+
+  // The on-disk hash tables read 32-bit values in place, so keep the
+  // alignment the bitstream would have given the blob.
+  char *Data = static_cast<char *>(
+      M.DecompressedTables.Allocate(Size, alignof(uint32_t)));
+  size_t UncompressedSize = Size;
+  if (llvm::Error E = llvm::zlib::uncompress(Blob, Data, UncompressedSize)) {
+    Error("could not decompress table: " + llvm::toString(std::move(E)));
+    return nullptr;
+  }
+  if (UncompressedSize != Size) {
+    Error("compressed table has the wrong size");
+    return nullptr;
+  }
+
+  ++NumTablesDecompressed;
+  NumBytesDecompressed += Size;
+  return reinterpret_cast<const unsigned char *>(Data);
+}
+
 void ASTReader::Error(StringRef Msg) const {
   Error(diag::err_fe_pch_malformed, Msg);
   if (Context.getLangOpts().Modules && !Diags.isDiagnosticInFlight() &&
@@ -1784,6 +1817,7 @@ namespace {
 
   /// \brief Visitor class used to look up identifirs in an AST file.
   class IdentifierLookupVisitor {
+    ASTReader &Reader;
     StringRef Name;
     unsigned NameHash;
     unsigned PriorGeneration;
@@ -1792,10 +1826,11 @@ namespace {
     IdentifierInfo *Found;
 
   public:
-    IdentifierLookupVisitor(StringRef Name, unsigned PriorGeneration,
+    IdentifierLookupVisitor(ASTReader &Reader, StringRef Name,
+                            unsigned PriorGeneration,
                             unsigned &NumIdentifierLookups,
                             unsigned &NumIdentifierLookupHits)
-      : Name(Name), NameHash(ASTIdentifierLookupTrait::ComputeHash(Name)),
+      : Reader(Reader), Name(Name), NameHash(ASTIdentifierLookupTrait::ComputeHash(Name)),
         PriorGeneration(PriorGeneration),
         NumIdentifierLookups(NumIdentifierLookups),
         NumIdentifierLookupHits(NumIdentifierLookupHits),
@@ -1808,13 +1843,14 @@ namespace {
       if (M.Generation <= PriorGeneration)
         return true;
 
+      if (!Reader.loadIdentifierTable(M))
+        return false;
       ASTIdentifierLookupTable *IdTable
         = (ASTIdentifierLookupTable *)M.IdentifierLookupTable;
       if (!IdTable)
         return false;
 
-      ASTIdentifierLookupTrait Trait(IdTable->getInfoObj().getReader(), M,
-                                     Found);
+      ASTIdentifierLookupTrait Trait(Reader, M, Found);
       ++NumIdentifierLookups;
       ASTIdentifierLookupTable::iterator Pos =
           IdTable->find_hashed(Name, NameHash, &Trait);
@@ -1854,7 +1890,7 @@ void ASTReader::updateOutOfDateIdentifier(IdentifierInfo &II) {
     }
   }
 
-  IdentifierLookupVisitor Visitor(II.getName(), PriorGeneration,
+  IdentifierLookupVisitor Visitor(*this, II.getName(), PriorGeneration,
                                   NumIdentifierLookups,
                                   NumIdentifierLookupHits);
   ModuleMgr.visit(Visitor, HitsPtr);
@@ -2776,6 +2812,15 @@ ASTReader::ReadASTBlock(ModuleFile &F, unsigned ClientLoadCapabilities) {
       }
       break;
 
+    case IDENTIFIER_TABLE_COMPRESSED:
+      // Decompressed by loadIdentifierTable when first used.
+      F.CompressedIdentifierTable = Blob;
+      F.IdentifierTableBucketOffset = Record[0];
+      F.IdentifierTableSize = Record[1];
+      if (Record[0])
+        PP.getIdentifierTable().setExternalIdentifierLookup(this);
+      break;
+
     case IDENTIFIER_OFFSET: {
       if (F.LocalNumIdentifiers != 0) {
         Error("duplicate IDENTIFIER_OFFSET record in AST file");
@@ -2808,6 +2853,10 @@ ASTReader::ReadASTBlock(ModuleFile &F, unsigned ClientLoadCapabilities) {
       F.PreloadIdentifierOffsets.assign(Record.begin(), Record.end());
       break;
 
+    case INTERESTING_IDENTIFIER_NAMES:
+      F.PreloadIdentifierNames = Blob;
+      break;
+
     case EAGERLY_DESERIALIZED_DECLS:
       // FIXME: Skip reading this record if our ASTConsumer doesn't care
       // about "interesting" decls (for instance, if we're building a module).
@@ -3777,14 +3826,8 @@ ASTReader::ASTReadResult ASTReader::ReadAST(StringRef FileName,
 
     // Preload all the pending interesting identifiers by marking them out of
     // date.
-    for (auto Offset : F.PreloadIdentifierOffsets) {
-      const unsigned char *Data = reinterpret_cast<const unsigned char *>(
-          F.IdentifierTableData + Offset);
-
-      ASTIdentifierLookupTrait Trait(*this, F);
-      auto KeyDataLen = Trait.ReadKeyDataLength(Data);
-      auto Key = Trait.ReadKey(Data, KeyDataLen.first);
-      auto &II = PP.getIdentifierTable().getOwn(Key);
+    auto PreloadIdentifier = [&](StringRef Name, IdentID ID) {
+      auto &II = PP.getIdentifierTable().getOwn(Name);
       II.setOutOfDate(true);
 
       // Mark this identifier as being from an AST file so that we can track
@@ -3792,8 +3835,29 @@ ASTReader::ASTReadResult ASTReader::ReadAST(StringRef FileName,
       markIdentifierFromAST(*this, II);
 
       // Associate the ID with the identifier so that the writer can reuse it.
-      auto ID = Trait.ReadIdentifierID(Data + KeyDataLen.first);
       SetIdentifierInfo(ID, &II);
+    };
+    for (auto Offset : F.PreloadIdentifierOffsets) {
+      const unsigned char *Data = reinterpret_cast<const unsigned char *>(
+          F.IdentifierTableData + Offset);
+
+      ASTIdentifierLookupTrait Trait(*this, F);
+      auto KeyDataLen = Trait.ReadKeyDataLength(Data);
+      auto Key = Trait.ReadKey(Data, KeyDataLen.first);
+      PreloadIdentifier(Key,
+                        Trait.ReadIdentifierID(Data + KeyDataLen.first));
+    }
+
+    // A compressed identifier table keeps the names to preload outside the
+    // table, so that it is only decompressed by the first real lookup.
+    for (StringRef Names = F.PreloadIdentifierNames; !Names.empty();) {
+      using namespace llvm::support;
+      auto *Data = reinterpret_cast<const unsigned char *>(Names.data());
+      unsigned LocalID = endian::readNext<uint32_t, little, unaligned>(Data);
+      unsigned Length = endian::readNext<uint16_t, little, unaligned>(Data);
+      PreloadIdentifier(Names.substr(6, Length),
+                        getGlobalIdentifierID(F, LocalID));
+      Names = Names.drop_front(6 + Length);
     }
   }
 
@@ -7375,6 +7439,10 @@ void ASTReader::PrintStats() {
                  (double)NumIdentifierLookupHits*100.0/NumIdentifierLookups);
   }
 
+  std::fprintf(stderr, "  %u compressed tables decompressed (%llu bytes)\n",
+               NumTablesDecompressed,
+               (unsigned long long)NumBytesDecompressed);
+
   if (GlobalIndex) {
     std::fprintf(stderr, "\n");
     GlobalIndex->printStats();
@@ -7524,11 +7592,28 @@ void ASTReader::UpdateSema() {
   }
 }
 
+bool ASTReader::loadIdentifierTable(ModuleFile &M) {
+  if (M.CompressedIdentifierTable.empty())
+    return true;
+
+  const unsigned char *Data = readCompressedTable(
+      M, M.CompressedIdentifierTable, M.IdentifierTableSize);
+  if (!Data)
+    return false;
+  M.CompressedIdentifierTable = StringRef();
+  M.IdentifierTableData = reinterpret_cast<const char *>(Data);
+  if (M.IdentifierTableBucketOffset)
+    M.IdentifierLookupTable = ASTIdentifierLookupTable::Create(
+        Data + M.IdentifierTableBucketOffset, Data + sizeof(uint32_t), Data,
+        ASTIdentifierLookupTrait(*this, M));
+  return true;
+}
+
 IdentifierInfo *ASTReader::get(StringRef Name) {
   // Note that we are loading an identifier.
   Deserializing AnIdentifier(this);
 
-  IdentifierLookupVisitor Visitor(Name, /*PriorGeneration=*/0,
+  IdentifierLookupVisitor Visitor(*this, Name, /*PriorGeneration=*/0,
                                   NumIdentifierLookups,
                                   NumIdentifierLookupHits);
 
@@ -7607,6 +7692,8 @@ StringRef ASTIdentifierIterator::Next() {
     if (SkipModules && F.isModule())
       continue;
 
+    if (!const_cast<ASTReader &>(Reader).loadIdentifierTable(F))
+      continue;
     ASTIdentifierLookupTable *IdTable =
         (ASTIdentifierLookupTable *)F.IdentifierLookupTable;
     Current = IdTable->key_begin();
@@ -8041,6 +8128,8 @@ IdentifierInfo *ASTReader::DecodeIdentifierInfo(IdentifierID ID) {
     assert(I != GlobalIdentifierMap.end() && "Corrupted global identifier map");
     ModuleFile *M = I->second;
     unsigned Index = ID - M->BaseIdentifierID;
+    if (!loadIdentifierTable(*M))
+      return nullptr;
     const char *Str = M->IdentifierTableData + M->IdentifierOffsets[Index];
 
     // All of the strings in the AST file are preceded by a 16-bit length.
@@ -1798,6 +1798,7 @@ ASTDeclReader::VisitCXXRecordDeclImpl(CXXRecordDecl *D) {
   }
 
   D->Generator = Record.readExpr();
+  D->Discarded = Record.readInt();
 
   bool WasDefinition = Record.readInt();
   if (WasDefinition)
@@ -3374,6 +3375,7 @@ Decl *ASTReader::ReadDeclRecord(DeclID ID) {
   SavedStreamPosition SavedPosition(DeclsCursor);
 
   ReadingKindTracker ReadingKind(Read_Decl, *this);
+  ASTNodeOriginRAII Origin(Context, ASTNodeOrigin::Deserialized);
 
   // Note that we are loading a declaration record.
   Deserializing ADecl(this);
@@ -3387,6 +3389,7 @@ Decl *ASTReader::ReadDeclRecord(DeclID ID) {
   switch ((DeclCode)Record.readRecord(DeclsCursor, Code)) {
   case DECL_CONTEXT_LEXICAL:
   case DECL_CONTEXT_VISIBLE:
+  case DECL_CONTEXT_VISIBLE_COMPRESSED:
     llvm_unreachable("Record cannot be de-serialized with ReadDeclRecord");
   case DECL_TYPEDEF:
     D = TypedefDecl::CreateDeserialized(Context, ID);
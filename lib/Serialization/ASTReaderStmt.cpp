@@ -2972,6 +2972,7 @@ Expr *ASTReader::ReadSubExpr() {
 Stmt *ASTReader::ReadStmtFromStream(ModuleFile &F) {
 
   ReadingKindTracker ReadingKind(Read_Stmt, *this);
+  ASTNodeOriginRAII Origin(Context, ASTNodeOrigin::Deserialized);
   llvm::BitstreamCursor &Cursor = F.DeclsCursor;
 
   // Map of offset to previously deserialized stmt. The offset points
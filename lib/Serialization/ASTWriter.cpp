@@ -1065,6 +1065,7 @@ void ASTWriter::WriteBlockInfoBlock() {
   RECORD(DECL_OFFSET);
   RECORD(IDENTIFIER_OFFSET);
   RECORD(IDENTIFIER_TABLE);
+  RECORD(IDENTIFIER_TABLE_COMPRESSED);
   RECORD(EAGERLY_DESERIALIZED_DECLS);
   RECORD(MODULAR_CODEGEN_DECLS);
   RECORD(SPECIAL_TYPES);
@@ -1103,6 +1104,7 @@ void ASTWriter::WriteBlockInfoBlock() {
   RECORD(OBJC_CATEGORIES);
   RECORD(MACRO_OFFSET);
   RECORD(INTERESTING_IDENTIFIERS);
+  RECORD(INTERESTING_IDENTIFIER_NAMES);
   RECORD(UNDEFINED_BUT_USED);
   RECORD(LATE_PARSED_TEMPLATE);
   RECORD(OPTIMIZE_PRAGMA_OPTIONS);
@@ -1223,6 +1225,7 @@ void ASTWriter::WriteBlockInfoBlock() {
   RECORD(DECL_BLOCK);
   RECORD(DECL_CONTEXT_LEXICAL);
   RECORD(DECL_CONTEXT_VISIBLE);
+  RECORD(DECL_CONTEXT_VISIBLE_COMPRESSED);
   RECORD(DECL_NAMESPACE);
   RECORD(DECL_NAMESPACE_ALIAS);
   RECORD(DECL_USING);
@@ -2082,6 +2085,22 @@ static void emitBlob(llvm::BitstreamWriter &Stream, StringRef Blob,
   Stream.EmitRecordWithBlob(SLocBufferBlobAbbrv, Record, Blob);
 }
 
+/// \brief Compress one of the lazily-loaded hash tables of the AST file.
+///
+/// \returns true if \p Compressed holds a compressed form of \p Table that is
+/// worth the cost of decompressing it when the table is first used.
+static bool compressTable(StringRef Table, SmallVectorImpl<char> &Compressed) {
+  // Small tables are read in a handful of pages anyway.
+  if (Table.size() < 4096 || !llvm::zlib::isAvailable())
+    return false;
+
+  if (llvm::Error E = llvm::zlib::compress(Table, Compressed)) {
+    llvm::consumeError(std::move(E));
+    return false;
+  }
+  return Compressed.size() < Table.size() - Table.size() / 8;
+}
+
 /// \brief Writes the block containing the serialized form of the
 /// source manager.
 ///
@@ -3366,6 +3385,7 @@ class ASTIdentifierTableTrait {
   bool IsModule;
   bool NeedDecls;
   ASTWriter::RecordData *InterestingIdentifierOffsets;
+  SmallVectorImpl<const IdentifierInfo *> *InterestingIdentifiers;
   
   /// \brief Determines whether this is an "interesting" identifier that needs a
   /// full IdentifierInfo structure written into the hash table. Notably, this
@@ -3394,10 +3414,13 @@ public:
 
   ASTIdentifierTableTrait(ASTWriter &Writer, Preprocessor &PP,
                           IdentifierResolver &IdResolver, bool IsModule,
-                          ASTWriter::RecordData *InterestingIdentifierOffsets)
+                          ASTWriter::RecordData *InterestingIdentifierOffsets,
+                          SmallVectorImpl<const IdentifierInfo *>
+                              *InterestingIdentifiers)
       : Writer(Writer), PP(PP), IdResolver(IdResolver), IsModule(IsModule),
         NeedDecls(!IsModule || !Writer.getLangOpts().CPlusPlus),
-        InterestingIdentifierOffsets(InterestingIdentifierOffsets) {}
+        InterestingIdentifierOffsets(InterestingIdentifierOffsets),
+        InterestingIdentifiers(InterestingIdentifiers) {}
 
   bool needDecls() const { return NeedDecls; }
 
@@ -3452,8 +3475,10 @@ public:
 
     // Emit the offset of the key/data length information to the interesting
     // identifiers table if necessary.
-    if (InterestingIdentifierOffsets && isInterestingIdentifier(II))
+    if (InterestingIdentifierOffsets && isInterestingIdentifier(II)) {
       InterestingIdentifierOffsets->push_back(Out.tell() - 4);
+      InterestingIdentifiers->push_back(II);
+    }
 
     Out.write(II->getNameStart(), KeyLen);
   }
@@ -3517,6 +3542,8 @@ void ASTWriter::WriteIdentifierTable(Preprocessor &PP,
   using namespace llvm;
 
   RecordData InterestingIdents;
+  SmallVector<const IdentifierInfo *, 16> InterestingIdentInfos;
+  bool CompressedIdentifierTable = false;
 
   // Create and write out the blob that contains the identifier
   // strings.
@@ -3524,7 +3551,8 @@ void ASTWriter::WriteIdentifierTable(Preprocessor &PP,
     llvm::OnDiskChainedHashTableGenerator<ASTIdentifierTableTrait> Generator;
     ASTIdentifierTableTrait Trait(
         *this, PP, IdResolver, IsModule,
-        (getLangOpts().CPlusPlus && IsModule) ? &InterestingIdents : nullptr);
+        (getLangOpts().CPlusPlus && IsModule) ? &InterestingIdents : nullptr,
+        &InterestingIdentInfos);
 
     // Look for any identifiers that were named while processing the
     // headers, but are otherwise not needed. We add these to the hash
@@ -3568,16 +3596,33 @@ void ASTWriter::WriteIdentifierTable(Preprocessor &PP,
       BucketOffset = Generator.Emit(Out, Trait);
     }
 
-    // Create a blob abbreviation
-    auto Abbrev = std::make_shared<BitCodeAbbrev>();
-    Abbrev->Add(BitCodeAbbrevOp(IDENTIFIER_TABLE));
-    Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Fixed, 32));
-    Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Blob));
-    unsigned IDTableAbbrev = Stream.EmitAbbrev(std::move(Abbrev));
-
-    // Write the identifier table
-    RecordData::value_type Record[] = {IDENTIFIER_TABLE, BucketOffset};
-    Stream.EmitRecordWithBlob(IDTableAbbrev, Record, IdentifierTable);
+    // The identifier offsets below still refer to the uncompressed table,
+    // so only the reader's first lookup has to pay for decompressing it.
+    SmallString<0> CompressedTable;
+    if (CompressTables && compressTable(IdentifierTable, CompressedTable)) {
+      auto Abbrev = std::make_shared<BitCodeAbbrev>();
+      Abbrev->Add(BitCodeAbbrevOp(IDENTIFIER_TABLE_COMPRESSED));
+      Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Fixed, 32));
+      Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 32));
+      Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Blob));
+      unsigned IDTableAbbrev = Stream.EmitAbbrev(std::move(Abbrev));
+
+      RecordData::value_type Record[] = {IDENTIFIER_TABLE_COMPRESSED,
+                                         BucketOffset, IdentifierTable.size()};
+      Stream.EmitRecordWithBlob(IDTableAbbrev, Record, CompressedTable);
+      CompressedIdentifierTable = true;
+    } else {
+      // Create a blob abbreviation
+      auto Abbrev = std::make_shared<BitCodeAbbrev>();
+      Abbrev->Add(BitCodeAbbrevOp(IDENTIFIER_TABLE));
+      Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Fixed, 32));
+      Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Blob));
+      unsigned IDTableAbbrev = Stream.EmitAbbrev(std::move(Abbrev));
+
+      // Write the identifier table
+      RecordData::value_type Record[] = {IDENTIFIER_TABLE, BucketOffset};
+      Stream.EmitRecordWithBlob(IDTableAbbrev, Record, IdentifierTable);
+    }
   }
 
   // Write the offsets table for identifier IDs.
@@ -3599,10 +3644,40 @@ void ASTWriter::WriteIdentifierTable(Preprocessor &PP,
   Stream.EmitRecordWithBlob(IdentifierOffsetAbbrev, Record,
                             bytes(IdentifierOffsets));
 
+  if (InterestingIdents.empty())
+    return;
+
   // In C++, write the list of interesting identifiers (those that are
   // defined as macros, poisoned, or similar unusual things).
-  if (!InterestingIdents.empty())
+  if (!CompressedIdentifierTable) {
     Stream.EmitRecord(INTERESTING_IDENTIFIERS, InterestingIdents);
+    return;
+  }
+
+  // The offsets above point into the compressed table, so write each
+  // identifier's ID and name out again where the reader can preload them
+  // without decompressing the table.
+  SmallString<256> Names;
+  {
+    using namespace llvm::support;
+    llvm::raw_svector_ostream Out(Names);
+    endian::Writer<little> LE(Out);
+    for (const IdentifierInfo *II : InterestingIdentInfos) {
+      LE.write<uint32_t>(getIdentifierRef(II));
+      LE.write<uint16_t>(II->getLength());
+      Out << II->getName();
+    }
+  }
+
+  auto NamesAbbrev = std::make_shared<BitCodeAbbrev>();
+  NamesAbbrev->Add(BitCodeAbbrevOp(INTERESTING_IDENTIFIER_NAMES));
+  NamesAbbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 32)); // # of names
+  NamesAbbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Blob));
+  unsigned NamesAbbrevID = Stream.EmitAbbrev(std::move(NamesAbbrev));
+
+  RecordData::value_type NamesRecord[] = {INTERESTING_IDENTIFIER_NAMES,
+                                          InterestingIdentInfos.size()};
+  Stream.EmitRecordWithBlob(NamesAbbrevID, NamesRecord, Names);
 }
 
 //===----------------------------------------------------------------------===//
@@ -4015,9 +4090,17 @@ uint64_t ASTWriter::WriteDeclContextVisibleBlock(ASTContext &Context,
   GenerateNameLookupTable(DC, LookupTable);
 
   // Write the lookup table
-  RecordData::value_type Record[] = {DECL_CONTEXT_VISIBLE};
-  Stream.EmitRecordWithBlob(DeclContextVisibleLookupAbbrev, Record,
-                            LookupTable);
+  SmallString<0> CompressedTable;
+  if (CompressTables && compressTable(LookupTable, CompressedTable)) {
+    RecordData::value_type Record[] = {DECL_CONTEXT_VISIBLE_COMPRESSED,
+                                       LookupTable.size()};
+    Stream.EmitRecordWithBlob(DeclContextVisibleLookupCompressedAbbrev, Record,
+                              CompressedTable);
+  } else {
+    RecordData::value_type Record[] = {DECL_CONTEXT_VISIBLE};
+    Stream.EmitRecordWithBlob(DeclContextVisibleLookupAbbrev, Record,
+                              LookupTable);
+  }
   ++NumVisibleDeclContexts;
   return Offset;
 }
@@ -4362,9 +4445,9 @@ void ASTWriter::SetSelectorOffset(Selector Sel, uint32_t Offset) {
 ASTWriter::ASTWriter(llvm::BitstreamWriter &Stream,
                      SmallVectorImpl<char> &Buffer, MemoryBufferCache &PCMCache,
                      ArrayRef<std::shared_ptr<ModuleFileExtension>> Extensions,
-                     bool IncludeTimestamps)
+                     bool IncludeTimestamps, bool CompressTables)
     : Stream(Stream), Buffer(Buffer), PCMCache(PCMCache),
-      IncludeTimestamps(IncludeTimestamps) {
+      IncludeTimestamps(IncludeTimestamps), CompressTables(CompressTables) {
   for (const auto &Ext : Extensions) {
     if (auto Writer = Ext->createExtensionWriter(*this))
       ModuleFileExtensionWriters.push_back(std::move(Writer));
@@ -5824,7 +5907,9 @@ void ASTRecordWriter::AddCXXDefinitionData(const CXXRecordDecl *D) {
   // getODRHash will compute the ODRHash if it has not been previously computed.
   Record->push_back(D->getODRHash());
   bool ModulesDebugInfo = Writer->Context->getLangOpts().ModulesDebugInfo &&
-                          Writer->WritingModule && !D->isDependentType();
+                          (Writer->WritingModule ||
+                           Writer->Context->getLangOpts().CompilingPCH) &&
+                          !D->isDependentType();
   Record->push_back(ModulesDebugInfo);
   if (ModulesDebugInfo)
     Writer->ModularCodegenDecls.push_back(Writer->GetDeclRef(D));
@@ -1259,6 +1259,7 @@ void ASTDeclWriter::VisitCXXRecordDecl(CXXRecordDecl *D) {
   }
 
   Record.AddStmt(D->getGenerator());
+  Record.push_back(D->isDiscarded());
 
   Record.push_back(D->isThisDeclarationADefinition());
   if (D->isThisDeclarationADefinition())
@@ -1633,6 +1634,16 @@ void ASTDeclWriter::VisitStaticAssertDecl(StaticAssertDecl *D) {
 
 /// \brief Emit the DeclContext part of a declaration context decl.
 void ASTDeclWriter::VisitDeclContext(DeclContext *DC) {
+  // Don't write the members of a discarded metaclass prototype. Anything
+  // still needed was adopted or copied into the generated class.
+  if (CXXRecordDecl *RD = dyn_cast<CXXRecordDecl>(DC)) {
+    if (RD->isDiscarded()) {
+      Record.AddOffset(0);
+      Record.AddOffset(0);
+      return;
+    }
+  }
+
   Record.AddOffset(Writer.WriteDeclContextLexicalBlock(Context, DC));
   Record.AddOffset(Writer.WriteDeclContextVisibleBlock(Context, DC));
 }
@@ -2177,6 +2188,12 @@ void ASTWriter::WriteDeclAbbrevs() {
   Abv->Add(BitCodeAbbrevOp(serialization::DECL_CONTEXT_VISIBLE));
   Abv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Blob));
   DeclContextVisibleLookupAbbrev = Stream.EmitAbbrev(std::move(Abv));
+
+  Abv = std::make_shared<BitCodeAbbrev>();
+  Abv->Add(BitCodeAbbrevOp(serialization::DECL_CONTEXT_VISIBLE_COMPRESSED));
+  Abv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 32));
+  Abv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Blob));
+  DeclContextVisibleLookupCompressedAbbrev = Stream.EmitAbbrev(std::move(Abv));
 }
 
 /// isRequiredDecl - Check if this is a "required" Decl, which must be seen by
@@ -2261,8 +2278,16 @@ void ASTRecordWriter::AddFunctionDefinition(const FunctionDecl *FD) {
   Writer->ClearSwitchCaseIDs();
 
   assert(FD->doesThisDeclarationHaveABody());
-  bool ModulesCodegen = Writer->Context->getLangOpts().ModulesCodegen &&
-                        Writer->WritingModule && !FD->isDependentContext();
+  const LangOptions &LangOpts = Writer->Context->getLangOpts();
+  bool ModulesCodegen = LangOpts.ModulesCodegen && !FD->isDependentContext();
+  if (ModulesCodegen && !Writer->WritingModule) {
+    // A PCH built with an object file only owns the definitions that would
+    // otherwise be emitted by every TU that includes it; functions with
+    // internal linkage stay local to their users.
+    GVALinkage Linkage = Writer->Context->GetGVALinkageForFunction(FD);
+    ModulesCodegen = LangOpts.CompilingPCH && Linkage != GVA_Internal &&
+                     Linkage != GVA_AvailableExternally;
+  }
   Record->push_back(ModulesCodegen);
   if (ModulesCodegen)
     Writer->ModularCodegenDecls.push_back(Writer->GetDeclRef(FD));
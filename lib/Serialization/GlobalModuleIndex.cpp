@@ -24,6 +24,7 @@
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Bitcode/BitstreamReader.h"
 #include "llvm/Bitcode/BitstreamWriter.h"
+#include "llvm/Support/Compression.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/LockFileManager.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -648,6 +649,19 @@ bool GlobalModuleIndexBuilder::loadModuleFile(const FileEntry *File) {
     }
 
     // Handle the identifier table
+    SmallString<0> Uncompressed;
+    if (State == ASTBlock && Code == IDENTIFIER_TABLE_COMPRESSED &&
+        Record[0] > 0) {
+      if (!llvm::zlib::isAvailable())
+        return true;
+      if (llvm::Error E =
+              llvm::zlib::uncompress(Blob, Uncompressed, Record[1])) {
+        llvm::consumeError(std::move(E));
+        return true;
+      }
+      Blob = Uncompressed;
+      Code = IDENTIFIER_TABLE;
+    }
     if (State == ASTBlock && Code == IDENTIFIER_TABLE && Record[0] > 0) {
       typedef llvm::OnDiskIterableChainedHashTable<
           InterestingASTIdentifierLookupTrait> InterestingIdentifierTable;
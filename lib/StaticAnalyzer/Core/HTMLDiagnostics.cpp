@@ -23,10 +23,12 @@
 #include "clang/StaticAnalyzer/Core/CheckerManager.h"
 #include "clang/StaticAnalyzer/Core/IssueHash.h"
 #include "clang/StaticAnalyzer/Core/PathDiagnosticConsumers.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/raw_ostream.h"
 #include <sstream>
 
@@ -39,11 +41,40 @@ using namespace ento;
 
 namespace {
 
+/// An annotated report whose HTML is ready to be written to its file.
+struct HTMLReport {
+  Rewriter R;
+  FileID FID;
+  int FD;
+
+  HTMLReport(Rewriter R, FileID FID, int FD)
+    : R(std::move(R)), FID(FID), FD(FD) {}
+
+  void write() const {
+    llvm::raw_fd_ostream os(FD, true);
+    R.getRewriteBufferFor(FID)->write(os);
+  }
+};
+
 class HTMLDiagnostics : public PathDiagnosticConsumer {
   std::string Directory;
   bool createdDir, noDir;
   const Preprocessor &PP;
   AnalyzerOptions &AnalyzerOpts;
+
+  /// The syntax and macro highlighting of each file with reports in the
+  /// current flush.  Relexing a file for macros re-preprocesses it, so each
+  /// report replays these after adding its path.
+  llvm::DenseMap<FileID, std::vector<html::HighlightedRange>> FileHighlights;
+
+  /// The threads writing the reports to disk, created on the first flush.
+  std::unique_ptr<llvm::ThreadPool> WritePool;
+
+  /// The most reports held in memory waiting to be written.
+  static const unsigned MaxPendingReports = 64;
+
+  ArrayRef<html::HighlightedRange> getFileHighlights(FileID FID);
+
 public:
   HTMLDiagnostics(AnalyzerOptions &AnalyzerOpts, const std::string& prefix, const Preprocessor &pp);
 
@@ -67,8 +98,8 @@ public:
                       const char *HighlightStart = "<span class=\"mrange\">",
                       const char *HighlightEnd = "</span>");
 
-  void ReportDiag(const PathDiagnostic& D,
-                  FilesMade *filesMade);
+  std::unique_ptr<HTMLReport> ReportDiag(const PathDiagnostic& D,
+                                         FilesMade *filesMade);
 };
 
 } // end anonymous namespace
@@ -93,14 +124,46 @@ void ento::createHTMLDiagnosticConsumer(AnalyzerOptions &AnalyzerOpts,
 void HTMLDiagnostics::FlushDiagnosticsImpl(
   std::vector<const PathDiagnostic *> &Diags,
   FilesMade *filesMade) {
+  // Reports are annotated one at a time, since they share the highlighted
+  // files and the SourceManager is not thread safe, but written in parallel.
+  if (!WritePool && !Diags.empty())
+    WritePool = llvm::make_unique<llvm::ThreadPool>();
+  std::vector<std::unique_ptr<HTMLReport>> Reports;
   for (std::vector<const PathDiagnostic *>::iterator it = Diags.begin(),
        et = Diags.end(); it != et; ++it) {
-    ReportDiag(**it, filesMade);
+    if (std::unique_ptr<HTMLReport> Report = ReportDiag(**it, filesMade))
+      Reports.push_back(std::move(Report));
+
+    if (Reports.size() == MaxPendingReports || std::next(it) == et) {
+      for (const std::unique_ptr<HTMLReport> &Report : Reports) {
+        const HTMLReport *R = Report.get();
+        WritePool->async([R] { R->write(); });
+      }
+      WritePool->wait();
+      Reports.clear();
+    }
   }
+
+  FileHighlights.clear();
+}
+
+ArrayRef<html::HighlightedRange>
+HTMLDiagnostics::getFileHighlights(FileID FID) {
+  auto Known = FileHighlights.find(FID);
+  if (Known != FileHighlights.end())
+    return Known->second;
+
+  // If we have a preprocessor, relex the file and syntax highlight.
+  // We might not have a preprocessor if we come from a deserialized AST file,
+  // for example.
+  std::vector<html::HighlightedRange> &Ranges = FileHighlights[FID];
+  html::SyntaxHighlight(Ranges, FID, PP);
+  html::HighlightMacros(Ranges, FID, PP);
+  return Ranges;
 }
 
-void HTMLDiagnostics::ReportDiag(const PathDiagnostic& D,
-                                 FilesMade *filesMade) {
+std::unique_ptr<HTMLReport>
+HTMLDiagnostics::ReportDiag(const PathDiagnostic& D, FilesMade *filesMade) {
 
   // Create the HTML directory if it is missing.
   if (!createdDir) {
@@ -111,12 +174,12 @@ void HTMLDiagnostics::ReportDiag(const PathDiagnostic& D,
 
       noDir = true;
 
-      return;
+      return nullptr;
     }
   }
 
   if (noDir)
-    return;
+    return nullptr;
 
   // First flatten out the entire path to make it easier to use.
   PathPieces path = D.path.flatten(/*ShouldFlattenMacros=*/false);
@@ -183,12 +246,9 @@ void HTMLDiagnostics::ReportDiag(const PathDiagnostic& D,
   html::EscapeText(R, FID);
   html::AddLineNumbers(R, FID);
 
-  // If we have a preprocessor, relex the file and syntax highlight.
-  // We might not have a preprocessor if we come from a deserialized AST file,
-  // for example.
-
-  html::SyntaxHighlight(R, FID, PP);
-  html::HighlightMacros(R, FID, PP);
+  // The highlighting goes over the path, as it did when each report relexed
+  // the file.
+  html::ApplyHighlights(R, FID, getFileHighlights(FID));
 
   // Get the full directory name of the analyzed file.
 
@@ -315,7 +375,7 @@ void HTMLDiagnostics::ReportDiag(const PathDiagnostic& D,
 
   if (!Buf) {
     llvm::errs() << "warning: no diagnostics generated for main file.\n";
-    return;
+    return nullptr;
   }
 
   // Create a path for the target HTML file.
@@ -328,13 +388,13 @@ void HTMLDiagnostics::ReportDiag(const PathDiagnostic& D,
           llvm::sys::fs::make_absolute(Model)) {
           llvm::errs() << "warning: could not make '" << Model
                        << "' absolute: " << EC.message() << '\n';
-        return;
+        return nullptr;
       }
       if (std::error_code EC =
           llvm::sys::fs::createUniqueFile(Model, FD, ResultPath)) {
           llvm::errs() << "warning: could not create file in '" << Directory
                        << "': " << EC.message() << '\n';
-          return;
+          return nullptr;
       }
 
   } else {
@@ -358,21 +418,18 @@ void HTMLDiagnostics::ReportDiag(const PathDiagnostic& D,
           if (EC && EC != llvm::errc::file_exists) {
               llvm::errs() << "warning: could not create file '" << Model
                            << "': " << EC.message() << '\n';
-              return;
+              return nullptr;
           }
           i++;
       } while (EC);
   }
 
-  llvm::raw_fd_ostream os(FD, true);
-
   if (filesMade)
     filesMade->addDiagnostic(D, getName(),
                              llvm::sys::path::filename(ResultPath));
 
-  // Emit the HTML to disk.
-  for (RewriteBuffer::iterator I = Buf->begin(), E = Buf->end(); I!=E; ++I)
-      os << *I;
+  // The HTML is emitted to disk by the caller.
+  return llvm::make_unique<HTMLReport>(std::move(R), FID, FD);
 }
 
 void HTMLDiagnostics::HandlePiece(Rewriter& R, FileID BugFileID,
@@ -23,7 +23,10 @@
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/raw_os_ostream.h"
+#include <algorithm>
+#include <thread>
 
 namespace clang {
 namespace tooling {
@@ -581,6 +584,124 @@ llvm::Expected<std::string> applyAllReplacements(StringRef Code,
   return Result;
 }
 
+llvm::Expected<std::string>
+applySortedReplacements(StringRef Code, ArrayRef<Replacement> Replaces) {
+  assert(std::is_sorted(Replaces.begin(), Replaces.end()) &&
+         "Replacements must be sorted");
+  std::string Result;
+  Result.reserve(Code.size());
+
+  // The end of the text copied from Code so far, and the most recent
+  // replacement, which is only written out once we know that the next one
+  // does not have to be merged into it.
+  unsigned Copied = 0;
+  llvm::Optional<Replacement> Pending;
+  auto Flush = [&] {
+    Result.append(Code.data() + Copied, Pending->getOffset() - Copied);
+    Result += Pending->getReplacementText();
+    Copied = Pending->getOffset() + Pending->getLength();
+  };
+
+  for (const Replacement &R : Replaces) {
+    if (R.getOffset() > Code.size() ||
+        R.getLength() > Code.size() - R.getOffset())
+      return llvm::make_error<ReplacementError>(
+          replacement_error::fail_to_apply, R);
+    if (!Pending) {
+      Pending = R;
+      continue;
+    }
+
+    const Replacement &Prev = *Pending;
+    unsigned PrevEnd = Prev.getOffset() + Prev.getLength();
+    if (R.getOffset() == Prev.getOffset() && R.getLength() == 0 &&
+        Prev.getLength() == 0) {
+      // Two insertions at the same offset; like Replacements::add, accept
+      // them if inserting them in either order gives the same text, and
+      // insert both.
+      std::string Merged =
+          (R.getReplacementText() + Prev.getReplacementText()).str();
+      if (Merged != (Prev.getReplacementText() + R.getReplacementText()).str())
+        return llvm::make_error<ReplacementError>(
+            replacement_error::insert_conflict, R, Prev);
+      Pending = Replacement(Prev.getFilePath(), Prev.getOffset(), 0, Merged);
+      continue;
+    }
+    if (R.getOffset() < PrevEnd) {
+      if (R == Prev)
+        continue;
+      if (!R.getReplacementText().empty() ||
+          !Prev.getReplacementText().empty())
+        return llvm::make_error<ReplacementError>(
+            replacement_error::overlap_conflict, R, Prev);
+      // Overlapping deletions delete their union.
+      unsigned End = std::max(PrevEnd, R.getOffset() + R.getLength());
+      Pending = Replacement(Prev.getFilePath(), Prev.getOffset(),
+                            End - Prev.getOffset(), "");
+      continue;
+    }
+    Flush();
+    Pending = R;
+  }
+
+  if (Pending)
+    Flush();
+  Result.append(Code.data() + Copied, Code.size() - Copied);
+  return Result;
+}
+
+llvm::Expected<std::map<std::string, std::string>> applyAllReplacementsInBulk(
+    const std::map<std::string, std::vector<Replacement>> &FileToReplaces,
+    vfs::FileSystem &FS, unsigned ThreadCount) {
+  // Every file is handled by one task, which only touches its own slot.
+  std::vector<std::pair<const std::string *, const std::vector<Replacement> *>>
+      Files;
+  for (const auto &Entry : FileToReplaces)
+    Files.emplace_back(&Entry.first, &Entry.second);
+  std::vector<llvm::Optional<llvm::Expected<std::string>>> Results(
+      Files.size());
+
+  {
+    llvm::ThreadPool Pool(
+        ThreadCount ? ThreadCount
+                    : std::max(1u, std::thread::hardware_concurrency()));
+    for (size_t I = 0, E = Files.size(); I != E; ++I) {
+      Pool.async([&, I] {
+        const std::string &Path = *Files[I].first;
+        auto Buffer = FS.getBufferForFile(Path);
+        if (!Buffer) {
+          Results[I].emplace(llvm::make_error<llvm::StringError>(
+              "Could not read " + Path + ": " + Buffer.getError().message(),
+              Buffer.getError()));
+          return;
+        }
+        Results[I].emplace(
+            applySortedReplacements((*Buffer)->getBuffer(), *Files[I].second));
+      });
+    }
+    Pool.wait();
+  }
+
+  std::map<std::string, std::string> NewContents;
+  llvm::Error Err = llvm::Error::success();
+  for (size_t I = 0, E = Files.size(); I != E; ++I) {
+    llvm::Expected<std::string> &Result = *Results[I];
+    if (!Result) {
+      if (Err)
+        llvm::consumeError(Result.takeError());
+      else
+        Err = Result.takeError();
+      continue;
+    }
+    if (!Err)
+      NewContents.emplace_hint(NewContents.end(), *Files[I].first,
+                               std::move(*Result));
+  }
+  if (Err)
+    return std::move(Err);
+  return std::move(NewContents);
+}
+
 std::map<std::string, Replacements> groupReplacementsByFile(
     FileManager &FileMgr,
     const std::map<std::string, Replacements> &FileToReplaces) {
@@ -15,11 +15,17 @@
 #include "clang/Tooling/CompilationDatabase.h"
 #include "clang/Tooling/CompilationDatabasePluginRegistry.h"
 #include "clang/Tooling/Tooling.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/ConvertUTF.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/StringSaver.h"
+#include "llvm/Support/raw_ostream.h"
 #include <system_error>
 
 namespace clang {
@@ -141,6 +147,264 @@ std::vector<std::string> unescapeCommandLine(JSONCommandLineSyntax Syntax,
   return parser.parse();
 }
 
+/// \brief Scans the JSON text of a compilation database without building a
+/// tree of it.
+///
+/// A database is an array of objects whose values are strings or arrays of
+/// strings, so that is all the scanner understands. Strings are handed out
+/// with their escapes intact; unescapeJSONString() decodes the ones whose
+/// value is needed.
+class JSONScanner {
+public:
+  explicit JSONScanner(StringRef Input) : Input(Input), Position(0) {}
+
+  void skipWhitespace() {
+    while (Position != Input.size() &&
+           (Input[Position] == ' ' || Input[Position] == '\n' ||
+            Input[Position] == '\r' || Input[Position] == '\t'))
+      ++Position;
+  }
+
+  /// \brief Returns whether only whitespace is left.
+  bool atEnd() {
+    skipWhitespace();
+    return Position == Input.size();
+  }
+
+  /// \brief Consumes \p C if it is the next character after whitespace.
+  bool consume(char C) {
+    skipWhitespace();
+    if (Position == Input.size() || Input[Position] != C)
+      return false;
+    ++Position;
+    return true;
+  }
+
+  /// \brief Scans a string, setting \p Raw to what is between its quotes.
+  bool scanString(StringRef &Raw) {
+    if (!consume('"'))
+      return false;
+    size_t Begin = Position;
+    while (true) {
+      Position = Input.find_first_of("\"\\", Position);
+      if (Position == StringRef::npos) {
+        Position = Input.size();
+        return false;
+      }
+      if (Input[Position] == '"')
+        break;
+      // Skip the escaped character, which may be a quote.
+      if (Position + 1 == Input.size())
+        return false;
+      Position += 2;
+    }
+    Raw = Input.slice(Begin, Position++);
+    return true;
+  }
+
+  size_t getPosition() const { return Position; }
+
+private:
+  StringRef Input;
+  size_t Position;
+};
+
+/// \brief Returns the value of a JSON string whose contents are \p Raw,
+/// decoding it into \p Storage if it contains escapes.
+StringRef unescapeJSONString(StringRef Raw, SmallVectorImpl<char> &Storage) {
+  size_t Escape = Raw.find('\\');
+  if (Escape == StringRef::npos)
+    return Raw;
+  Storage.clear();
+  Storage.append(Raw.begin(), Raw.begin() + Escape);
+  for (size_t I = Escape, E = Raw.size(); I != E; ++I) {
+    if (Raw[I] != '\\') {
+      Storage.push_back(Raw[I]);
+      continue;
+    }
+    // The scanner never ends a string on a backslash.
+    char C = Raw[++I];
+    switch (C) {
+    case 'b': Storage.push_back('\b'); break;
+    case 'f': Storage.push_back('\f'); break;
+    case 'n': Storage.push_back('\n'); break;
+    case 'r': Storage.push_back('\r'); break;
+    case 't': Storage.push_back('\t'); break;
+    case 'u': {
+      unsigned CodePoint, Low;
+      if (I + 4 >= E || Raw.substr(I + 1, 4).getAsInteger(16, CodePoint)) {
+        Storage.push_back(C);
+        break;
+      }
+      I += 4;
+      if (CodePoint >= 0xD800 && CodePoint < 0xDC00 && I + 6 < E &&
+          Raw[I + 1] == '\\' && Raw[I + 2] == 'u' &&
+          !Raw.substr(I + 3, 4).getAsInteger(16, Low) && Low >= 0xDC00 &&
+          Low < 0xE000) {
+        CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+        I += 6;
+      }
+      char UTF8[UNI_MAX_UTF8_BYTES_PER_CODE_POINT];
+      char *End = UTF8;
+      if (llvm::ConvertCodePointToUTF8(CodePoint, End))
+        Storage.append(UTF8, End);
+      break;
+    }
+    default:
+      // '"', '\\' and '/' stand for themselves.
+      Storage.push_back(C);
+      break;
+    }
+  }
+  return StringRef(Storage.data(), Storage.size());
+}
+
+/// \brief The fields of one database entry, as the contents of their JSON
+/// strings.
+struct CommandEntry {
+  StringRef Directory;
+  StringRef File;
+  llvm::Optional<StringRef> Output;
+  // If the command line contains a single argument, it is a shell-escaped
+  // command line.
+  // Otherwise, each entry in the command line vector is a literal
+  // argument to the compiler.
+  SmallVector<StringRef, 32> CommandLine;
+  bool HasDirectory;
+  bool HasFile;
+  bool HasCommandLine;
+};
+
+/// \brief Scans the JSON object of one database entry into \p Entry.
+///
+/// Returns false and sets ErrorMessage if it is not a valid entry.
+bool scanEntry(JSONScanner &Scanner, CommandEntry &Entry,
+               std::string &ErrorMessage) {
+  Entry.Output.reset();
+  Entry.CommandLine.clear();
+  Entry.HasDirectory = Entry.HasFile = Entry.HasCommandLine = false;
+  if (!Scanner.consume('{')) {
+    ErrorMessage = "Expected object.";
+    return false;
+  }
+  if (!Scanner.consume('}')) {
+    do {
+      StringRef RawKey;
+      if (!Scanner.scanString(RawKey)) {
+        ErrorMessage = "Expected strings as key.";
+        return false;
+      }
+      if (!Scanner.consume(':')) {
+        ErrorMessage = "Expected value.";
+        return false;
+      }
+      SmallString<10> KeyStorage;
+      StringRef Key = unescapeJSONString(RawKey, KeyStorage);
+      if (Key == "arguments") {
+        if (!Scanner.consume('[')) {
+          ErrorMessage = "Expected sequence as value.";
+          return false;
+        }
+        Entry.CommandLine.clear();
+        Entry.HasCommandLine = true;
+        if (!Scanner.consume(']')) {
+          do {
+            StringRef Argument;
+            if (!Scanner.scanString(Argument)) {
+              ErrorMessage = "Only strings are allowed in 'arguments'.";
+              return false;
+            }
+            Entry.CommandLine.push_back(Argument);
+          } while (Scanner.consume(','));
+          if (!Scanner.consume(']')) {
+            ErrorMessage = "Error while parsing JSON.";
+            return false;
+          }
+        }
+        continue;
+      }
+      StringRef Value;
+      if (!Scanner.scanString(Value)) {
+        ErrorMessage = "Expected string as value.";
+        return false;
+      }
+      if (Key == "directory") {
+        Entry.Directory = Value;
+        Entry.HasDirectory = true;
+      } else if (Key == "command") {
+        if (!Entry.HasCommandLine) {
+          Entry.CommandLine.push_back(Value);
+          Entry.HasCommandLine = true;
+        }
+      } else if (Key == "file") {
+        Entry.File = Value;
+        Entry.HasFile = true;
+      } else if (Key == "output") {
+        Entry.Output = Value;
+      } else {
+        ErrorMessage = ("Unknown key: \"" + RawKey + "\"").str();
+        return false;
+      }
+    } while (Scanner.consume(','));
+    if (!Scanner.consume('}')) {
+      ErrorMessage = "Error while parsing JSON.";
+      return false;
+    }
+  }
+  if (!Entry.HasFile) {
+    ErrorMessage = "Missing key: \"file\".";
+    return false;
+  }
+  if (!Entry.HasCommandLine) {
+    ErrorMessage = "Missing key: \"command\" or \"arguments\".";
+    return false;
+  }
+  if (!Entry.HasDirectory) {
+    ErrorMessage = "Missing key: \"directory\".";
+    return false;
+  }
+  return true;
+}
+
+/// \brief Reads the little endian fields of an index file, failing instead
+/// of reading past its end.
+class IndexReader {
+public:
+  explicit IndexReader(StringRef Data) : Data(Data) {}
+
+  template <typename T> bool read(T &Value) {
+    if (Data.size() < sizeof(T))
+      return false;
+    Value = llvm::support::endian::read<T, llvm::support::little,
+                                        llvm::support::unaligned>(Data.data());
+    Data = Data.drop_front(sizeof(T));
+    return true;
+  }
+
+  bool read(size_t Length, StringRef &Bytes) {
+    if (Data.size() < Length)
+      return false;
+    Bytes = Data.take_front(Length);
+    Data = Data.drop_front(Length);
+    return true;
+  }
+
+  size_t remaining() const { return Data.size(); }
+
+private:
+  StringRef Data;
+};
+
+/// \brief Identifies index files, and their format version.
+const char IndexMagic[] = "CDBINDX1";
+
+/// \brief Each CompileCommandRef takes an 8 byte offset and a 4 byte length.
+const size_t IndexRefSize = 12;
+
+uint64_t getModificationTime(const llvm::sys::fs::file_status &Status) {
+  return Status.getLastModificationTime().time_since_epoch().count();
+}
+
 class JSONCompilationDatabasePlugin : public CompilationDatabasePlugin {
   std::unique_ptr<CompilationDatabase>
   loadFromDirectory(StringRef Directory, std::string &ErrorMessage) override {
@@ -166,14 +430,25 @@ std::unique_ptr<JSONCompilationDatabase>
 JSONCompilationDatabase::loadFromFile(StringRef FilePath,
                                       std::string &ErrorMessage,
                                       JSONCommandLineSyntax Syntax) {
+  // Look at the database before reading it; the index is only used if it
+  // was written for a database of this size and modification time.
+  llvm::sys::fs::file_status Status;
+  bool HasStatus = !llvm::sys::fs::status(FilePath, Status);
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> DatabaseBuffer =
-      llvm::MemoryBuffer::getFile(FilePath);
+      llvm::MemoryBuffer::getFile(FilePath, /*FileSize=*/-1,
+                                  /*RequiresNullTerminator=*/false);
   if (std::error_code Result = DatabaseBuffer.getError()) {
     ErrorMessage = "Error while opening JSON database: " + Result.message();
     return nullptr;
   }
   std::unique_ptr<JSONCompilationDatabase> Database(
       new JSONCompilationDatabase(std::move(*DatabaseBuffer), Syntax));
+  uint64_t Size = Database->Database->getBufferSize();
+  HasStatus = HasStatus && Status.getSize() == Size;
+  uint64_t ModTime = HasStatus ? getModificationTime(Status) : 0;
+  std::string IndexPath = (FilePath + ".idx").str();
+  if (HasStatus && Database->readIndexFile(IndexPath, Size, ModTime))
+    return Database;
   if (!Database->parse(ErrorMessage))
     return nullptr;
   return Database;
@@ -192,6 +467,33 @@ JSONCompilationDatabase::loadFromBuffer(StringRef DatabaseString,
   return Database;
 }
 
+bool JSONCompilationDatabase::writeIndex(StringRef FilePath,
+                                         std::string &ErrorMessage,
+                                         JSONCommandLineSyntax Syntax) {
+  llvm::sys::fs::file_status Status;
+  if (std::error_code Result = llvm::sys::fs::status(FilePath, Status)) {
+    ErrorMessage = "Error while opening JSON database: " + Result.message();
+    return false;
+  }
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> DatabaseBuffer =
+      llvm::MemoryBuffer::getFile(FilePath, /*FileSize=*/-1,
+                                  /*RequiresNullTerminator=*/false);
+  if (std::error_code Result = DatabaseBuffer.getError()) {
+    ErrorMessage = "Error while opening JSON database: " + Result.message();
+    return false;
+  }
+  JSONCompilationDatabase Database(std::move(*DatabaseBuffer), Syntax);
+  if (!Database.parse(ErrorMessage))
+    return false;
+  uint64_t Size = Database.Database->getBufferSize();
+  if (Status.getSize() != Size) {
+    ErrorMessage = "Error while writing index: the database changed";
+    return false;
+  }
+  return Database.writeIndexFile((FilePath + ".idx").str(), Size,
+                                 getModificationTime(Status), ErrorMessage);
+}
+
 std::vector<CompileCommand>
 JSONCompilationDatabase::getCompileCommands(StringRef FilePath) const {
   SmallString<128> NativeFilePath;
@@ -234,15 +536,15 @@ JSONCompilationDatabase::getAllCompileCommands() const {
 }
 
 static std::vector<std::string>
-nodeToCommandLine(JSONCommandLineSyntax Syntax,
-                  const std::vector<llvm::yaml::ScalarNode *> &Nodes) {
+entryToCommandLine(JSONCommandLineSyntax Syntax, const CommandEntry &Entry) {
   SmallString<1024> Storage;
-  if (Nodes.size() == 1) {
-    return unescapeCommandLine(Syntax, Nodes[0]->getValue(Storage));
+  if (Entry.CommandLine.size() == 1) {
+    return unescapeCommandLine(
+        Syntax, unescapeJSONString(Entry.CommandLine[0], Storage));
   }
   std::vector<std::string> Arguments;
-  for (auto *Node : Nodes) {
-    Arguments.push_back(Node->getValue(Storage));
+  for (StringRef Argument : Entry.CommandLine) {
+    Arguments.push_back(unescapeJSONString(Argument, Storage));
   }
   return Arguments;
 }
@@ -250,123 +552,185 @@ nodeToCommandLine(JSONCommandLineSyntax Syntax,
 void JSONCompilationDatabase::getCommands(
     ArrayRef<CompileCommandRef> CommandsRef,
     std::vector<CompileCommand> &Commands) const {
-  for (int I = 0, E = CommandsRef.size(); I != E; ++I) {
+  StringRef Buffer = Database->getBuffer();
+  CommandEntry Entry;
+  std::string ErrorMessage;
+  for (const CompileCommandRef &Ref : CommandsRef) {
+    // Every entry was checked by parse(), or by the scan that wrote an index
+    // for this very database.
+    JSONScanner Scanner(Buffer.substr(Ref.Offset, Ref.Length));
+    if (!scanEntry(Scanner, Entry, ErrorMessage))
+      continue;
     SmallString<8> DirectoryStorage;
     SmallString<32> FilenameStorage;
     SmallString<32> OutputStorage;
-    auto Output = std::get<3>(CommandsRef[I]);
     Commands.emplace_back(
-        std::get<0>(CommandsRef[I])->getValue(DirectoryStorage),
-        std::get<1>(CommandsRef[I])->getValue(FilenameStorage),
-        nodeToCommandLine(Syntax, std::get<2>(CommandsRef[I])),
-        Output ? Output->getValue(OutputStorage) : "");
+        unescapeJSONString(Entry.Directory, DirectoryStorage),
+        unescapeJSONString(Entry.File, FilenameStorage),
+        entryToCommandLine(Syntax, Entry),
+        Entry.Output ? unescapeJSONString(*Entry.Output, OutputStorage) : "");
   }
 }
 
-bool JSONCompilationDatabase::parse(std::string &ErrorMessage) {
-  llvm::yaml::document_iterator I = YAMLStream.begin();
-  if (I == YAMLStream.end()) {
-    ErrorMessage = "Error while parsing YAML.";
-    return false;
+void JSONCompilationDatabase::addEntry(StringRef Directory,
+                                       StringRef FileName, StringRef Entry) {
+  SmallString<128> NativeFilePath;
+  if (llvm::sys::path::is_relative(FileName)) {
+    SmallString<128> AbsolutePath(Directory);
+    llvm::sys::path::append(AbsolutePath, FileName);
+    llvm::sys::path::native(AbsolutePath, NativeFilePath);
+  } else {
+    llvm::sys::path::native(FileName, NativeFilePath);
   }
-  llvm::yaml::Node *Root = I->getRoot();
-  if (!Root) {
-    ErrorMessage = "Error while parsing YAML.";
+  CompileCommandRef Cmd = {
+      uint64_t(Entry.data() - Database->getBufferStart()),
+      uint32_t(Entry.size())};
+  IndexByFile[NativeFilePath].push_back(Cmd);
+  AllCommands.push_back(Cmd);
+  MatchTrie.insert(NativeFilePath);
+}
+
+bool JSONCompilationDatabase::parse(std::string &ErrorMessage) {
+  StringRef Buffer = Database->getBuffer();
+  JSONScanner Scanner(Buffer);
+  if (Scanner.atEnd()) {
+    ErrorMessage = "Error while parsing JSON.";
     return false;
   }
-  llvm::yaml::SequenceNode *Array = dyn_cast<llvm::yaml::SequenceNode>(Root);
-  if (!Array) {
+  if (!Scanner.consume('[')) {
     ErrorMessage = "Expected array.";
     return false;
   }
-  for (auto& NextObject : *Array) {
-    llvm::yaml::MappingNode *Object = dyn_cast<llvm::yaml::MappingNode>(&NextObject);
-    if (!Object) {
-      ErrorMessage = "Expected object.";
-      return false;
-    }
-    llvm::yaml::ScalarNode *Directory = nullptr;
-    llvm::Optional<std::vector<llvm::yaml::ScalarNode *>> Command;
-    llvm::yaml::ScalarNode *File = nullptr;
-    llvm::yaml::ScalarNode *Output = nullptr;
-    for (auto& NextKeyValue : *Object) {
-      llvm::yaml::ScalarNode *KeyString =
-          dyn_cast<llvm::yaml::ScalarNode>(NextKeyValue.getKey());
-      if (!KeyString) {
-        ErrorMessage = "Expected strings as key.";
-        return false;
-      }
-      SmallString<10> KeyStorage;
-      StringRef KeyValue = KeyString->getValue(KeyStorage);
-      llvm::yaml::Node *Value = NextKeyValue.getValue();
-      if (!Value) {
-        ErrorMessage = "Expected value.";
-        return false;
-      }
-      llvm::yaml::ScalarNode *ValueString =
-          dyn_cast<llvm::yaml::ScalarNode>(Value);
-      llvm::yaml::SequenceNode *SequenceString =
-          dyn_cast<llvm::yaml::SequenceNode>(Value);
-      if (KeyValue == "arguments" && !SequenceString) {
-        ErrorMessage = "Expected sequence as value.";
-        return false;
-      } else if (KeyValue != "arguments" && !ValueString) {
-        ErrorMessage = "Expected string as value.";
-        return false;
-      }
-      if (KeyValue == "directory") {
-        Directory = ValueString;
-      } else if (KeyValue == "arguments") {
-        Command = std::vector<llvm::yaml::ScalarNode *>();
-        for (auto &Argument : *SequenceString) {
-          auto Scalar = dyn_cast<llvm::yaml::ScalarNode>(&Argument);
-          if (!Scalar) {
-            ErrorMessage = "Only strings are allowed in 'arguments'.";
-            return false;
-          }
-          Command->push_back(Scalar);
-        }
-      } else if (KeyValue == "command") {
-        if (!Command)
-          Command = std::vector<llvm::yaml::ScalarNode *>(1, ValueString);
-      } else if (KeyValue == "file") {
-        File = ValueString;
-      } else if (KeyValue == "output") {
-        Output = ValueString;
-      } else {
-        ErrorMessage = ("Unknown key: \"" +
-                        KeyString->getRawValue() + "\"").str();
+  CommandEntry Entry;
+  if (!Scanner.consume(']')) {
+    do {
+      Scanner.skipWhitespace();
+      size_t Begin = Scanner.getPosition();
+      if (!scanEntry(Scanner, Entry, ErrorMessage))
         return false;
-      }
-    }
-    if (!File) {
-      ErrorMessage = "Missing key: \"file\".";
+      SmallString<8> DirectoryStorage;
+      SmallString<32> FileStorage;
+      addEntry(unescapeJSONString(Entry.Directory, DirectoryStorage),
+               unescapeJSONString(Entry.File, FileStorage),
+               Buffer.slice(Begin, Scanner.getPosition()));
+    } while (Scanner.consume(','));
+    if (!Scanner.consume(']')) {
+      ErrorMessage = "Error while parsing JSON.";
       return false;
     }
-    if (!Command) {
-      ErrorMessage = "Missing key: \"command\" or \"arguments\".";
+  }
+  if (!Scanner.atEnd()) {
+    ErrorMessage = "Error while parsing JSON.";
+    return false;
+  }
+  return true;
+}
+
+// An index file holds IndexMagic, the size and modification time of the
+// database, the CompileCommandRefs of all entries in order, and then each
+// file's native path followed by the CompileCommandRefs of its entries.
+// All numbers are little endian.
+
+bool JSONCompilationDatabase::readIndexFile(StringRef IndexPath,
+                                            uint64_t Size, uint64_t ModTime) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> IndexBuffer =
+      llvm::MemoryBuffer::getFile(IndexPath, /*FileSize=*/-1,
+                                  /*RequiresNullTerminator=*/false);
+  if (!IndexBuffer)
+    return false;
+  IndexReader Reader((*IndexBuffer)->getBuffer());
+  StringRef Magic;
+  uint64_t IndexedSize, IndexedModTime;
+  if (!Reader.read(sizeof(IndexMagic) - 1, Magic) || Magic != IndexMagic ||
+      !Reader.read(IndexedSize) || !Reader.read(IndexedModTime) ||
+      IndexedSize != Size || IndexedModTime != ModTime)
+    return false;
+
+  StringRef Buffer = Database->getBuffer();
+  auto ReadRefs = [&](std::vector<CompileCommandRef> &Refs) {
+    uint32_t NumRefs;
+    if (!Reader.read(NumRefs) || Reader.remaining() / IndexRefSize < NumRefs)
       return false;
+    Refs.reserve(NumRefs);
+    for (uint32_t I = 0; I != NumRefs; ++I) {
+      CompileCommandRef Ref;
+      Reader.read(Ref.Offset);
+      Reader.read(Ref.Length);
+      if (Ref.Offset >= Size || Ref.Length > Size - Ref.Offset ||
+          Buffer[Ref.Offset] != '{')
+        return false;
+      Refs.push_back(Ref);
     }
-    if (!Directory) {
-      ErrorMessage = "Missing key: \"directory\".";
+    return true;
+  };
+
+  // Only replace the (empty) index once the whole file checked out.
+  std::vector<CompileCommandRef> Commands;
+  llvm::StringMap<std::vector<CompileCommandRef>> Files;
+  uint32_t NumFiles;
+  if (!ReadRefs(Commands) || !Reader.read(NumFiles))
+    return false;
+  for (uint32_t I = 0; I != NumFiles; ++I) {
+    uint32_t PathLength;
+    StringRef Path;
+    if (!Reader.read(PathLength) || !Reader.read(PathLength, Path) ||
+        !ReadRefs(Files[Path]))
       return false;
+  }
+  if (Reader.remaining() != 0)
+    return false;
+
+  AllCommands = std::move(Commands);
+  IndexByFile = std::move(Files);
+  for (const auto &File : IndexByFile)
+    MatchTrie.insert(File.getKey());
+  return true;
+}
+
+bool JSONCompilationDatabase::writeIndexFile(StringRef IndexPath,
+                                             uint64_t Size, uint64_t ModTime,
+                                             std::string &ErrorMessage) const {
+  // Write a temporary file and move it into place, so that concurrent loads
+  // never see half an index.
+  int FD;
+  SmallString<128> TempPath;
+  if (std::error_code Result = llvm::sys::fs::createUniqueFile(
+          IndexPath + "-%%%%%%%%", FD, TempPath)) {
+    ErrorMessage = "Error while writing index: " + Result.message();
+    return false;
+  }
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    llvm::support::endian::Writer<llvm::support::little> Writer(OS);
+    auto WriteRefs = [&](ArrayRef<CompileCommandRef> Refs) {
+      Writer.write<uint32_t>(Refs.size());
+      for (const CompileCommandRef &Ref : Refs) {
+        Writer.write<uint64_t>(Ref.Offset);
+        Writer.write<uint32_t>(Ref.Length);
+      }
+    };
+    OS << IndexMagic;
+    Writer.write<uint64_t>(Size);
+    Writer.write<uint64_t>(ModTime);
+    WriteRefs(AllCommands);
+    Writer.write<uint32_t>(IndexByFile.size());
+    for (const auto &File : IndexByFile) {
+      Writer.write<uint32_t>(File.getKey().size());
+      OS << File.getKey();
+      WriteRefs(File.getValue());
     }
-    SmallString<8> FileStorage;
-    StringRef FileName = File->getValue(FileStorage);
-    SmallString<128> NativeFilePath;
-    if (llvm::sys::path::is_relative(FileName)) {
-      SmallString<8> DirectoryStorage;
-      SmallString<128> AbsolutePath(
-          Directory->getValue(DirectoryStorage));
-      llvm::sys::path::append(AbsolutePath, FileName);
-      llvm::sys::path::native(AbsolutePath, NativeFilePath);
-    } else {
-      llvm::sys::path::native(FileName, NativeFilePath);
+    OS.close();
+    if (OS.has_error()) {
+      OS.clear_error();
+      llvm::sys::fs::remove(TempPath);
+      ErrorMessage = "Error while writing index.";
+      return false;
     }
-    auto Cmd = CompileCommandRef(Directory, File, *Command, Output);
-    IndexByFile[NativeFilePath].push_back(Cmd);
-    AllCommands.push_back(Cmd);
-    MatchTrie.insert(NativeFilePath);
+  }
+  if (std::error_code Result = llvm::sys::fs::rename(TempPath, IndexPath)) {
+    llvm::sys::fs::remove(TempPath);
+    ErrorMessage = "Error while writing index: " + Result.message();
+    return false;
   }
   return true;
 }
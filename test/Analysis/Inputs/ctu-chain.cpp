@@ -0,0 +1,3 @@
+int chained(int x) {
+  return x * 3;
+}
@@ -0,0 +1,41 @@
+int callee(int);
+
+int f(int x) {
+  return x - 1;
+}
+
+int g(int x) {
+  return x + 1;
+}
+
+int h(int x) {
+  return callee(x) * 2;
+}
+
+int callee(int x) {
+  return x + 3;
+}
+
+static int internal(int x) {
+  return x;
+}
+
+namespace myns {
+int fns(int x) {
+  return x + 7;
+}
+}
+
+class mycls {
+public:
+  int fcl(int x);
+  static int fscl(int x);
+};
+
+int mycls::fcl(int x) {
+  return x + 5;
+}
+
+int mycls::fscl(int x) {
+  return x + 6;
+}
@@ -0,0 +1,53 @@
+// RUN: rm -rf %t && mkdir -p %t/ctudir
+// RUN: %clang_cc1 -triple x86_64-pc-linux-gnu -emit-pch -o %t/ctudir/ctu-other.cpp.ast %S/Inputs/ctu-other.cpp
+// RUN: %clang_cc1 -triple x86_64-pc-linux-gnu -emit-pch -o %t/ctudir/ctu-chain.cpp.ast %S/Inputs/ctu-chain.cpp
+// RUN: cd %S/Inputs
+// RUN: clang-func-mapping ctu-other.cpp ctu-chain.cpp -- -target x86_64-pc-linux-gnu > %t/ctudir/externalFnMap.txt
+// RUN: %clang_analyze_cc1 -triple x86_64-pc-linux-gnu -analyzer-checker=core,debug.ExprInspection -analyzer-config experimental-enable-naive-ctu-analysis=true -analyzer-config ctu-dir=%t/ctudir -verify %s
+// RUN: %clang_analyze_cc1 -triple x86_64-pc-linux-gnu -analyzer-checker=core,debug.ExprInspection -analyzer-config experimental-enable-naive-ctu-analysis=true -analyzer-config ctu-dir=%t/ctudir -analyzer-config ctu-memory-limit=1 -verify %s
+
+void clang_analyzer_eval(int);
+
+int f(int);
+int g(int);
+int h(int);
+int undefined(int);
+int chained(int);
+
+namespace myns {
+int fns(int x);
+}
+
+class mycls {
+public:
+  int fcl(int x);
+  static int fscl(int x);
+};
+
+void testImportedFunctions() {
+  clang_analyzer_eval(f(3) == 2); // expected-warning{{TRUE}}
+  clang_analyzer_eval(f(4) == 3); // expected-warning{{TRUE}}
+  clang_analyzer_eval(g(1) == 2); // expected-warning{{TRUE}}
+  clang_analyzer_eval(myns::fns(2) == 9); // expected-warning{{TRUE}}
+  mycls obj;
+  clang_analyzer_eval(obj.fcl(6) == 11); // expected-warning{{TRUE}}
+  clang_analyzer_eval(mycls::fscl(7) == 13); // expected-warning{{TRUE}}
+}
+
+// Functions called by an imported function are looked up the same way.
+void testTransitiveImport() {
+  clang_analyzer_eval(h(1) == 8); // expected-warning{{TRUE}}
+}
+
+// Definitions from different AST files can be imported into one function.
+// With ctu-memory-limit=1, each file is released after every import.
+void testTwoUnits() {
+  clang_analyzer_eval(f(3) == 2); // expected-warning{{TRUE}}
+  clang_analyzer_eval(chained(2) == 6); // expected-warning{{TRUE}}
+  clang_analyzer_eval(g(2) == 3); // expected-warning{{TRUE}}
+}
+
+// Functions missing from the index are evaluated conservatively.
+void testMissingDefinition() {
+  clang_analyzer_eval(undefined(1) == 1); // expected-warning{{UNKNOWN}}
+}
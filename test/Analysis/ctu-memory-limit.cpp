@@ -0,0 +1,24 @@
+// REQUIRES: asserts
+// RUN: rm -rf %t && mkdir -p %t/ctudir
+// RUN: %clang_cc1 -triple x86_64-pc-linux-gnu -emit-pch -o %t/ctudir/ctu-other.cpp.ast %S/Inputs/ctu-other.cpp
+// RUN: %clang_cc1 -triple x86_64-pc-linux-gnu -emit-pch -o %t/ctudir/ctu-chain.cpp.ast %S/Inputs/ctu-chain.cpp
+// RUN: cd %S/Inputs
+// RUN: clang-func-mapping ctu-other.cpp ctu-chain.cpp -- -target x86_64-pc-linux-gnu > %t/ctudir/externalFnMap.txt
+// RUN: %clang_analyze_cc1 -triple x86_64-pc-linux-gnu -analyzer-checker=core,debug.ExprInspection -analyzer-config experimental-enable-naive-ctu-analysis=true -analyzer-config ctu-dir=%t/ctudir -analyzer-config ctu-memory-limit=1 -analyzer-stats -verify %s 2>&1 | FileCheck %s
+
+void clang_analyzer_eval(int);
+
+int f(int);
+int g(int);
+int chained(int);
+
+// Every AST file is over a one-byte limit as soon as a definition has been
+// imported from it, so each import releases the file it came from. Only
+// measuring the files when they are loaded would release ctu-other.cpp.ast
+// once, when ctu-chain.cpp.ast is loaded, and then keep ctu-chain.cpp.ast.
+void testTwoUnits() {
+  clang_analyzer_eval(f(3) == 2); // expected-warning{{TRUE}}
+  clang_analyzer_eval(chained(2) == 6); // expected-warning{{TRUE}}
+}
+
+// CHECK: {{^ *}}2 CrossTranslationUnit - The # of AST files released to stay in the limit
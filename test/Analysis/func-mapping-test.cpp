@@ -0,0 +1,22 @@
+// RUN: clang-func-mapping %s -- | FileCheck %s
+// RUN: clang-func-mapping %s -- | FileCheck %s --check-prefix=NEG
+
+int f(int) {
+  return 0;
+}
+// CHECK-DAG: c:@F@f#I# {{.*}}func-mapping-test.cpp.ast
+
+namespace ns {
+int g(int) {
+  return 0;
+}
+}
+// CHECK-DAG: c:@N@ns@F@g#I# {{.*}}func-mapping-test.cpp.ast
+
+// Functions with internal linkage and declarations are not indexed.
+static int h(int) {
+  return 0;
+}
+int k(int);
+// NEG-NOT: @F@h
+// NEG-NOT: @F@k
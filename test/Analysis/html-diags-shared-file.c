@@ -0,0 +1,44 @@
+// RUN: rm -rf %t
+// RUN: %clang_analyze_cc1 -analyzer-output=html -analyzer-checker=core -analyzer-config stable-report-filename=true -o %t %s
+// RUN: cat %t/report-*-f1-*.html | FileCheck %s -check-prefix=F1
+// RUN: cat %t/report-*-f2-*.html | FileCheck %s -check-prefix=F2
+// RUN: cat %t/report-*-f3-*.html | FileCheck %s -check-prefix=F3
+
+// The reports share the highlighting of this file, which is applied over
+// the path of each of them.
+
+#define NULL ((int *)0)
+#define DEREF(p) (*(p))
+
+void f1(void) {
+  int *p = NULL;
+  *p = 1;
+}
+
+void f2(int x) {
+  int *q = 0;
+  if (x)
+    *q = 2;
+}
+
+int f3(void) {
+  int *r = 0;
+  return DEREF(r);
+}
+
+// F1: <span class='keyword'>void</span>
+// F1: <span class='macro'>NULL
+// F1: <tr><td class="num" id="LN15">15</td><td class="line">{{.*}}</td></tr>{{$}}
+// F1-NEXT: <tr><td class="num"></td><td class="line"><div id="EndPath"
+// F1: Dereference of null pointer (loaded from variable 'p')
+
+// F2: <span class='keyword'>void</span>
+// F2: <span class='macro'>NULL
+// F2: <tr><td class="num" id="LN21">21</td><td class="line">{{.*}}</td></tr>{{$}}
+// F2-NEXT: <tr><td class="num"></td><td class="line"><div id="EndPath"
+// F2: Dereference of null pointer (loaded from variable 'q')
+
+// The path range covers the expansion of DEREF; the macro highlighting is
+// nested inside it.
+// F3: <span class="mrange"><span class='macro'>DEREF(r)<span class='expansion'>{{[^<]*}}</span></span></span>;
+// F3: Dereference of null pointer (loaded from variable 'r')
@@ -0,0 +1,48 @@
+// RUN: %clang_analyze_cc1 -analyzer-checker=debug.DumpLiveVars %s 2>&1 | FileCheck %s
+// RUN: %clang_analyze_cc1 -analyzer-checker=deadcode.DeadStores -DMANY_LOCALS -verify %s
+
+#ifndef MANY_LOCALS
+int pick(int a, int b) {
+  int c = a + b;
+  if (a)
+    return c;
+  return b;
+}
+
+// CHECK: [ B1 (live variables at block exit) ]
+// CHECK-NEXT: {{^$}}
+// CHECK-NEXT: [ B2 (live variables at block exit) ]
+// CHECK-NEXT: {{^$}}
+// CHECK-NEXT: [ B3 (live variables at block exit) ]
+// CHECK-NEXT:  b <{{.*}}:5:21>
+// CHECK-NEXT:  c <{{.*}}:6:7>
+// CHECK-NEXT: {{^$}}
+// CHECK-NEXT: [ B4 (live variables at block exit) ]
+// CHECK-NEXT:  a <{{.*}}:5:14>
+// CHECK-NEXT:  b <{{.*}}:5:21>
+#else
+// Every statement records a snapshot of the live variables, so a function
+// with many locals used to take time and memory quadratic in their number.
+// The dead store after the last local is reported from the far end of the
+// numbering.
+#define LOCAL(i, x) \
+  int var_##i = x ^ i; if ((x % 7) == (i % 7)) var_##i = x; x += var_##i;
+#define EXPAND_2_LOCALS(i, x)    LOCAL(i##0, x)           LOCAL(i##1, x)
+#define EXPAND_4_LOCALS(i, x)    EXPAND_2_LOCALS(i##0, x) EXPAND_2_LOCALS(i##1, x)
+#define EXPAND_8_LOCALS(i, x)    EXPAND_4_LOCALS(i##0, x) EXPAND_4_LOCALS(i##1, x)
+#define EXPAND_16_LOCALS(i, x)   EXPAND_8_LOCALS(i##0, x) EXPAND_8_LOCALS(i##1, x)
+#define EXPAND_32_LOCALS(i, x)   EXPAND_16_LOCALS(i##0, x) EXPAND_16_LOCALS(i##1, x)
+#define EXPAND_64_LOCALS(i, x)   EXPAND_32_LOCALS(i##0, x) EXPAND_32_LOCALS(i##1, x)
+#define EXPAND_128_LOCALS(i, x)  EXPAND_64_LOCALS(i##0, x) EXPAND_64_LOCALS(i##1, x)
+#define EXPAND_256_LOCALS(i, x)  EXPAND_128_LOCALS(i##0, x) EXPAND_128_LOCALS(i##1, x)
+#define EXPAND_512_LOCALS(i, x)  EXPAND_256_LOCALS(i##0, x) EXPAND_256_LOCALS(i##1, x)
+#define EXPAND_1024_LOCALS(i, x) EXPAND_512_LOCALS(i##0, x) EXPAND_512_LOCALS(i##1, x)
+#define EXPAND_2048_LOCALS(i, x) EXPAND_1024_LOCALS(i##0, x) EXPAND_1024_LOCALS(i##1, x)
+
+unsigned many_locals(unsigned x) {
+  EXPAND_2048_LOCALS(1, x)
+  unsigned last;
+  last = x; // expected-warning {{Value stored to 'last' is never read}}
+  return x;
+}
+#endif
@@ -0,0 +1,63 @@
+// RUN: %clang -std=c++1z -Xclang -freflection %s 
+// RUN: %clang -std=c++1z -Xclang -freflection -fsyntax-only \
+// RUN:   -Xclang -print-stats %s 2>&1 | FileCheck %s
+
+// Both classes below generate some members by copying them and adopt others.
+// CHECK: {{^[1-9][0-9]*}} declarations copied by injection.
+// CHECK-NEXT: {{^[1-9][0-9]*}} prototype members adopted.
+
+#include <cppx/meta>
+#include <cppx/compiler>
+
+using namespace cppx;
+
+template<typename T>
+constexpr void copy_all(T proto) {
+  for... (auto v : proto.member_variables()) {
+    __generate v;
+  }
+  for... (auto f : proto.member_functions()) {
+    __generate f;
+  }
+}
+
+// Members that don't refer to the prototype are moved into the generated
+// class; the others are copied.
+class(copy_all) S {
+public:
+  int a;
+  int b = 42;
+  static int answer() { return 42; }
+  int get_b() const { return b; }
+};
+
+template<typename T>
+constexpr void copy_members(T proto) {
+  for... (auto m : proto.members()) {
+    __generate m;
+  }
+}
+
+// Scoped enums are adopted; unscoped enums are copied so that their
+// enumerators are found in the generated class.
+class(copy_members) C {
+public:
+  enum E { A, B };
+  enum class F { X, Y };
+  static int first() { return A; }
+};
+
+int main() {
+  S s;
+  s.a = 1;
+  assert(s.a == 1);
+  assert(s.b == 42);
+  assert(S::answer() == 42);
+  assert(s.get_b() == 42);
+
+  C::E e = C::A;
+  assert(e == 0);
+  assert(C::B == 1);
+  assert(C::first() == 0);
+  assert(C::F::Y != C::F::X);
+}
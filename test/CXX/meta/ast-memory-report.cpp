@@ -0,0 +1,38 @@
+// RUN: %clang -std=c++1z -Xclang -freflection -fsyntax-only -fast-memory-report=%t.csv %s
+// RUN: FileCheck %s < %t.csv
+// RUN: not %clang -std=c++1z -Xclang -freflection -fsyntax-only -fast-memory-report=%S/doesnotexist/report.csv %s 2>&1 | FileCheck %s --check-prefix=OUTPUTFAIL
+
+#include <cppx/meta>
+
+template<typename T>
+T twice(T x) { return x + x; }
+
+struct S {
+  constexpr {
+    __generate __fragment struct {
+      int get() const { return twice(21); }
+    };
+  }
+};
+
+int f() { return S().get(); }
+
+int g(int x) { return x; }
+
+// Implicitly declared special members are not instantiated.
+struct P { int x; };
+P make() { return P(); }
+
+constexpr int members = $S.member_functions().size();
+
+// CHECK: file,kind,origin,count,bytes
+// CHECK-DAG: "{{.*}}ast-memory-report.cpp",FunctionDecl,parsed,{{[0-9]+}},{{[0-9]+}}
+// CHECK-DAG: "{{.*}}ast-memory-report.cpp",DeclRefExpr,parsed,{{[0-9]+}},{{[0-9]+}}
+// CHECK-DAG: "{{.*}}ast-memory-report.cpp",ImplicitCastExpr,parsed,{{[0-9]+}},{{[0-9]+}}
+// CHECK-DAG: "{{.*}}ast-memory-report.cpp",CXXConstructorDecl,parsed,{{[0-9]+}},{{[0-9]+}}
+// CHECK-DAG: "{{.*}}ast-memory-report.cpp",{{[A-Za-z]+}},instantiated,{{[0-9]+}},{{[0-9]+}}
+// CHECK-DAG: "{{.*}}ast-memory-report.cpp",CXXMethodDecl,injected,{{[0-9]+}},{{[0-9]+}}
+// CHECK-DAG: "{{.*}}meta{{.*}}",{{[A-Za-z]+}},reflection,{{[0-9]+}},{{[0-9]+}}
+// CHECK: "<other>",Other,other,0,{{[0-9]+}}
+
+// OUTPUTFAIL: error: unable to open output file '{{.*}}doesnotexist{{.}}report.csv'
@@ -0,0 +1,17 @@
+// RUN: %clang -std=c++1z -Xclang -freflection -g -fcompact-reflection-debug-info -S -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang -std=c++1z -Xclang -freflection -g -S -emit-llvm -o - %s | FileCheck %s --check-prefix=FULL
+
+#include <cppx/meta>
+
+struct S { int n; };
+
+int main() {
+  auto m = $S;
+  (void)m;
+}
+
+// The reflection type is only declared, but the reflected class is complete.
+// CHECK-DAG: !DICompositeType(tag: DW_TAG_structure_type, name: "class_type<{{-?[0-9]+}}>"{{.*}}flags: DIFlagFwdDecl
+// CHECK-DAG: !DICompositeType(tag: DW_TAG_structure_type, name: "S"{{.*}}elements:
+
+// FULL: !DICompositeType(tag: DW_TAG_structure_type, name: "class_type<{{-?[0-9]+}}>"{{.*}}elements:
@@ -0,0 +1,34 @@
+// RUN: %clang -std=c++1z -Xclang -freflection -S -emit-llvm -o - %s | FileCheck %s
+
+#include <cppx/meta>
+
+// Calls to the reflection library outside constant expressions are replaced
+// by their values. Equal names are emitted as a single string constant.
+
+namespace N {
+struct S { int n; };
+}
+
+// CHECK: @[[QNAME:[^ ]+]] = private unnamed_addr constant [5 x i8] c"N::S\00"
+// CHECK-NOT: c"N::S\00"
+
+// CHECK-LABEL: define {{.*}}qualified
+// CHECK-NOT: call
+// CHECK: @[[QNAME]]
+const char *qualified() {
+  return $N::S.qualified_name();
+}
+
+// CHECK-LABEL: define {{.*}}templated
+// CHECK-NOT: call
+// CHECK: @[[QNAME]]
+template<typename T>
+const char *templated() {
+  return $T.qualified_name();
+}
+
+const char *instantiate() {
+  return templated<N::S>();
+}
+
+// CHECK-NOT: define {{.*}}qualified_name
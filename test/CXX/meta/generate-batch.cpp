@@ -0,0 +1,23 @@
+// RUN: %clang -std=c++1z -Xclang -freflection %s 
+
+#include <cppx/meta>
+
+// Each iteration injects the same fragment with a different captured value.
+// These injections are applied as a single batch.
+struct S {
+  constexpr {
+    for (int n = 0; n < 64; ++n) {
+      __generate __fragment struct {
+        int idexpr("x", n) = n;
+        int idexpr("get_x", n)() const { return idexpr("x", n); }
+      };
+    }
+  }
+};
+
+int main() {
+  S s;
+  assert(s.x0 == 0);
+  assert(s.x31 == 31);
+  assert(s.get_x63() == 63);
+}
@@ -0,0 +1,36 @@
+// RUN: %clang -std=c++1z -Xclang -freflection %s 
+
+#include <cppx/meta>
+
+constexpr const char *prefix = "get";
+
+struct Tag { };
+
+// The non-dependent operands before and after the captured value are folded
+// when the fragment is parsed; each injection only evaluates n.
+struct S {
+  constexpr {
+    for (int n = 0; n < 16; ++n) {
+      __generate __fragment struct {
+        int idexpr("field", "_", n) = n;
+        int idexpr(prefix, "_field_", n, "_", $Tag)() const {
+          return idexpr("field", "_", n);
+        }
+      };
+    }
+  }
+};
+
+template <int N>
+int get() {
+  S s;
+  return s.idexpr(prefix, "_", "field_", N, "_", $Tag)();
+}
+
+int main() {
+  S s;
+  assert(s.field_0 == 0);
+  assert(s.get_field_15_Tag() == 15);
+  assert(get<3>() == 3);
+  assert(get<3>() == s.field_3);
+}
@@ -0,0 +1,27 @@
+// RUN: %clang -std=c++1z -Xclang -freflection -g -fdebug-injection-origins -finjection-map=%t.map -S -emit-llvm -o - %s | FileCheck %s
+// RUN: FileCheck %s --check-prefix=MAP < %t.map
+
+#include <cppx/meta>
+
+struct S {
+  constexpr {
+    __generate __fragment struct {
+      int get() const { return 42; }
+    };
+  }
+};
+
+int main() {
+  S s;
+  return s.get();
+}
+
+// The injected function is located at the metaprogram that injected it, and
+// its body is inlined there from the fragment.
+// CHECK: define {{.*}} @_ZNK1S3getEv({{.*}} !dbg [[FN:![0-9]+]]
+// CHECK-DAG: [[FN]] = distinct !DISubprogram(name: "get", {{.*}}line: 7,
+// CHECK-DAG: !DILocation(line: 9, {{.*}}scope: [[SRC:![0-9]+]], inlinedAt: [[POI:![0-9]+]])
+// CHECK-DAG: [[SRC]] = distinct !DISubprogram(name: "__fragment::get", {{.*}}line: 9,
+// CHECK-DAG: [[POI]] = !DILocation(line: 7, {{.*}}scope: [[FN]])
+
+// MAP: _ZNK1S3getEv	0	S	{{.*}}injection-origins.cpp:9:{{[0-9]+}}	{{.*}}injection-origins.cpp:7:{{[0-9]+}}	-
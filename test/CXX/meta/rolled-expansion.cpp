@@ -0,0 +1,128 @@
+// RUN: %clang -target x86_64-linux-gnu -std=c++1z -Xclang -freflection -S -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang -target x86_64-linux-gnu -std=c++1z -Xclang -freflection -fno-roll-expansion-statements -S -emit-llvm -o - %s | FileCheck %s --check-prefix=UNROLLED
+// RUN: %clang -target x86_64-linux-gnu -std=c++1z -Xclang -freflection -fsyntax-only -Xclang -ast-dump %s | FileCheck %s --check-prefix=DUMP
+
+#include <cppx/meta>
+
+enum color { red = 1, green = 2, blue = 4, cyan = 8 };
+
+void use(int, const char *);
+
+template<typename T>
+void visit(T);
+
+// The expansions differ only in the value and the name of each enumerator,
+// so they are emitted as one loop over tables of those.
+void print_colors() {
+  for... (auto e : $color.members())
+    use(e.value(), e.name());
+}
+
+// CHECK-DAG: @_ZZ12print_colorsvE17__expansion_table{{.*}} = internal constant [4 x i32] [i32 1, i32 2, i32 4, i32 8]
+// CHECK-DAG: @_ZZ12print_colorsvE17__expansion_table{{.*}} = internal constant [4 x i8*]
+
+// CHECK-LABEL: define void @_Z12print_colorsv()
+// CHECK: icmp ne i64 %{{.*}}, 4
+// CHECK: getelementptr inbounds [4 x i32], [4 x i32]* @_ZZ12print_colorsvE17__expansion_table
+// CHECK: getelementptr inbounds [4 x i8*], [4 x i8*]* @_ZZ12print_colorsvE17__expansion_table
+// CHECK: call void @_Z3useiPKc(
+// CHECK-NOT: call void @_Z3useiPKc(
+// CHECK: ret void
+
+// UNROLLED-LABEL: define void @_Z12print_colorsv()
+// UNROLLED-NOT: __expansion_table
+// UNROLLED: call void @_Z3useiPKc(
+// UNROLLED: call void @_Z3useiPKc(
+// UNROLLED: call void @_Z3useiPKc(
+// UNROLLED: call void @_Z3useiPKc(
+// UNROLLED: ret void
+
+// Break and continue in the body apply to the loop.
+bool stop(int);
+
+void find_color() {
+  for... (auto e : $color.members()) {
+    if (stop(e.value()))
+      break;
+    if (e.value() == green)
+      continue;
+    use(e.value(), e.name());
+  }
+}
+
+// CHECK-LABEL: define void @_Z10find_colorv()
+// CHECK: getelementptr inbounds [4 x i32], [4 x i32]* @_ZZ10find_colorvE17__expansion_table
+// CHECK: call zeroext i1 @_Z4stopi(
+// CHECK-NOT: call zeroext i1 @_Z4stopi(
+// CHECK: call void @_Z3useiPKc(
+// CHECK-NOT: call void @_Z3useiPKc(
+// CHECK: ret void
+
+// A loop variable that is not an empty object is kept, and initialized from
+// a table.
+struct triple { };
+
+namespace std {
+  template<typename T> struct tuple_size;
+  template<> struct tuple_size<::triple> { static constexpr int value = 3; };
+}
+
+template<int I> constexpr int get(triple) { return (I + 1) * 10; }
+
+constexpr triple weights{};
+
+void sink(int);
+
+void sum_weights() {
+  for... (auto w : weights)
+    sink(w);
+}
+
+// CHECK-DAG: @_ZZ11sum_weightsvE17__expansion_table{{.*}} = internal constant [3 x i32] [i32 10, i32 20, i32 30]
+
+// CHECK-LABEL: define void @_Z11sum_weightsv()
+// CHECK: icmp ne i64 %{{.*}}, 3
+// CHECK: getelementptr inbounds [3 x i32], [3 x i32]* @_ZZ11sum_weightsvE17__expansion_table
+// CHECK: call void @_Z4sinki(
+// CHECK-NOT: call void @_Z4sinki(
+// CHECK: ret void
+
+// Each expansion passes the loop variable to a different specialization, so
+// they are emitted one by one.
+void visit_colors() {
+  for... (auto e : $color.members())
+    visit(e);
+}
+
+// CHECK-LABEL: define void @_Z12visit_colorsv()
+// CHECK-NOT: __expansion_table
+// CHECK: call void @_Z5visit
+// CHECK: call void @_Z5visit
+// CHECK: call void @_Z5visit
+// CHECK: call void @_Z5visit
+// CHECK: ret void
+
+constexpr int kDebug = 7;
+void check(int);
+
+// The call to check does not depend on the element, so the instantiated
+// statements share it. Its argument has the same value for every element
+// and is left as it is in the loop, as in the instantiated statements.
+void check_colors() {
+  for... (auto e : $color.members()) {
+    use(e.value(), e.name());
+    check(kDebug + 1);
+  }
+}
+
+// DUMP-LABEL: FunctionDecl {{.*}} check_colors 'void ()'
+// DUMP-NOT: IntegerLiteral {{.*}} 'int' 8
+// DUMP: CXXTupleExpansionStmt
+// DUMP-NOT: IntegerLiteral {{.*}} 'int' 8
+// DUMP: ForStmt
+// DUMP-NOT: IntegerLiteral {{.*}} 'int' 8
+// DUMP: CallExpr {{.*}} 'void'
+// DUMP: BinaryOperator {{.*}} 'int' '+'
+// DUMP-NEXT: ImplicitCastExpr
+// DUMP-NEXT: DeclRefExpr {{.*}} 'kDebug'
+// DUMP-NOT: IntegerLiteral {{.*}} 'int' 8
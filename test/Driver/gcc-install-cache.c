@@ -0,0 +1,18 @@
+// Check that a cached scan for GCC installations selects the same one as a
+// fresh scan, and reports the same candidates.
+//
+// RUN: rm -rf %t
+// RUN: %clang -v --target=i386-unknown-linux \
+// RUN:           --gcc-toolchain="" --gcc-install-cache=%t \
+// RUN:           --sysroot=%S/Inputs/debian_multiarch_tree 2>&1 | FileCheck %s
+// RUN: ls %t | FileCheck --check-prefix=CHECK-FILE %s
+// RUN: %clang -v --target=i386-unknown-linux \
+// RUN:           --gcc-toolchain="" --gcc-install-cache=%t \
+// RUN:           --sysroot=%S/Inputs/debian_multiarch_tree 2>&1 | FileCheck %s
+
+// CHECK: Found candidate GCC installation: {{.*}}Inputs{{.}}debian_multiarch_tree{{.}}usr{{.}}lib{{.}}gcc{{.}}i686-linux-gnu{{.}}4.5
+// CHECK-NEXT: Found candidate GCC installation: {{.*}}Inputs{{.}}debian_multiarch_tree{{.}}usr{{.}}lib{{.}}gcc{{.}}x86_64-linux-gnu{{.}}4.5
+// CHECK-NEXT: Selected GCC installation: {{.*}}Inputs{{.}}debian_multiarch_tree{{.}}usr{{.}}lib{{.}}gcc{{.}}i686-linux-gnu{{.}}4.5
+
+// CHECK-FILE: gcc-install-{{[0-9a-f]+}}.txt
+
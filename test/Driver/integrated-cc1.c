@@ -0,0 +1,30 @@
+// RUN: %clang -fintegrated-cc1 -fsyntax-only %s 2>&1 \
+// RUN:   | FileCheck --check-prefix=OK %s
+//
+// A crash in the frontend is caught, and the crash diagnostics are still
+// generated (by running the preprocessor in a process of its own).
+// RUN: rm -rf %t
+// RUN: mkdir %t
+// RUN: not env TMPDIR=%t TEMP=%t TMP=%t \
+// RUN:   %clang -fintegrated-cc1 -fsyntax-only -DCRASH %s 2>&1 \
+// RUN:   | FileCheck --check-prefix=CRASH %s
+//
+// Only single-job compilations run cc1 in the driver's process, and
+// "handle_crash" does nothing without a crash recovery context.
+// RUN: %clang -fintegrated-cc1 -fsyntax-only -DCRASH %s %s 2>&1 \
+// RUN:   | FileCheck --check-prefix=OK %s
+// RUN: %clang -fno-integrated-cc1 -fsyntax-only -DCRASH %s 2>&1 \
+// RUN:   | FileCheck --check-prefix=OK %s
+// REQUIRES: crash-recovery
+
+#warning compiled
+// OK: warning: compiled
+// OK-NOT: error:
+
+#ifdef CRASH
+#pragma clang __debug handle_crash
+#endif
+// CRASH: warning: compiled
+// CRASH: error: clang frontend command failed due to signal
+// CRASH: Preprocessed source(s) and associated run script(s) are located at:
+// CRASH-NEXT: note: diagnostic msg: {{.*}}integrated-cc1-{{.*}}.c
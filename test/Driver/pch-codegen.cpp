@@ -0,0 +1,16 @@
+// RUN: %clang -### -x c++-header -fpch-codegen %s -o %t.pch 2>&1 | FileCheck -check-prefix=CODEGEN %s
+// CODEGEN: "-emit-pch"
+// CODEGEN-SAME: "-fpch-instantiate-templates"
+// CODEGEN-SAME: "-fmodules-codegen"
+
+// RUN: %clang -### -x c++-header -fpch-codegen -fno-pch-instantiate-templates %s -o %t.pch 2>&1 | FileCheck -check-prefix=NO-INST %s
+// NO-INST-NOT: "-fpch-instantiate-templates"
+
+// RUN: %clang -### -x c++-header -fpch-debuginfo %s -o %t.pch 2>&1 | FileCheck -check-prefix=DEBUGINFO %s
+// DEBUGINFO: "-emit-pch"
+// DEBUGINFO-SAME: "-fmodules-debuginfo"
+
+// RUN: touch %t.pch
+// RUN: %clang -### -c %t.pch -o %t.o 2>&1 | FileCheck -check-prefix=OBJECT %s
+// OBJECT: "-emit-obj"
+// OBJECT-SAME: "-x" "precompiled-header"
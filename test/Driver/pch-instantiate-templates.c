@@ -0,0 +1,6 @@
+// RUN: %clang -### -x c++-header -fpch-instantiate-templates %s -o %t.pch 2>&1 | FileCheck %s
+// CHECK: "-emit-pch"
+// CHECK-SAME: "-fpch-instantiate-templates"
+
+// RUN: %clang -### -x c++-header -fpch-instantiate-templates -fno-pch-instantiate-templates %s -o %t.pch 2>&1 | FileCheck -check-prefix=CHECK-NO %s
+// CHECK-NO-NOT: "-fpch-instantiate-templates"
@@ -0,0 +1,16 @@
+// RUN: rm -f %t.cache
+// RUN: cp %s %t.cpp
+// RUN: clang-format -style=LLVM -i -format-cache=%t.cache %t.cpp
+// RUN: FileCheck -strict-whitespace -input-file=%t.cpp %s
+// RUN: FileCheck -check-prefix=CACHE -input-file=%t.cache %s
+// RUN: clang-format -style="{BasedOnStyle: llvm, PointerAlignment: Left}" \
+// RUN:   -i -format-cache=%t.cache %t.cpp
+// RUN: FileCheck -check-prefix=LEFT -strict-whitespace -input-file=%t.cpp %s
+// RUN: not clang-format -format-cache=%t.cache %t.cpp 2>&1 \
+// RUN:   | FileCheck -check-prefix=ERROR %s
+
+// CHECK: {{^int\ \*i;}}
+// CACHE: {{^[0-9a-f]{32} .*\.cpp$}}
+// LEFT: {{^int\*\ i;}}
+// ERROR: error: -format-cache can only be used with -i
+ int   *  i  ;
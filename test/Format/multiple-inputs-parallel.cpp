@@ -0,0 +1,7 @@
+// RUN: cp %s %t-1.cpp
+// RUN: echo " int   *  j  ;" > %t-2.cpp
+// RUN: clang-format -style=LLVM -j 2 %t-1.cpp %t-2.cpp|FileCheck -strict-whitespace %s
+
+// CHECK: {{^int\ \*i;}}
+// CHECK: {{^int\ \*j;}}
+ int   *  i  ;
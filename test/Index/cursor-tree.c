@@ -0,0 +1,21 @@
+int global;
+int add(int a, int b) {
+  int sum = a + b;
+  return sum;
+}
+
+// RUN: c-index-test -test-print-cursor-tree 8,9,10 %s | FileCheck %s
+// CHECK: 0: VarDecl=global parent=-1 offset=4 extent=0-{{[0-9]+}}
+// CHECK-NEXT: 1: FunctionDecl=add parent=-1 offset=16 extent=12-{{[0-9]+}}
+// CHECK-NEXT: 2: ParmDecl=a parent=1 offset=24
+// CHECK-NEXT: 3: ParmDecl=b parent=1 offset=31
+// CHECK-NEXT: 4: VarDecl=sum parent=1 offset=42
+// CHECK-NOT: {{[0-9]+}}:
+
+// RUN: c-index-test -test-print-cursor-tree all %s \
+// RUN:   | FileCheck -check-prefix=CHECK-ALL %s
+// CHECK-ALL: [[ADD:[0-9]+]]: FunctionDecl=add parent=-1
+// CHECK-ALL: [[BODY:[0-9]+]]: CompoundStmt= parent=[[ADD]]
+// CHECK-ALL: [[DECL:[0-9]+]]: DeclStmt= parent=[[BODY]]
+// CHECK-ALL: VarDecl=sum parent=[[DECL]]
+// CHECK-ALL: ReturnStmt= parent=[[BODY]]
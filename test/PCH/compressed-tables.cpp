@@ -0,0 +1,54 @@
+// REQUIRES: zlib
+
+// Test this without pch.
+// RUN: %clang_cc1 -include %s -fsyntax-only -verify %s
+
+// Test with pch, with and without compressed tables.
+// RUN: %clang_cc1 -x c++-header -emit-pch -o %t %s
+// RUN: %clang_cc1 -include-pch %t -fsyntax-only -verify %s
+// RUN: %clang_cc1 -x c++-header -emit-pch -fcompress-pch-tables -o %t.z %s
+// RUN: %clang_cc1 -include-pch %t.z -fsyntax-only -verify %s
+// RUN: %clang_cc1 -include-pch %t.z -fsyntax-only -print-stats %s 2>&1 \
+// RUN:   | FileCheck %s
+
+// CHECK: {{[1-9][0-9]*}} compressed tables decompressed
+
+// Loading a C++ module built from this header preloads the identifiers that
+// name its macros. That must not decompress its identifier table as long as
+// none of them is used.
+// RUN: rm -rf %t.dir
+// RUN: mkdir %t.dir
+// RUN: echo 'module compressed { header "%s" }' > %t.dir/modulemap
+// RUN: echo > %t.dir/empty.cpp
+// RUN: %clang_cc1 -fmodules -emit-module -fmodule-name=compressed -x c++ \
+// RUN:   -fcompress-pch-tables %t.dir/modulemap -o %t.dir/compressed.pcm
+// RUN: %clang_cc1 -fmodules -fmodule-file=%t.dir/compressed.pcm \
+// RUN:   -fsyntax-only -print-stats %t.dir/empty.cpp 2>&1 \
+// RUN:   | FileCheck --check-prefix=MODULE %s
+
+// MODULE: {{^}}  0 compressed tables decompressed (0 bytes)
+
+// expected-no-diagnostics
+
+#ifndef HEADER
+#define HEADER
+
+#define DECL(n) int function_##n(); extern int variable_##n;
+#define DECL10(n) DECL(n##0) DECL(n##1) DECL(n##2) DECL(n##3) DECL(n##4) \
+                  DECL(n##5) DECL(n##6) DECL(n##7) DECL(n##8) DECL(n##9)
+#define DECL100(n) DECL10(n##0) DECL10(n##1) DECL10(n##2) DECL10(n##3) \
+                   DECL10(n##4) DECL10(n##5) DECL10(n##6) DECL10(n##7) \
+                   DECL10(n##8) DECL10(n##9)
+
+namespace large {
+DECL100(1)
+DECL100(2)
+DECL100(3)
+DECL100(4)
+}
+
+#else
+
+int use() { return large::function_123() + large::variable_456; }
+
+#endif
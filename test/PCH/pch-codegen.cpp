@@ -0,0 +1,31 @@
+// Test that inline functions and template instantiations from a PCH built with
+// -fmodules-codegen are emitted once, into the object file built from the PCH,
+// and only referenced by the translation units that include it.
+
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -x c++-header -emit-pch -fmodules-codegen -fpch-instantiate-templates -o %t %s
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -x precompiled-header -emit-llvm -o - %t | FileCheck -check-prefix=OBJ %s
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -include-pch %t -emit-llvm -o - %s | FileCheck -check-prefix=USE %s
+
+#ifndef HEADER
+#define HEADER
+
+template<typename T> T twice(T t) { return t + t; }
+
+inline int call_twice(int n) { return twice(n); }
+
+static inline int local(int n) { return n; }
+inline int call_local(int n) { return local(n); }
+
+#else
+
+int f(int n) { return call_twice(n) + call_local(n); }
+
+#endif
+
+// OBJ-DAG: define weak_odr i32 @_Z10call_twicei(
+// OBJ-DAG: define weak_odr i32 @_Z5twiceIiET_S0_(
+// OBJ-DAG: define weak_odr i32 @_Z10call_locali(
+
+// USE-DAG: declare i32 @_Z10call_twicei(
+// USE-DAG: declare i32 @_Z10call_locali(
+// USE-NOT: define {{.*}}@_Z10call_twicei(
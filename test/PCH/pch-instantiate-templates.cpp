@@ -0,0 +1,43 @@
+// Test that templates instantiated while building a PCH are used (and emitted)
+// by the translation units that include it.
+
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -x c++-header -emit-pch -fpch-instantiate-templates -o %t %s
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -include-pch %t -emit-llvm -o - %s | FileCheck %s
+
+// The instantiations are performed while building the PCH: the specialization
+// of twice has a body only when the flag is given.
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -x ast -ast-dump-all %t | FileCheck %s --check-prefix=PCH
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -x c++-header -emit-pch -o %t.noinst %s
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -x ast -ast-dump-all %t.noinst | FileCheck %s --check-prefix=NOINST
+
+#ifndef HEADER
+#define HEADER
+
+template<typename T> T twice(T t) { return t + t; }
+
+template<typename T> struct S {
+  T get() const { return twice(Value); }
+  T Value;
+};
+
+inline int call_twice(int n) { return twice(n); }
+inline int call_get(const S<int> &s) { return s.get(); }
+
+#else
+
+int f(int n) { return call_twice(n) + call_get(S<int>{n}); }
+
+// CHECK-DAG: define linkonce_odr i32 @_Z10call_twicei(
+// CHECK-DAG: define linkonce_odr i32 @_Z5twiceIiET_S0_(
+// CHECK-DAG: define linkonce_odr i32 @_ZNK1SIiE3getEv(
+
+// PCH: FunctionDecl {{.*}} twice 'int (int)'
+// PCH-NOT: FunctionDecl
+// PCH: CompoundStmt
+// PCH: ClassTemplateDecl {{.*}} S
+
+// NOINST: FunctionDecl {{.*}} twice 'int (int)'
+// NOINST-NOT: CompoundStmt
+// NOINST: ClassTemplateDecl {{.*}} S
+
+#endif
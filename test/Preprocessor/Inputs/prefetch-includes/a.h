@@ -0,0 +1,3 @@
+#include "sub/b.h"
+#include <c.h>
+int from_a = FROM_B + FROM_C;
@@ -0,0 +1 @@
+#define FROM_C 2
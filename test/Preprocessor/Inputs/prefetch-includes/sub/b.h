@@ -0,0 +1 @@
+#define FROM_B 1
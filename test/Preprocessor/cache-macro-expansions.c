@@ -0,0 +1,43 @@
+// RUN: %clang_cc1 -cache-macro-expansions -fsyntax-only -verify %s
+// RUN: %clang_cc1 -cache-macro-expansions -fsyntax-only -print-stats %s 2>&1 \
+// RUN:   | FileCheck %s
+// expected-no-diagnostics
+
+#define ONE 1
+#define TWO (ONE + ONE)
+#define FOUR (TWO * TWO)
+
+_Static_assert(FOUR == 4, "");
+_Static_assert(FOUR == 4, "");
+
+// Redefining a macro the expansion depends on invalidates it.
+#undef ONE
+#define ONE 2
+_Static_assert(FOUR == 16, "");
+_Static_assert(FOUR == 16, "");
+
+// So does defining a name that was not a macro before.
+#define PLUS_X (1 + X)
+enum { X = 1 };
+_Static_assert(PLUS_X == 2, "");
+#define X 5
+_Static_assert(PLUS_X == 6, "");
+
+// Expansions that use builtin macros are not cached.
+#define LINE __LINE__
+_Static_assert(LINE == __LINE__, "");
+_Static_assert(LINE == __LINE__, "");
+
+// A function-like macro at the end can take arguments from after the
+// expansion.
+#define ID(x) x
+#define CALL ID
+_Static_assert(CALL(3) == 3, "");
+_Static_assert(CALL(4) == 4, "");
+
+// Function-like macros invoked within the expansion are fine.
+#define SIX ID(6)
+_Static_assert(SIX == 6, "");
+_Static_assert(SIX == 6, "");
+
+// CHECK: macro expansions cached, {{[1-9][0-9]*}} expanded from the cache
@@ -0,0 +1,25 @@
+// Headers read ahead by the include prefetcher, including those whose name is
+// computed by a macro, must give the same result as synchronous reading.
+
+// REQUIRES: thread_support
+
+// RUN: %clang_cc1 -prefetch-includes -I %S/Inputs/prefetch-includes -E %s | FileCheck %s
+// RUN: %clang_cc1 -prefetch-includes -I %S/Inputs/prefetch-includes -print-stats -fsyntax-only %s 2>&1 | FileCheck -check-prefix=STATS %s
+
+#include "a.h"
+#define HEADER <c.h>
+#include HEADER
+#if 0
+#include "missing.h"
+#endif
+
+int result = from_a + FROM_C;
+
+// CHECK: int from_a = 1 + 2;
+// CHECK: int result = from_a + 2;
+
+// The main file is scanned before it is lexed, and a header is only handed to
+// the preprocessor once the headers it names are queued, so a.h, sub/b.h and
+// c.h are always read ahead. HEADER is only seen by the preprocessor.
+// STATS: *** Include Prefetcher Stats:
+// STATS-NEXT: 3 files prefetched, 3 used by the preprocessor, 0 discarded as stale.
@@ -0,0 +1,36 @@
+// RUN: %clang_cc1 -fsyntax-only -verify -std=c++11 %s
+
+// Candidate sets larger than their initial storage must keep their
+// candidates, conversion sequences and deduction failures intact as they
+// grow, including while other candidate sets are being built.
+
+template <int N> struct T { operator int() const; };
+
+#define F(i) void f(T<i>);
+F(0) F(1) F(2) F(3) F(4) F(5) F(6) F(7) F(8) F(9) // expected-note 10{{candidate function not viable}}
+F(10) F(11) F(12) F(13) F(14) F(15) F(16) F(17) F(18) F(19) // expected-note 10{{candidate function not viable}}
+
+template <typename U> void f(U *); // expected-note {{candidate template ignored}}
+
+struct Conv {
+  // Converting the argument resolves a nested overload set.
+  operator T<17>() const;
+};
+
+void test() {
+  f(T<0>());
+  f(T<19>());
+  f(Conv());
+  f(0.0); // expected-error {{no matching function for call to 'f'}}
+}
+
+void g(long, int); // expected-note {{candidate function}}
+void g(int, long); // expected-note {{candidate function}}
+#define G(i) void g(T<i>, T<i>);
+G(0) G(1) G(2) G(3) G(4) G(5) G(6) G(7) G(8) G(9)
+G(10) G(11) G(12) G(13) G(14) G(15) G(16) G(17) G(18) G(19)
+
+void test_ambiguous() {
+  g(T<3>(), T<3>());
+  g(1, 2); // expected-error {{call to 'g' is ambiguous}}
+}
@@ -0,0 +1,51 @@
+// RUN: %clang_cc1 -fsyntax-only -std=c++11 -verify %s
+// RUN: %clang_cc1 -fsyntax-only -std=c++11 -print-stats %s 2>&1 | FileCheck %s
+// expected-no-diagnostics
+
+// Repeated calls with the same argument types reuse the result of overload
+// resolution, as long as nothing that lookup could find has been declared
+// in between.
+
+// CHECK: {{[1-9][0-9]*}} overload resolutions reused
+
+namespace N {
+  struct A {};
+  char f(A, long);
+  char operator+(A, long);
+}
+
+void before(N::A a) {
+  static_assert(sizeof(f(a, 1)) == 1, "");
+  static_assert(sizeof(f(a, 1)) == 1, "");
+  static_assert(sizeof(a + 1) == 1, "");
+  static_assert(sizeof(a + 1) == 1, "");
+}
+
+// Better matches declared later must be found.
+namespace N {
+  int f(A, int);
+  int operator+(A, int);
+}
+
+void after(N::A a) {
+  static_assert(sizeof(f(a, 1)) == sizeof(int), "");
+  static_assert(sizeof(a + 1) == sizeof(int), "");
+}
+
+// Null pointer constants convert differently than other values of their type.
+char g(N::A, void *);
+int g(N::A, ...);
+
+void null(N::A a, int i) {
+  static_assert(sizeof(g(a, 0)) == 1, "");
+  static_assert(sizeof(g(a, i)) == sizeof(int), "");
+  static_assert(sizeof(g(a, 0)) == 1, "");
+}
+
+// Results are shared between instantiations.
+template<typename T> struct Logger {
+  static_assert(sizeof(f(T(), 1)) == sizeof(int), "");
+  static_assert(sizeof(T() + 1) == sizeof(int), "");
+};
+template struct Logger<N::A>;
+
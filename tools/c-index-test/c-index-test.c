@@ -1617,6 +1617,69 @@ static int print_target_info(int argc, const char **argv) {
   return 0;
 }
 
+/******************************************************************************/
+/* Flattened cursor tree testing.                                             */
+/******************************************************************************/
+
+static int print_cursor_tree(const char *filter, int argc, const char **argv) {
+  CXIndex Idx;
+  CXTranslationUnit TU;
+  CXCursorTree Tree;
+  const CXCursorRecord *Records;
+  enum CXCursorKind Kinds[32];
+  unsigned NumKinds = 0;
+  unsigned I, NumRecords;
+  enum CXErrorCode Err;
+
+  if (argc == 0) {
+    fprintf(stderr, "No filename specified\n");
+    return 1;
+  }
+
+  /* The filter is either "all" or a comma-separated list of cursor kinds. */
+  if (strcmp(filter, "all") != 0) {
+    const char *Kind = filter;
+    while (*Kind && NumKinds < 32) {
+      Kinds[NumKinds++] = (enum CXCursorKind)atoi(Kind);
+      Kind = strchr(Kind, ',');
+      if (!Kind)
+        break;
+      ++Kind;
+    }
+  }
+
+  Idx = clang_createIndex(0, 1);
+  Err = clang_parseTranslationUnit2(Idx, 0, argv, argc, NULL, 0,
+                                    getDefaultParsingOptions(), &TU);
+  if (Err != CXError_Success) {
+    fprintf(stderr, "Couldn't parse translation unit!\n");
+    describeLibclangFailure(Err);
+    clang_disposeIndex(Idx);
+    return 1;
+  }
+
+  Tree = clang_getCursorTree(clang_getTranslationUnitCursor(TU),
+                             NumKinds ? Kinds : NULL, NumKinds);
+  Records = clang_CursorTree_getRecords(Tree);
+  NumRecords = clang_CursorTree_getNumRecords(Tree);
+  for (I = 0; I != NumRecords; ++I) {
+    CXString KindSpelling = clang_getCursorKindSpelling(Records[I].kind);
+    CXString Spelling =
+        clang_getCursorSpelling(clang_CursorTree_getCursor(Tree, I));
+    printf("%u: %s=%s parent=%d offset=%u extent=%u-%u\n", I,
+           clang_getCString(KindSpelling), clang_getCString(Spelling),
+           Records[I].parent, Records[I].offset, Records[I].extent_start,
+           Records[I].extent_end);
+    clang_disposeString(Spelling);
+    clang_disposeString(KindSpelling);
+  }
+
+  clang_CursorTree_dispose(Tree);
+  clang_disposeTranslationUnit(TU);
+  clang_disposeIndex(Idx);
+  return 0;
+}
+
 /******************************************************************************/
 /* Loading ASTs/source.                                                       */
 /******************************************************************************/
@@ -4360,6 +4423,7 @@ static void print_usage(void) {
     "       c-index-test -test-print-type-size {<args>}*\n"
     "       c-index-test -test-print-bitwidth {<args>}*\n"
     "       c-index-test -test-print-target-info {<args>}*\n"
+    "       c-index-test -test-print-cursor-tree <kind filter> {<args>}*\n"
     "       c-index-test -test-print-type-declaration {<args>}*\n"
     "       c-index-test -print-usr [<CursorKind> {<args>}]*\n"
     "       c-index-test -print-usr-file <file>\n");
@@ -4472,6 +4536,8 @@ int cindextest_main(int argc, const char **argv) {
     return perform_test_load_tu(argv[2], "all", NULL, PrintManglings, NULL);
   else if (argc > 2 && strcmp(argv[1], "-test-print-target-info") == 0)
     return print_target_info(argc - 2, argv + 2);
+  else if (argc > 3 && strcmp(argv[1], "-test-print-cursor-tree") == 0)
+    return print_cursor_tree(argv[2], argc - 3, argv + 3);
   else if (argc > 1 && strcmp(argv[1], "-print-usr") == 0) {
     if (argc > 2)
       return print_usrs(argv + 2, argv + argc);
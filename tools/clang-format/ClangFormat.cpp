@@ -20,9 +20,15 @@
 #include "clang/Basic/Version.h"
 #include "clang/Format/Format.h"
 #include "clang/Rewrite/Core/Rewriter.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/Signals.h"
+#include "llvm/Support/ThreadPool.h"
+#include <map>
+#include <mutex>
 
 using namespace llvm;
 using clang::tooling::Replacements;
@@ -102,12 +108,164 @@ static cl::opt<bool> SortIncludes(
              "SortIncludes style flag"),
     cl::cat(ClangFormatCategory));
 
+static cl::opt<unsigned>
+    NumThreads("j",
+               cl::desc("Format up to this many input files in parallel.\n"
+                        "Results are still printed in input order.\n"
+                        "Use -j 0 to use one thread per core."),
+               cl::init(1), cl::cat(ClangFormatCategory));
+
+static cl::opt<std::string> FormatCache(
+    "format-cache",
+    cl::desc("Record the files left formatted by -i in this file, and\n"
+             "skip files whose name, content and style match a\n"
+             "record from a previous run.\n"
+             "Can only be used with -i."),
+    cl::value_desc("filename"), cl::cat(ClangFormatCategory));
+
 static cl::list<std::string> FileNames(cl::Positional, cl::desc("[<file> ...]"),
                                        cl::cat(ClangFormatCategory));
 
 namespace clang {
 namespace format {
 
+/// Returns the MD5 digest of \p Parts, as a hex string.
+static std::string computeDigest(ArrayRef<StringRef> Parts) {
+  MD5 Hash;
+  for (StringRef Part : Parts) {
+    Hash.update(Part);
+    Hash.update(StringRef("", 1));
+  }
+  MD5::MD5Result Result;
+  Hash.final(Result);
+  SmallString<32> Digest;
+  MD5::stringifyResult(Result, Digest);
+  return Digest.str();
+}
+
+/// Caches the styles of the directories holding the input files, so that
+/// the .clang-format files above a directory are only looked up and parsed
+/// once per language instead of once per file.
+class StyleCache {
+public:
+  struct Entry {
+    FormatStyle Style;
+    /// The digest of the style's configuration text.
+    std::string Digest;
+  };
+
+  /// Returns the style for \p FileName, which holds \p Code.
+  llvm::Expected<Entry> get(StringRef FileName, StringRef Code) {
+    // getStyle() only depends on the directory holding the file and on the
+    // language of the file.
+    SmallString<128> Dir(FileName);
+    sys::fs::make_absolute(Dir);
+    sys::path::remove_filename(Dir);
+    auto Key = std::make_pair(Dir.str().str(),
+                              unsigned(guessLanguage(FileName, Code)));
+    {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      auto It = Entries.find(Key);
+      if (It != Entries.end())
+        return It->second;
+    }
+
+    llvm::Expected<FormatStyle> FormatStyle =
+        getStyle(Style, FileName, FallbackStyle, Code);
+    if (!FormatStyle)
+      return FormatStyle.takeError();
+    Entry E;
+    E.Style = *FormatStyle;
+    std::string Config = configurationAsText(E.Style);
+    E.Digest = computeDigest({Config});
+
+    std::lock_guard<std::mutex> Lock(Mutex);
+    return Entries.insert(std::make_pair(Key, E)).first->second;
+  }
+
+private:
+  std::mutex Mutex;
+  std::map<std::pair<std::string, unsigned>, Entry> Entries;
+};
+
+/// The on-disk record of the files -i left formatted, used by -format-cache.
+/// Each line of the file holds the digest of a formatted file followed by
+/// its absolute path.
+class FormattedFileCache {
+public:
+  explicit FormattedFileCache(StringRef Path) : Path(Path) {}
+
+  /// Reads the records of a previous run.  A missing file is an empty cache.
+  void load() {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> Buffer =
+        MemoryBuffer::getFile(Path);
+    if (!Buffer)
+      return;
+    SmallVector<StringRef, 64> Lines;
+    (*Buffer)->getBuffer().split(Lines, '\n', -1, /*KeepEmpty=*/false);
+    for (StringRef Line : Lines) {
+      std::pair<StringRef, StringRef> Record = Line.split(' ');
+      if (!Record.second.empty())
+        Digests[Record.second] = Record.first.str();
+    }
+  }
+
+  /// Writes the records back.  Returns true on error.
+  bool save() {
+    if (!Dirty)
+      return false;
+    std::string TempPath = Path + ".tmp";
+    {
+      std::error_code EC;
+      raw_fd_ostream OS(TempPath, EC, sys::fs::F_Text);
+      if (EC) {
+        errs() << "error: cannot write " << TempPath << ": " << EC.message()
+               << "\n";
+        return true;
+      }
+      for (const auto &Record : Digests)
+        OS << Record.second << ' ' << Record.first() << '\n';
+    }
+    if (std::error_code EC = sys::fs::rename(TempPath, Path)) {
+      errs() << "error: cannot write " << Path << ": " << EC.message() << "\n";
+      return true;
+    }
+    return false;
+  }
+
+  /// Returns true if \p FileName was left formatted with the digest
+  /// \p Digest.
+  bool isFormatted(StringRef FileName, StringRef Digest) {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    auto It = Digests.find(FileName);
+    return It != Digests.end() && It->second == Digest;
+  }
+
+  void setFormatted(StringRef FileName, StringRef Digest) {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Digests[FileName] = Digest.str();
+    Dirty = true;
+  }
+
+private:
+  std::string Path;
+  std::mutex Mutex;
+  StringMap<std::string> Digests;
+  bool Dirty = false;
+};
+
+/// Returns the digest recorded in the format cache for \p FileName holding
+/// \p Code, formatted with \p Style.
+static std::string computeFileDigest(StringRef FileName,
+                                     const StyleCache::Entry &Style,
+                                     StringRef Code) {
+  StringRef SortIncludesOverride =
+      SortIncludes.getNumOccurrences() == 0 ? "" : SortIncludes ? "1" : "0";
+  std::string Version = getClangToolFullVersion("clang-format");
+  return computeDigest(
+      {Version, FileName, Style.Digest, SortIncludesOverride, Code});
+}
+
 static FileID createInMemoryFile(StringRef FileName, MemoryBuffer *Source,
                                  SourceManager &Sources, FileManager &Files,
                                  vfs::InMemoryFileSystem *MemFS) {
@@ -163,25 +321,27 @@ static bool fillRanges(MemoryBuffer *Code,
     return false;
   }
 
-  if (Offsets.empty())
-    Offsets.push_back(0);
-  if (Offsets.size() != Lengths.size() &&
-      !(Offsets.size() == 1 && Lengths.empty())) {
+  // Files may be formatted in parallel, so don't touch the global -offset.
+  std::vector<unsigned> Starts(Offsets.begin(), Offsets.end());
+  if (Starts.empty())
+    Starts.push_back(0);
+  if (Starts.size() != Lengths.size() &&
+      !(Starts.size() == 1 && Lengths.empty())) {
     errs() << "error: number of -offset and -length arguments must match.\n";
     return true;
   }
-  for (unsigned i = 0, e = Offsets.size(); i != e; ++i) {
-    if (Offsets[i] >= Code->getBufferSize()) {
-      errs() << "error: offset " << Offsets[i] << " is outside the file\n";
+  for (unsigned i = 0, e = Starts.size(); i != e; ++i) {
+    if (Starts[i] >= Code->getBufferSize()) {
+      errs() << "error: offset " << Starts[i] << " is outside the file\n";
       return true;
     }
     SourceLocation Start =
-        Sources.getLocForStartOfFile(ID).getLocWithOffset(Offsets[i]);
+        Sources.getLocForStartOfFile(ID).getLocWithOffset(Starts[i]);
     SourceLocation End;
     if (i < Lengths.size()) {
-      if (Offsets[i] + Lengths[i] > Code->getBufferSize()) {
+      if (Starts[i] + Lengths[i] > Code->getBufferSize()) {
         errs() << "error: invalid length " << Lengths[i]
-               << ", offset + length (" << Offsets[i] + Lengths[i]
+               << ", offset + length (" << Starts[i] + Lengths[i]
                << ") is outside the file.\n";
         return true;
       }
@@ -196,48 +356,52 @@ static bool fillRanges(MemoryBuffer *Code,
   return false;
 }
 
-static void outputReplacementXML(StringRef Text) {
+static void outputReplacementXML(raw_ostream &OS, StringRef Text) {
   // FIXME: When we sort includes, we need to make sure the stream is correct
   // utf-8.
   size_t From = 0;
   size_t Index;
   while ((Index = Text.find_first_of("\n\r<&", From)) != StringRef::npos) {
-    outs() << Text.substr(From, Index - From);
+    OS << Text.substr(From, Index - From);
     switch (Text[Index]) {
     case '\n':
-      outs() << "&#10;";
+      OS << "&#10;";
       break;
     case '\r':
-      outs() << "&#13;";
+      OS << "&#13;";
       break;
     case '<':
-      outs() << "&lt;";
+      OS << "&lt;";
       break;
     case '&':
-      outs() << "&amp;";
+      OS << "&amp;";
       break;
     default:
       llvm_unreachable("Unexpected character encountered!");
     }
     From = Index + 1;
   }
-  outs() << Text.substr(From);
+  OS << Text.substr(From);
 }
 
-static void outputReplacementsXML(const Replacements &Replaces) {
+static void outputReplacementsXML(raw_ostream &OS,
+                                  const Replacements &Replaces) {
   for (const auto &R : Replaces) {
-    outs() << "<replacement "
-           << "offset='" << R.getOffset() << "' "
-           << "length='" << R.getLength() << "'>";
-    outputReplacementXML(R.getReplacementText());
-    outs() << "</replacement>\n";
+    OS << "<replacement "
+       << "offset='" << R.getOffset() << "' "
+       << "length='" << R.getLength() << "'>";
+    outputReplacementXML(OS, R.getReplacementText());
+    OS << "</replacement>\n";
   }
 }
 
+// Formats \p FileName, writing the result to \p OS and errors to \p ErrOS.
 // Returns true on error.
-static bool format(StringRef FileName) {
+static bool format(StringRef FileName, StyleCache &Styles,
+                   FormattedFileCache *Cache, raw_ostream &OS,
+                   raw_ostream &ErrOS) {
   if (!OutputXML && Inplace && FileName == "-") {
-    errs() << "error: cannot use -i when reading from stdin.\n";
+    ErrOS << "error: cannot use -i when reading from stdin.\n";
     return false;
   }
   // On Windows, overwriting a file with an open file mapping doesn't work,
@@ -246,7 +410,7 @@ static bool format(StringRef FileName) {
       !OutputXML && Inplace ? MemoryBuffer::getFileAsStream(FileName) :
                               MemoryBuffer::getFileOrSTDIN(FileName);
   if (std::error_code EC = CodeOrErr.getError()) {
-    errs() << EC.message() << "\n";
+    ErrOS << EC.message() << "\n";
     return true;
   }
   std::unique_ptr<llvm::MemoryBuffer> Code = std::move(CodeOrErr.get());
@@ -257,43 +421,53 @@ static bool format(StringRef FileName) {
     return true;
   StringRef AssumedFileName = (FileName == "-") ? AssumeFileName : FileName;
 
-  llvm::Expected<FormatStyle> FormatStyle =
-      getStyle(Style, AssumedFileName, FallbackStyle, Code->getBuffer());
-  if (!FormatStyle) {
-    llvm::errs() << llvm::toString(FormatStyle.takeError()) << "\n";
+  llvm::Expected<StyleCache::Entry> CachedStyle =
+      Styles.get(AssumedFileName, Code->getBuffer());
+  if (!CachedStyle) {
+    ErrOS << llvm::toString(CachedStyle.takeError()) << "\n";
     return true;
   }
 
+  SmallString<128> AbsoluteFileName(FileName);
+  if (Cache) {
+    sys::fs::make_absolute(AbsoluteFileName);
+    if (Cache->isFormatted(AbsoluteFileName,
+                           computeFileDigest(AbsoluteFileName, *CachedStyle,
+                                             Code->getBuffer())))
+      return false;
+  }
+
+  FormatStyle &FormatStyle = CachedStyle->Style;
   if (SortIncludes.getNumOccurrences() != 0)
-    FormatStyle->SortIncludes = SortIncludes;
+    FormatStyle.SortIncludes = SortIncludes;
   unsigned CursorPosition = Cursor;
-  Replacements Replaces = sortIncludes(*FormatStyle, Code->getBuffer(), Ranges,
+  Replacements Replaces = sortIncludes(FormatStyle, Code->getBuffer(), Ranges,
                                        AssumedFileName, &CursorPosition);
   auto ChangedCode = tooling::applyAllReplacements(Code->getBuffer(), Replaces);
   if (!ChangedCode) {
-    llvm::errs() << llvm::toString(ChangedCode.takeError()) << "\n";
+    ErrOS << llvm::toString(ChangedCode.takeError()) << "\n";
     return true;
   }
   // Get new affected ranges after sorting `#includes`.
   Ranges = tooling::calculateRangesAfterReplacements(Replaces, Ranges);
   FormattingAttemptStatus Status;
-  Replacements FormatChanges = reformat(*FormatStyle, *ChangedCode, Ranges,
+  Replacements FormatChanges = reformat(FormatStyle, *ChangedCode, Ranges,
                                         AssumedFileName, &Status);
   Replaces = Replaces.merge(FormatChanges);
   if (OutputXML) {
-    outs() << "<?xml version='1.0'?>\n<replacements "
-              "xml:space='preserve' incomplete_format='"
-           << (Status.FormatComplete ? "false" : "true") << "'";
+    OS << "<?xml version='1.0'?>\n<replacements "
+          "xml:space='preserve' incomplete_format='"
+       << (Status.FormatComplete ? "false" : "true") << "'";
     if (!Status.FormatComplete)
-      outs() << " line=" << Status.Line;
-    outs() << ">\n";
+      OS << " line=" << Status.Line;
+    OS << ">\n";
     if (Cursor.getNumOccurrences() != 0)
-      outs() << "<cursor>"
-             << FormatChanges.getShiftedCodePosition(CursorPosition)
-             << "</cursor>\n";
+      OS << "<cursor>"
+         << FormatChanges.getShiftedCodePosition(CursorPosition)
+         << "</cursor>\n";
 
-    outputReplacementsXML(Replaces);
-    outs() << "</replacements>\n";
+    outputReplacementsXML(OS, Replaces);
+    OS << "</replacements>\n";
   } else {
     IntrusiveRefCntPtr<vfs::InMemoryFileSystem> InMemoryFileSystem(
         new vfs::InMemoryFileSystem);
@@ -309,22 +483,67 @@ static bool format(StringRef FileName) {
     if (Inplace) {
       if (Rewrite.overwriteChangedFiles())
         return true;
+      if (Cache && Status.FormatComplete) {
+        auto FormattedCode =
+            tooling::applyAllReplacements(Code->getBuffer(), Replaces);
+        if (!FormattedCode) {
+          ErrOS << llvm::toString(FormattedCode.takeError()) << "\n";
+          return true;
+        }
+        Cache->setFormatted(AbsoluteFileName,
+                            computeFileDigest(AbsoluteFileName, *CachedStyle,
+                                              *FormattedCode));
+      }
     } else {
       if (Cursor.getNumOccurrences() != 0) {
-        outs() << "{ \"Cursor\": "
-               << FormatChanges.getShiftedCodePosition(CursorPosition)
-               << ", \"IncompleteFormat\": "
-               << (Status.FormatComplete ? "false" : "true");
+        OS << "{ \"Cursor\": "
+           << FormatChanges.getShiftedCodePosition(CursorPosition)
+           << ", \"IncompleteFormat\": "
+           << (Status.FormatComplete ? "false" : "true");
         if (!Status.FormatComplete)
-          outs() << ", \"Line\": " << Status.Line;
-        outs() << " }\n";
+          OS << ", \"Line\": " << Status.Line;
+        OS << " }\n";
       }
-      Rewrite.getEditBuffer(ID).write(outs());
+      Rewrite.getEditBuffer(ID).write(OS);
     }
   }
   return false;
 }
 
+// Formats all of \p Files, using up to -j threads.  Returns true on error.
+static bool formatFiles(ArrayRef<std::string> Files, StyleCache &Styles,
+                        FormattedFileCache *Cache) {
+  if (NumThreads == 1) {
+    bool Error = false;
+    for (const std::string &File : Files)
+      Error |= format(File, Styles, Cache, outs(), errs());
+    return Error;
+  }
+
+  // Buffer the output of each file so it can be printed in input order.
+  std::vector<std::string> Outputs(Files.size()), Errors(Files.size());
+  std::vector<char> Failed(Files.size());
+  {
+    std::unique_ptr<ThreadPool> Pool(NumThreads == 0
+                                         ? new ThreadPool()
+                                         : new ThreadPool(NumThreads));
+    for (unsigned i = 0, e = Files.size(); i != e; ++i)
+      Pool->async([&, i] {
+        raw_string_ostream OS(Outputs[i]), ErrOS(Errors[i]);
+        Failed[i] = format(Files[i], Styles, Cache, OS, ErrOS);
+      });
+    Pool->wait();
+  }
+
+  bool Error = false;
+  for (unsigned i = 0, e = Files.size(); i != e; ++i) {
+    outs() << Outputs[i];
+    errs() << Errors[i];
+    Error |= Failed[i];
+  }
+  return Error;
+}
+
 }  // namespace format
 }  // namespace clang
 
@@ -365,13 +584,27 @@ int main(int argc, const char **argv) {
     return 0;
   }
 
+  std::unique_ptr<clang::format::FormattedFileCache> Cache;
+  if (!FormatCache.empty()) {
+    if (!Inplace || OutputXML || !Offsets.empty() || !Lengths.empty() ||
+        !LineRanges.empty()) {
+      errs() << "error: -format-cache can only be used with -i and without "
+                "-offset, -length or -lines.\n";
+      return 1;
+    }
+    Cache.reset(new clang::format::FormattedFileCache(FormatCache));
+    Cache->load();
+  }
+
+  clang::format::StyleCache Styles;
   bool Error = false;
   switch (FileNames.size()) {
   case 0:
-    Error = clang::format::format("-");
+    Error = clang::format::format("-", Styles, Cache.get(), outs(), errs());
     break;
   case 1:
-    Error = clang::format::format(FileNames[0]);
+    Error = clang::format::format(FileNames[0], Styles, Cache.get(), outs(),
+                                  errs());
     break;
   default:
     if (!Offsets.empty() || !Lengths.empty() || !LineRanges.empty()) {
@@ -379,10 +612,11 @@ int main(int argc, const char **argv) {
                 "single file.\n";
       return 1;
     }
-    for (unsigned i = 0; i < FileNames.size(); ++i)
-      Error |= clang::format::format(FileNames[i]);
+    Error = clang::format::formatFiles(FileNames, Styles, Cache.get());
     break;
   }
+  if (Cache && Cache->save())
+    Error = true;
   return Error ? 1 : 0;
 }
 
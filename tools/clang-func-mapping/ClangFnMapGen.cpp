@@ -0,0 +1,134 @@
+//===--- ClangFnMapGen.cpp - Cross-TU function index generator ------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements the clang-func-mapping tool, which writes the index
+//  read by the static analyzer's cross translation unit analysis: one line
+//  per externally visible function defined in the given sources, mapping its
+//  USR to the AST file of the source that defines it.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/AST/ASTConsumer.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/Decl.h"
+#include "clang/Basic/SourceManager.h"
+#include "clang/CrossTU/CrossTranslationUnit.h"
+#include "clang/Frontend/CompilerInstance.h"
+#include "clang/Frontend/FrontendActions.h"
+#include "clang/Tooling/CommonOptionsParser.h"
+#include "clang/Tooling/Tooling.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Signals.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace clang;
+using namespace clang::cross_tu;
+using namespace clang::tooling;
+using namespace llvm;
+
+static cl::OptionCategory ClangFnMapGenCategory("clang-func-mapping options");
+static cl::extrahelp MoreHelp(
+    "\tPrints one line per externally visible function defined in the given\n"
+    "\tsources, of the form '<USR> <source>.ast'.  Sources below the current\n"
+    "\tdirectory are named relative to it.  Write the result to the index\n"
+    "\tfile in the directory passed to the analyzer as ctu-dir, and the AST\n"
+    "\tof each source to <ctu-dir>/<source>.ast, e.g. with -emit-ast.\n"
+    "\n");
+
+/// \brief The functions found so far, by USR.
+static llvm::StringMap<std::string> Index;
+
+/// \brief Return the name of the AST file of \p SourceFile, relative to the
+/// current directory if \p SourceFile is below it.
+static std::string getASTFileName(StringRef SourceFile) {
+  SmallString<256> CurrentDir;
+  StringRef Name = SourceFile;
+  if (!sys::fs::current_path(CurrentDir) && Name.startswith(CurrentDir) &&
+      Name.size() > CurrentDir.size() &&
+      sys::path::is_separator(Name[CurrentDir.size()]))
+    Name = Name.drop_front(CurrentDir.size() + 1);
+  return (Name + ".ast").str();
+}
+
+namespace {
+
+class MapFunctionNamesConsumer : public ASTConsumer {
+public:
+  MapFunctionNamesConsumer(ASTContext &Context, StringRef ASTFile)
+      : Ctx(Context), ASTFile(ASTFile) {}
+
+  void HandleTranslationUnit(ASTContext &Context) override {
+    handleDecl(Context.getTranslationUnitDecl());
+  }
+
+private:
+  void handleDecl(const Decl *D);
+
+  ASTContext &Ctx;
+  std::string ASTFile;
+};
+
+void MapFunctionNamesConsumer::handleDecl(const Decl *D) {
+  if (!D)
+    return;
+
+  if (const auto *FD = dyn_cast<FunctionDecl>(D)) {
+    // Functions defined in headers are available in every translation unit
+    // that includes them, so only the main file is indexed.
+    if (FD->isThisDeclarationADefinition() &&
+        FD->hasExternalFormalLinkage() &&
+        Ctx.getSourceManager().isInMainFile(FD->getLocation())) {
+      std::string LookupName =
+          CrossTranslationUnitContext::getLookupName(FD);
+      auto Inserted = Index.insert(std::make_pair(LookupName, ASTFile));
+      if (!Inserted.second && Inserted.first->second != ASTFile)
+        errs() << "warning: " << LookupName << " is defined in both "
+               << Inserted.first->second << " and " << ASTFile
+               << "; keeping the first\n";
+    }
+    return;
+  }
+
+  if (const auto *DC = dyn_cast<DeclContext>(D))
+    for (const Decl *Sub : DC->decls())
+      handleDecl(Sub);
+}
+
+class MapFunctionNamesAction : public ASTFrontendAction {
+protected:
+  std::unique_ptr<ASTConsumer> CreateASTConsumer(CompilerInstance &CI,
+                                                 StringRef InFile) override {
+    return llvm::make_unique<MapFunctionNamesConsumer>(CI.getASTContext(),
+                                                       getASTFileName(InFile));
+  }
+};
+
+} // end anonymous namespace
+
+int main(int argc, const char **argv) {
+  sys::PrintStackTraceOnErrorSignal(argv[0]);
+
+  // Initialize targets for clang module support.
+  InitializeAllTargets();
+  InitializeAllTargetMCs();
+  InitializeAllAsmPrinters();
+  InitializeAllAsmParsers();
+
+  CommonOptionsParser OptionsParser(argc, argv, ClangFnMapGenCategory);
+  ClangTool Tool(OptionsParser.getCompilations(),
+                 OptionsParser.getSourcePathList());
+  int Result =
+      Tool.run(newFrontendActionFactory<MapFunctionNamesAction>().get());
+
+  outs() << createCrossTUIndexString(Index);
+  return Result;
+}
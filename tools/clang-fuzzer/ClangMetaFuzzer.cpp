@@ -0,0 +1,496 @@
+//===-- ClangMetaFuzzer.cpp - Fuzz reflection and metaclasses -------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief This file implements a persistent-mode fuzzer for the reflection,
+///  fragment, injection and metaclass extensions. This function is then
+///  linked into the Fuzzer library.
+///
+/// Unlike clang-fuzzer, which feeds raw bytes to a freshly built compiler,
+/// this fuzzer treats its input as a sequence of choices in a small grammar
+/// of cppx programs, so that nearly every run gets past the parser and into
+/// SemaReflect.cpp and SemaInject.cpp. The driver is run once, the file
+/// manager is shared between runs, and <cppx/meta> is compiled once into a
+/// precompiled header that every run includes.
+///
+/// At exit, the fuzzer prints the number of executions per second, how many
+/// generated programs were accepted, and how many reflection, fragment,
+/// injection, constexpr and metaclass nodes were built. For line coverage of
+/// the reflection and injection code, run with -print_coverage=1.
+///
+//===----------------------------------------------------------------------===//
+
+#include "clang/AST/ASTConsumer.h"
+#include "clang/AST/RecursiveASTVisitor.h"
+#include "clang/Frontend/CompilerInstance.h"
+#include "clang/Frontend/CompilerInvocation.h"
+#include "clang/Frontend/FrontendActions.h"
+#include "clang/Frontend/Utils.h"
+#include "clang/Lex/PreprocessorOptions.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include <chrono>
+#include <cstdlib>
+
+using namespace clang;
+
+namespace {
+
+/// \brief The name under which every generated program is compiled.
+const char *const InputName = "./meta-test.cc";
+
+/// \brief The state that outlives a single run.
+struct FuzzerState {
+  IntrusiveRefCntPtr<FileManager> Files;
+  std::shared_ptr<PCHContainerOperations> PCHContainerOps;
+  std::shared_ptr<CompilerInvocation> BaseInvocation;
+  IgnoringDiagConsumer Diags;
+
+  /// \brief The precompiled <cppx/meta>, or empty if it could not be built
+  /// and every program includes the headers textually.
+  std::string PCHPath;
+  std::string PreludePath;
+
+  std::chrono::steady_clock::time_point Start;
+  unsigned NumRuns = 0;
+  unsigned NumAccepted = 0;
+  unsigned NumReflections = 0;
+  unsigned NumReflectionTraits = 0;
+  unsigned NumFragments = 0;
+  unsigned NumInjections = 0;
+  unsigned NumConstexprDecls = 0;
+  unsigned NumMetaclasses = 0;
+};
+
+FuzzerState *State = nullptr;
+
+const char Prelude[] = "#include <cppx/meta>\n"
+                       "#include <cppx/compiler>\n";
+
+/// \brief Counts the cppx nodes that a run managed to build.
+class MetaNodeCounter : public RecursiveASTVisitor<MetaNodeCounter> {
+public:
+  bool VisitReflectionExpr(ReflectionExpr *) {
+    ++State->NumReflections;
+    return true;
+  }
+  bool VisitReflectionTraitExpr(ReflectionTraitExpr *) {
+    ++State->NumReflectionTraits;
+    return true;
+  }
+  bool VisitCXXFragmentExpr(CXXFragmentExpr *) {
+    ++State->NumFragments;
+    return true;
+  }
+  bool VisitCXXInjectionStmt(CXXInjectionStmt *) {
+    ++State->NumInjections;
+    return true;
+  }
+  bool VisitConstexprDecl(ConstexprDecl *) {
+    ++State->NumConstexprDecls;
+    return true;
+  }
+  bool VisitMetaclassDecl(MetaclassDecl *) {
+    ++State->NumMetaclasses;
+    return true;
+  }
+};
+
+class MetaNodeCounterConsumer : public ASTConsumer {
+public:
+  void HandleTranslationUnit(ASTContext &Ctx) override {
+    MetaNodeCounter().TraverseDecl(Ctx.getTranslationUnitDecl());
+  }
+};
+
+class MetaNodeCounterAction : public ASTFrontendAction {
+protected:
+  std::unique_ptr<ASTConsumer> CreateASTConsumer(CompilerInstance &,
+                                                 StringRef) override {
+    return llvm::make_unique<MetaNodeCounterConsumer>();
+  }
+};
+
+/// \brief Turns the fuzzer's input into a cppx program.
+///
+/// Each byte of the input selects one production; once the input runs out,
+/// every choice takes its first, shortest alternative, so that the program
+/// is always closed off. A small fraction of choices splice in a stray token
+/// to reach the parser's recovery paths.
+class ProgramGenerator {
+  const uint8_t *Data;
+  size_t Size;
+  size_t Pos = 0;
+  unsigned Depth = 0;
+  unsigned NextID = 0;
+  std::string Out;
+
+  /// \brief The entities declared so far, available to later productions.
+  std::vector<std::string> Classes;
+  std::vector<std::string> Enums;
+  std::vector<std::string> FragmentFns;
+  std::vector<std::string> MetaFns;
+  std::vector<std::string> Metaclasses;
+
+  unsigned choose(unsigned N) {
+    if (Pos == Size || N <= 1)
+      return 0;
+    return Data[Pos++] % N;
+  }
+
+  std::string fresh(StringRef Prefix) {
+    return (Prefix + Twine(NextID++)).str();
+  }
+
+  const std::string &pick(const std::vector<std::string> &From) {
+    return From[choose(From.size())];
+  }
+
+  void emit(StringRef Text) {
+    static const char *const Noise[] = {
+        "$",         "__fragment", "__generate", "constexpr", "idexpr(",
+        "declname(", "typename(",  "for...",     "$class",    "class(",
+        "{",         "}",          ";",          "(",         ")"};
+    if (Pos != Size && Data[Pos] == 0xff) {
+      ++Pos;
+      Out += Noise[choose(llvm::array_lengthof(Noise))];
+      Out += ' ';
+    }
+    Out += Text;
+  }
+
+  std::string type() {
+    static const char *const Builtins[] = {"int", "char", "float", "long",
+                                           "bool"};
+    if (!Classes.empty() && choose(4) == 0)
+      return pick(Classes);
+    return Builtins[choose(llvm::array_lengthof(Builtins))];
+  }
+
+  void member() {
+    std::string Name = fresh("m");
+    switch (choose(5)) {
+    case 0:
+      emit(type() + " " + Name + ";\n");
+      break;
+    case 1:
+      emit("int " + Name + " = " + std::to_string(choose(100)) + ";\n");
+      break;
+    case 2:
+      emit("static int " + Name + "() { return 42; }\n");
+      break;
+    case 3:
+      emit("int " + Name + "() const { return 0; }\n");
+      break;
+    case 4:
+      emit("using " + Name + " = " + type() + ";\n");
+      break;
+    }
+  }
+
+  void members() {
+    for (unsigned I = 0, N = choose(4) + 1; I != N; ++I)
+      member();
+  }
+
+  /// \brief A range of members of something reflected at this point.
+  std::string reflection(bool InMetaclass) {
+    std::string R;
+    switch (choose(4)) {
+    case 0:
+      R = "$" + type();
+      break;
+    case 1:
+      R = InMetaclass ? "$prototype" : "$" + type();
+      break;
+    case 2:
+      R = Enums.empty() ? "$int" : "$" + pick(Enums);
+      break;
+    case 3:
+      R = Classes.empty() ? "$char" : "$" + pick(Classes);
+      break;
+    }
+    static const char *const Ranges[] = {"member_variables()",
+                                         "member_functions()", "members()"};
+    return R + "." + Ranges[choose(llvm::array_lengthof(Ranges))];
+  }
+
+  void fragment(StringRef Kind) {
+    emit(("__fragment " + Kind + " {\n").str());
+    if (++Depth < 3)
+      members();
+    --Depth;
+    emit("}");
+  }
+
+  /// \brief A statement inside a constexpr block or metaprogram.
+  void metaStatement(bool InMetaclass) {
+    switch (choose(6)) {
+    case 0:
+      emit("__generate ");
+      fragment(choose(2) ? "struct" : "class");
+      emit(";\n");
+      break;
+    case 1: {
+      std::string Var = fresh("x");
+      emit("for... (auto " + Var + " : " + reflection(InMetaclass) + ") {\n");
+      emit("__generate " + Var + ";\n");
+      emit("}\n");
+      break;
+    }
+    case 2: {
+      std::string Var = fresh("x");
+      emit("for... (auto " + Var + " : " + reflection(InMetaclass) + ") {\n");
+      emit("__generate class {\n");
+      emit("typename(" + Var + ") idexpr(\"get_\", " + Var +
+           ")() const { return idexpr(" + Var + "); }\n");
+      emit("};\n}\n");
+      break;
+    }
+    case 3: {
+      std::string Counter = fresh("n");
+      emit("int " + Counter + " = 0;\n");
+      emit("for... (auto x : " + reflection(InMetaclass) + ") {\n");
+      emit("__generate struct { int idexpr(\"f\", " + Counter + ") = " +
+           Counter + "; };\n");
+      emit("++" + Counter + ";\n}\n");
+      break;
+    }
+    case 4:
+      if (!FragmentFns.empty()) {
+        emit("__generate " + pick(FragmentFns) + "();\n");
+        break;
+      }
+      LLVM_FALLTHROUGH;
+    case 5: {
+      std::string Var = fresh("frag");
+      emit("auto " + Var + " = ");
+      fragment("struct");
+      emit(";\n__generate " + Var + ";\n");
+      break;
+    }
+    }
+  }
+
+  void constexprBlock(bool InMetaclass) {
+    emit("constexpr {\n");
+    for (unsigned I = 0, N = choose(3) + 1; I != N; ++I)
+      metaStatement(InMetaclass);
+    emit("}\n");
+  }
+
+  void topLevelDecl() {
+    switch (choose(6)) {
+    case 0: {
+      std::string Name = fresh("E");
+      emit("enum " + Name + " { ");
+      for (unsigned I = 0, N = choose(4) + 1; I != N; ++I)
+        emit(fresh("e") + ", ");
+      emit("};\n");
+      Enums.push_back(Name);
+      break;
+    }
+    case 1: {
+      std::string Name = fresh("S");
+      emit("struct " + Name + " {\n");
+      members();
+      if (choose(2))
+        constexprBlock(/*InMetaclass=*/false);
+      emit("};\n");
+      Classes.push_back(Name);
+      break;
+    }
+    case 2: {
+      std::string Name = fresh("make");
+      emit("constexpr auto " + Name + "() { return ");
+      fragment(choose(2) ? "class" : "struct");
+      emit("; }\n");
+      FragmentFns.push_back(Name);
+      break;
+    }
+    case 3: {
+      std::string Name = fresh("M");
+      emit("$class " + Name + " {\n");
+      if (choose(2))
+        members();
+      constexprBlock(/*InMetaclass=*/true);
+      emit("};\n");
+      Metaclasses.push_back(Name);
+      break;
+    }
+    case 4: {
+      std::string Name = fresh("meta");
+      emit("template<typename T> constexpr void " + Name + "(T proto) {\n");
+      emit("for... (auto v : proto.member_variables()) { __generate v; }\n");
+      if (choose(2))
+        emit("for... (auto f : proto.member_functions()) { __generate f; }\n");
+      emit("}\n");
+      MetaFns.push_back(Name);
+      break;
+    }
+    case 5: {
+      // Instantiate a metaclass or a metaprogram, if there is one.
+      std::string Name = fresh("C");
+      if (!Metaclasses.empty() && (MetaFns.empty() || choose(2)))
+        emit(pick(Metaclasses) + " " + Name + " {\n");
+      else if (!MetaFns.empty())
+        emit("class(" + pick(MetaFns) + ") " + Name + " {\npublic:\n");
+      else
+        emit("struct " + Name + " {\n");
+      members();
+      emit("};\n");
+      Classes.push_back(Name);
+      break;
+    }
+    }
+  }
+
+public:
+  ProgramGenerator(const uint8_t *Data, size_t Size) : Data(Data), Size(Size) {}
+
+  std::string generate(bool IncludeHeaders) {
+    if (IncludeHeaders)
+      Out += Prelude;
+    emit("using namespace cppx;\n");
+    for (unsigned I = 0, N = choose(8) + 1; I != N; ++I)
+      topLevelDecl();
+    emit("int main() {\n");
+    for (const std::string &Class : Classes)
+      if (choose(2))
+        emit("compiler.debug($" + Class + ");\n");
+    emit("}\n");
+    return std::move(Out);
+  }
+};
+
+void printStats() {
+  double Seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - State->Start)
+                       .count();
+  llvm::errs() << "\n*** clang-meta-fuzzer stats:\n";
+  llvm::errs() << State->NumRuns << " runs in " << Seconds << "s ("
+               << (Seconds > 0 ? unsigned(State->NumRuns / Seconds) : 0)
+               << " execs/sec), " << State->NumAccepted
+               << " programs accepted.\n";
+  llvm::errs() << "  " << State->NumReflections << " reflections, "
+               << State->NumReflectionTraits << " reflection traits, "
+               << State->NumFragments << " fragments, "
+               << State->NumInjections << " injections, "
+               << State->NumConstexprDecls << " constexpr blocks, "
+               << State->NumMetaclasses << " metaclasses.\n";
+  if (!State->PCHPath.empty()) {
+    llvm::sys::fs::remove(State->PCHPath);
+    llvm::sys::fs::remove(State->PreludePath);
+  }
+}
+
+/// \brief Compile the cppx headers into a precompiled header that every run
+/// can load instead of parsing them again.
+bool buildPrelude(FuzzerState &S) {
+  SmallString<128> PreludePath, PCHPath;
+  int FD;
+  if (llvm::sys::fs::createTemporaryFile("cppx-prelude", "h", FD, PreludePath))
+    return false;
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    OS << Prelude;
+  }
+  if (llvm::sys::fs::createTemporaryFile("cppx-prelude", "pch", PCHPath)) {
+    llvm::sys::fs::remove(PreludePath);
+    return false;
+  }
+
+  auto Invocation = std::make_shared<CompilerInvocation>(*S.BaseInvocation);
+  FrontendOptions &FEOpts = Invocation->getFrontendOpts();
+  FEOpts.Inputs.clear();
+  FEOpts.Inputs.emplace_back(PreludePath.str(), InputKind(InputKind::CXX));
+  FEOpts.OutputFile = PCHPath.str();
+  FEOpts.ProgramAction = frontend::GeneratePCH;
+
+  CompilerInstance Clang(S.PCHContainerOps);
+  Clang.setInvocation(std::move(Invocation));
+  Clang.createDiagnostics(&S.Diags, /*ShouldOwnClient=*/false);
+  Clang.setFileManager(S.Files.get());
+  GeneratePCHAction Act;
+  if (!Clang.ExecuteAction(Act) || Clang.getDiagnostics().hasErrorOccurred()) {
+    llvm::sys::fs::remove(PreludePath);
+    llvm::sys::fs::remove(PCHPath);
+    return false;
+  }
+
+  S.PreludePath = PreludePath.str();
+  S.PCHPath = PCHPath.str();
+  return true;
+}
+
+} // end anonymous namespace
+
+extern "C" int LLVMFuzzerInitialize(int *argc, char ***argv) {
+  State = new FuzzerState;
+  State->Files = new FileManager(FileSystemOptions());
+  State->PCHContainerOps = std::make_shared<PCHContainerOperations>();
+
+  // Run the driver once to find the resource directory (where the cppx
+  // headers are installed) and the standard library headers they include.
+  std::string ResourceDir = CompilerInvocation::GetResourcesPath(
+      (*argv)[0], (void *)(intptr_t)LLVMFuzzerInitialize);
+  const char *Args[] = {"clang",         "-std=c++1z",
+                        "-Xclang",       "-freflection",
+                        "-resource-dir", ResourceDir.c_str(),
+                        "-x",            "c++",
+                        InputName};
+  IntrusiveRefCntPtr<DiagnosticsEngine> Diags =
+      CompilerInstance::createDiagnostics(new DiagnosticOptions, &State->Diags,
+                                          /*ShouldOwnClient=*/false);
+  std::unique_ptr<CompilerInvocation> Invocation =
+      createInvocationFromCommandLine(Args, Diags);
+  if (!Invocation) {
+    llvm::errs() << "clang-meta-fuzzer: could not create an invocation\n";
+    std::exit(1);
+  }
+  // The driver asks cc1 not to free its AST; that would leak every run.
+  Invocation->getFrontendOpts().DisableFree = false;
+  State->BaseInvocation = std::move(Invocation);
+
+  if (buildPrelude(*State)) {
+    PreprocessorOptions &PPOpts = State->BaseInvocation->getPreprocessorOpts();
+    PPOpts.ImplicitPCHInclude = State->PCHPath;
+    // The headers cannot change under a single fuzzing session.
+    PPOpts.DisablePCHValidation = true;
+  } else {
+    llvm::errs() << "clang-meta-fuzzer: could not precompile <cppx/meta>; "
+                    "including it in every run\n";
+  }
+
+  State->Start = std::chrono::steady_clock::now();
+  std::atexit(printStats);
+  return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(uint8_t *data, size_t size) {
+  std::string Program =
+      ProgramGenerator(data, size).generate(State->PCHPath.empty());
+
+  auto Invocation =
+      std::make_shared<CompilerInvocation>(*State->BaseInvocation);
+  Invocation->getPreprocessorOpts().addRemappedFile(
+      InputName, llvm::MemoryBuffer::getMemBufferCopy(Program).release());
+
+  CompilerInstance Clang(State->PCHContainerOps);
+  Clang.setInvocation(std::move(Invocation));
+  Clang.createDiagnostics(&State->Diags, /*ShouldOwnClient=*/false);
+  Clang.setFileManager(State->Files.get());
+  MetaNodeCounterAction Act;
+  if (Clang.ExecuteAction(Act) && !Clang.getDiagnostics().hasErrorOccurred())
+    ++State->NumAccepted;
+  ++State->NumRuns;
+  return 0;
+}
@@ -30,6 +30,7 @@
 #include "llvm/Option/ArgList.h"
 #include "llvm/Option/OptTable.h"
 #include "llvm/Support/Compiler.h"
+#include "llvm/Support/CrashRecoveryContext.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/Signals.h"
@@ -59,6 +60,13 @@ static void LLVMErrorHandler(void *UserData, const std::string &Message,
   // particular that we remove files registered with RemoveFileOnSignal.
   llvm::sys::RunInterruptHandlers();
 
+  // When the driver runs us in its own process, hand the failure back to it
+  // so that it can still generate the crash diagnostics.
+  if (GenCrashDiag)
+    if (llvm::CrashRecoveryContext *CRC =
+            llvm::CrashRecoveryContext::GetCurrent())
+      CRC->HandleCrash();
+
   // We cannot recover from llvm errors.  When reporting a fatal error, exit
   // with status 70 to generate crash diagnostics.  For BSD systems this is
   // defined as an internal software error.  Otherwise, exit with status 1.
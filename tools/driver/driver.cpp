@@ -447,6 +447,9 @@ int main(int argc_, const char **argv_) {
 
   Driver TheDriver(Path, llvm::sys::getDefaultTargetTriple(), Diags);
   SetInstallDir(argv, TheDriver, CanonicalPrefixes);
+  TheDriver.CC1Main = [](ArrayRef<const char *> ArgV) {
+    return ExecuteCC1Tool(ArgV, ArgV[1] + 4);
+  };
 
   insertTargetAndModeArgs(TargetAndMode.first, TargetAndMode.second, argv,
                           SavedStrings);
@@ -40,6 +40,7 @@
 #include "clang/Serialization/SerializationDiagnostic.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallBitVector.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/Support/Compiler.h"
@@ -4269,6 +4270,108 @@ unsigned clang_visitChildrenWithBlock(CXCursor parent,
   return clang_visitChildren(parent, visitWithBlock, block);
 }
 
+} // end extern "C"
+
+struct CXCursorTreeImpl {
+  std::vector<CXCursorRecord> Records;
+  std::vector<CXCursor> Cursors;
+};
+
+namespace {
+/// \brief Records the cursors visited by clang_getCursorTree().
+struct CursorTreeBuilder {
+  CXCursorTreeImpl &Tree;
+
+  /// \brief Whether only the cursors in \c Kinds are recorded.
+  bool Filtered;
+  llvm::SmallBitVector Kinds;
+
+  /// \brief The cursors on the path from the root to the last visited
+  /// cursor, each with the index of its nearest recorded ancestor-or-self.
+  SmallVector<std::pair<CXCursor, int>, 32> Path;
+
+  explicit CursorTreeBuilder(CXCursorTreeImpl &Tree)
+    : Tree(Tree), Filtered(false) {}
+};
+}
+
+static unsigned getExpansionOffset(CXSourceLocation Loc, CXFile *File) {
+  unsigned Offset = 0;
+  clang_getExpansionLocation(Loc, File, nullptr, nullptr, &Offset);
+  return Offset;
+}
+
+static enum CXChildVisitResult recordCursor(CXCursor cursor, CXCursor parent,
+                                            CXClientData client_data) {
+  CursorTreeBuilder &Builder = *static_cast<CursorTreeBuilder *>(client_data);
+
+  // Traversal is depth-first, so the parent is on the path.
+  while (Builder.Path.size() > 1 &&
+         !clang_equalCursors(Builder.Path.back().first, parent))
+    Builder.Path.pop_back();
+  int Index = Builder.Path.back().second;
+
+  if (!Builder.Filtered ||
+      (unsigned(cursor.kind) < Builder.Kinds.size() &&
+       Builder.Kinds[cursor.kind])) {
+    CXCursorRecord Record;
+    Record.kind = cursor.kind;
+    Record.parent = Index;
+    Record.file = nullptr;
+    Record.offset = getExpansionOffset(clang_getCursorLocation(cursor),
+                                       &Record.file);
+    CXSourceRange Extent = clang_getCursorExtent(cursor);
+    Record.extent_start =
+        getExpansionOffset(clang_getRangeStart(Extent), nullptr);
+    Record.extent_end = getExpansionOffset(clang_getRangeEnd(Extent), nullptr);
+
+    Index = Builder.Tree.Records.size();
+    Builder.Tree.Records.push_back(Record);
+    Builder.Tree.Cursors.push_back(cursor);
+  }
+
+  Builder.Path.push_back(std::make_pair(cursor, Index));
+  return CXChildVisit_Recurse;
+}
+
+extern "C" {
+
+CXCursorTree clang_getCursorTree(CXCursor parent,
+                                 const enum CXCursorKind *kinds,
+                                 unsigned num_kinds) {
+  CXCursorTreeImpl *Tree = new CXCursorTreeImpl();
+  CursorTreeBuilder Builder(*Tree);
+  if (kinds) {
+    Builder.Filtered = true;
+    for (unsigned I = 0; I != num_kinds; ++I) {
+      if (unsigned(kinds[I]) >= Builder.Kinds.size())
+        Builder.Kinds.resize(kinds[I] + 1);
+      Builder.Kinds.set(kinds[I]);
+    }
+  }
+  Builder.Path.push_back(std::make_pair(parent, -1));
+  clang_visitChildren(parent, recordCursor, &Builder);
+  return Tree;
+}
+
+void clang_CursorTree_dispose(CXCursorTree tree) {
+  delete tree;
+}
+
+unsigned clang_CursorTree_getNumRecords(CXCursorTree tree) {
+  return tree ? tree->Records.size() : 0;
+}
+
+const CXCursorRecord *clang_CursorTree_getRecords(CXCursorTree tree) {
+  return tree ? tree->Records.data() : nullptr;
+}
+
+CXCursor clang_CursorTree_getCursor(CXCursorTree tree, unsigned index) {
+  if (!tree || index >= tree->Cursors.size())
+    return clang_getNullCursor();
+  return tree->Cursors[index];
+}
+
 static CXString getDeclSpelling(const Decl *D) {
   if (!D)
     return cxstring::createEmpty();
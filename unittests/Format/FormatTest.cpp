@@ -10241,6 +10241,17 @@ TEST(FormatStyle, GetStyleOfFile) {
   llvm::consumeError(Style7.takeError());
 }
 
+TEST(FormatStyle, GuessLanguage) {
+  EXPECT_EQ(FormatStyle::LK_Cpp, guessLanguage("foo.cc", ""));
+  EXPECT_EQ(FormatStyle::LK_Java, guessLanguage("foo.java", ""));
+  EXPECT_EQ(FormatStyle::LK_ObjC, guessLanguage("foo.mm", ""));
+  EXPECT_EQ(FormatStyle::LK_Cpp, guessLanguage("foo.h", "int i;"));
+  EXPECT_EQ(FormatStyle::LK_ObjC,
+            guessLanguage("foo.h", "@interface Foo\n- (void)f;\n@end"));
+  EXPECT_EQ(FormatStyle::LK_Cpp,
+            guessLanguage("foo.cc", "@interface Foo\n- (void)f;\n@end"));
+}
+
 TEST_F(ReplacementTest, FormatCodeAfterReplacements) {
   // Column limit is 20.
   std::string Code = "Type *a =\n"
@@ -13,8 +13,12 @@
 #include "clang/Tooling/FileMatchTrie.h"
 #include "clang/Tooling/JSONCompilationDatabase.h"
 #include "clang/Tooling/Tooling.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/raw_ostream.h"
 #include "gtest/gtest.h"
+#include <algorithm>
 
 namespace clang {
 namespace tooling {
@@ -195,6 +199,99 @@ TEST(JSONCompilationDatabase, ArgumentsPreferredOverCommand) {
    EXPECT_EQ(Arguments, FoundCommand.CommandLine[0]) << ErrorMessage;
 }
 
+static void writeDatabase(StringRef Path, StringRef Contents) {
+  std::error_code EC;
+  llvm::raw_fd_ostream OS(Path, EC, llvm::sys::fs::F_Text);
+  ASSERT_FALSE(EC);
+  OS << Contents;
+}
+
+TEST(JSONCompilationDatabase, ReadsIndexOfUnchangedDatabase) {
+  SmallString<128> Directory;
+  ASSERT_FALSE(
+      llvm::sys::fs::createUniqueDirectory("json-database", Directory));
+  SmallString<128> DatabasePath(Directory);
+  llvm::sys::path::append(DatabasePath, "compile_commands.json");
+  std::string IndexPath = (DatabasePath + ".idx").str();
+
+  writeDatabase(DatabasePath,
+                "[{\"directory\":\"//net/dir\","
+                "\"arguments\":[\"clang\",\"-DNAME=\\\"a b\\\"\",\"file1\"],"
+                "\"file\":\"file1\"},"
+                " {\"directory\":\"//net/dir\","
+                "\"command\":\"clang file2\","
+                "\"file\":\"//net/dir/file2\"}]");
+  // Loading never writes an index by itself.
+  std::string ErrorMessage;
+  ASSERT_TRUE((bool)JSONCompilationDatabase::loadFromFile(
+      DatabasePath, ErrorMessage, JSONCommandLineSyntax::Gnu))
+      << ErrorMessage;
+  EXPECT_FALSE(llvm::sys::fs::exists(IndexPath));
+
+  ASSERT_TRUE(JSONCompilationDatabase::writeIndex(
+      DatabasePath, ErrorMessage, JSONCommandLineSyntax::Gnu))
+      << ErrorMessage;
+  EXPECT_TRUE(llvm::sys::fs::exists(IndexPath));
+
+  std::unique_ptr<CompilationDatabase> Database =
+      JSONCompilationDatabase::loadFromFile(DatabasePath, ErrorMessage,
+                                            JSONCommandLineSyntax::Gnu);
+  ASSERT_TRUE((bool)Database) << ErrorMessage;
+  EXPECT_EQ(2u, Database->getAllFiles().size());
+  std::vector<CompileCommand> Commands =
+      Database->getCompileCommands("//net/dir/file1");
+  ASSERT_EQ(1u, Commands.size());
+  EXPECT_EQ("//net/dir", Commands[0].Directory);
+  ASSERT_EQ(3u, Commands[0].CommandLine.size());
+  EXPECT_EQ("-DNAME=\"a b\"", Commands[0].CommandLine[1]);
+  Commands = Database->getAllCompileCommands();
+  ASSERT_EQ(2u, Commands.size());
+  EXPECT_EQ("//net/dir/file2", Commands[1].Filename);
+  ASSERT_EQ(2u, Commands[1].CommandLine.size());
+  EXPECT_EQ("file2", Commands[1].CommandLine[1]);
+
+  // Rename file2 without changing the size or modification time of the
+  // database. The file names come from the index, so the old name is still
+  // found, which shows that the database was not scanned again.
+  llvm::sys::fs::file_status Status;
+  ASSERT_FALSE(llvm::sys::fs::status(DatabasePath, Status));
+  writeDatabase(DatabasePath,
+                "[{\"directory\":\"//net/dir\","
+                "\"arguments\":[\"clang\",\"-DNAME=\\\"a b\\\"\",\"file1\"],"
+                "\"file\":\"file1\"},"
+                " {\"directory\":\"//net/dir\","
+                "\"command\":\"clang fileX\","
+                "\"file\":\"//net/dir/fileX\"}]");
+  int FD;
+  ASSERT_FALSE(llvm::sys::fs::openFileForWrite(DatabasePath, FD,
+                                               llvm::sys::fs::F_Append));
+  EXPECT_FALSE(llvm::sys::fs::setLastModificationAndAccessTime(
+      FD, Status.getLastModificationTime()));
+  llvm::sys::Process::SafelyCloseFileDescriptor(FD);
+  Database = JSONCompilationDatabase::loadFromFile(
+      DatabasePath, ErrorMessage, JSONCommandLineSyntax::Gnu);
+  ASSERT_TRUE((bool)Database) << ErrorMessage;
+  std::vector<std::string> Files = Database->getAllFiles();
+  std::sort(Files.begin(), Files.end());
+  ASSERT_EQ(2u, Files.size());
+  EXPECT_EQ("//net/dir/file2", Files[1]);
+
+  // An index written for other contents is ignored.
+  writeDatabase(DatabasePath, "[{\"directory\":\"//net/dir\","
+                              "\"command\":\"clang file3\","
+                              "\"file\":\"file3\"}]");
+  Database = JSONCompilationDatabase::loadFromFile(
+      DatabasePath, ErrorMessage, JSONCommandLineSyntax::Gnu);
+  ASSERT_TRUE((bool)Database) << ErrorMessage;
+  Commands = Database->getAllCompileCommands();
+  ASSERT_EQ(1u, Commands.size());
+  EXPECT_EQ("file3", Commands[0].Filename);
+
+  llvm::sys::fs::remove(IndexPath);
+  llvm::sys::fs::remove(DatabasePath);
+  llvm::sys::fs::remove(Directory);
+}
+
 struct FakeComparator : public PathComparator {
   ~FakeComparator() override {}
   bool equivalent(StringRef FileA, StringRef FileB) const override {
@@ -30,6 +30,7 @@
 #include "clang/Tooling/Tooling.h"
 #include "llvm/ADT/SmallString.h"
 #include "gtest/gtest.h"
+#include <chrono>
 
 namespace clang {
 namespace tooling {
@@ -584,6 +585,164 @@ TEST(ShiftedCodePositionTest, NoReplacementText) {
   EXPECT_EQ(0u, Replaces.getShiftedCodePosition(42));
 }
 
+TEST(SortedReplacementsTest, AppliesReplacementsInOrder) {
+  std::vector<Replacement> Replaces = {Replacement("", 0, 1, "x"),
+                                       Replacement("", 2, 0, "yy"),
+                                       Replacement("", 2, 2, ""),
+                                       Replacement("", 6, 1, "zzz")};
+  auto Result = applySortedReplacements("abcdefg", Replaces);
+  EXPECT_TRUE(static_cast<bool>(Result));
+  EXPECT_EQ("xbyyefzzz", *Result);
+}
+
+TEST(SortedReplacementsTest, MergesOrderIndependentReplacements) {
+  std::vector<Replacement> Replaces = {
+      Replacement("", 0, 0, "a"), Replacement("", 0, 0, "aa"),
+      Replacement("", 1, 2, ""),  Replacement("", 2, 3, ""),
+      Replacement("", 6, 1, "x"), Replacement("", 6, 1, "x")};
+  auto Result = applySortedReplacements("0123456789", Replaces);
+  EXPECT_TRUE(static_cast<bool>(Result));
+  EXPECT_EQ("aaa05x789", *Result);
+}
+
+TEST(SortedReplacementsTest, InsertsRepeatedInsertionsLikeAdd) {
+  std::vector<std::vector<Replacement>> Changes = {
+      {Replacement("", 1, 0, "a"), Replacement("", 1, 0, "a"),
+       Replacement("", 1, 0, "a")},
+      {Replacement("", 1, 0, "a"), Replacement("", 1, 0, "aa"),
+       Replacement("", 1, 0, "aaa")}};
+  for (const std::vector<Replacement> &Change : Changes) {
+    Replacements Replaces;
+    for (const Replacement &R : Change)
+      EXPECT_FALSE(static_cast<bool>(Replaces.add(R)));
+    auto Expected = applyAllReplacements("0123", Replaces);
+    auto Result = applySortedReplacements("0123", Change);
+    EXPECT_TRUE(static_cast<bool>(Expected));
+    EXPECT_TRUE(static_cast<bool>(Result));
+    EXPECT_EQ(*Expected, *Result);
+  }
+  EXPECT_EQ("0aaa123", *applySortedReplacements("0123", Changes.front()));
+}
+
+TEST(SortedReplacementsTest, FailsOnConflicts) {
+  auto Overlap = applySortedReplacements(
+      "0123456789", {Replacement("", 1, 3, "a"), Replacement("", 2, 3, "b")});
+  EXPECT_FALSE(static_cast<bool>(Overlap));
+  llvm::consumeError(Overlap.takeError());
+
+  auto Insert = applySortedReplacements(
+      "0123456789", {Replacement("", 1, 0, "a"), Replacement("", 1, 0, "b")});
+  EXPECT_FALSE(static_cast<bool>(Insert));
+  llvm::consumeError(Insert.takeError());
+
+  auto OutOfRange =
+      applySortedReplacements("0123", {Replacement("", 3, 2, "a")});
+  EXPECT_FALSE(static_cast<bool>(OutOfRange));
+  llvm::consumeError(OutOfRange.takeError());
+}
+
+// Returns a file of NumLines lines and a sorted set of replacements, one every
+// Stride bytes, of the kinds a codemod would produce.
+static std::pair<std::string, std::vector<Replacement>>
+makeSyntheticChange(unsigned NumLines, unsigned Stride) {
+  std::string Code;
+  for (unsigned I = 0; I != NumLines; ++I)
+    Code += "  int variable_" + std::to_string(I) + " = compute(" +
+            std::to_string(I) + ");\n";
+  std::vector<Replacement> Replaces;
+  for (unsigned Offset = 0, I = 0; Offset + 4 < Code.size();
+       Offset += Stride, ++I) {
+    switch (I % 3) {
+    case 0:
+      Replaces.emplace_back("", Offset, 0, "/*x*/");
+      break;
+    case 1:
+      Replaces.emplace_back("", Offset, 3, "");
+      break;
+    case 2:
+      Replaces.emplace_back("", Offset, 4, "renamed");
+      break;
+    }
+  }
+  return {Code, Replaces};
+}
+
+TEST(SortedReplacementsTest, MatchesReplacementsOnSyntheticChange) {
+  auto Change = makeSyntheticChange(200, 7);
+  Replacements Replaces;
+  for (const Replacement &R : Change.second)
+    EXPECT_FALSE(static_cast<bool>(Replaces.add(R)));
+  auto Expected = applyAllReplacements(Change.first, Replaces);
+  auto Result = applySortedReplacements(Change.first, Change.second);
+  EXPECT_TRUE(static_cast<bool>(Expected));
+  EXPECT_TRUE(static_cast<bool>(Result));
+  EXPECT_EQ(*Expected, *Result);
+}
+
+TEST(BulkReplacementsTest, RewritesEveryFile) {
+  vfs::InMemoryFileSystem FS;
+  std::map<std::string, std::vector<Replacement>> FileToReplaces;
+  for (unsigned I = 0; I != 50; ++I) {
+    std::string Path = "/file" + std::to_string(I) + ".cpp";
+    FS.addFile(Path, 0,
+               llvm::MemoryBuffer::getMemBufferCopy("int x" +
+                                                    std::to_string(I) + ";"));
+    FileToReplaces[Path] = {Replacement(Path, 0, 3, "long"),
+                            Replacement(Path, 4, 1, "y")};
+  }
+  auto Result = applyAllReplacementsInBulk(FileToReplaces, FS, 4);
+  EXPECT_TRUE(static_cast<bool>(Result));
+  EXPECT_EQ(50u, Result->size());
+  EXPECT_EQ("long y7;", (*Result)["/file7.cpp"]);
+}
+
+TEST(BulkReplacementsTest, ReportsFirstFailingFile) {
+  vfs::InMemoryFileSystem FS;
+  FS.addFile("/a.cpp", 0, llvm::MemoryBuffer::getMemBuffer("int a;"));
+  std::map<std::string, std::vector<Replacement>> FileToReplaces;
+  FileToReplaces["/a.cpp"] = {Replacement("/a.cpp", 0, 10, "")};
+  FileToReplaces["/missing.cpp"] = {Replacement("/missing.cpp", 0, 0, "")};
+  auto Result = applyAllReplacementsInBulk(FileToReplaces, FS);
+  EXPECT_FALSE(static_cast<bool>(Result));
+  EXPECT_NE(std::string::npos,
+            llvm::toString(Result.takeError()).find("/a.cpp"));
+}
+
+// A benchmark rather than a test; run it with --gtest_also_run_disabled_tests.
+TEST(BulkReplacementsTest, DISABLED_BenchmarkSyntheticChangeSet) {
+  const unsigned NumFiles = 2000;
+  vfs::InMemoryFileSystem FS;
+  std::map<std::string, std::vector<Replacement>> FileToReplaces;
+  size_t NumReplacements = 0;
+  for (unsigned I = 0; I != NumFiles; ++I) {
+    std::string Path = "/src/file" + std::to_string(I) + ".cpp";
+    auto Change = makeSyntheticChange(1000, 11);
+    FS.addFile(Path, 0, llvm::MemoryBuffer::getMemBufferCopy(Change.first));
+    NumReplacements += Change.second.size();
+    FileToReplaces[Path] = std::move(Change.second);
+  }
+
+  auto Start = std::chrono::steady_clock::now();
+  for (const auto &Entry : FileToReplaces) {
+    Replacements Replaces;
+    for (const Replacement &R : Entry.second)
+      llvm::consumeError(Replaces.add(R));
+    auto Buffer = FS.getBufferForFile(Entry.first);
+    auto Result = applyAllReplacements((*Buffer)->getBuffer(), Replaces);
+    EXPECT_TRUE(static_cast<bool>(Result));
+  }
+  auto Middle = std::chrono::steady_clock::now();
+  auto Result = applyAllReplacementsInBulk(FileToReplaces, FS);
+  auto End = std::chrono::steady_clock::now();
+  EXPECT_TRUE(static_cast<bool>(Result));
+
+  typedef std::chrono::duration<double, std::milli> Millis;
+  llvm::outs() << NumReplacements << " replacements in " << NumFiles
+               << " files: " << Millis(Middle - Start).count()
+               << "ms through Replacements and Rewriter, "
+               << Millis(End - Middle).count() << "ms in bulk\n";
+}
+
 class FlushRewrittenFilesTest : public ::testing::Test {
 public:
    FlushRewrittenFilesTest() {}